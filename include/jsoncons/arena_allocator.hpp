@@ -0,0 +1,365 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ARENA_ALLOCATOR_HPP
+#define JSONCONS_ARENA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory> // std::unique_ptr
+#include <new> // ::operator new
+#include <type_traits>
+#include <utility> // std::move
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_parser.hpp>
+
+namespace jsoncons {
+
+    // monotonic_arena: hands out memory by bumping a pointer through a list
+    // of chunks, each twice the size of the one before. Memory is only
+    // returned when the arena is released or destroyed.
+
+    class monotonic_arena
+    {
+        struct chunk
+        {
+            chunk* next;
+            std::size_t size;
+        };
+
+        static constexpr std::size_t max_alignment = alignof(std::max_align_t);
+        static constexpr std::size_t header_size = (sizeof(chunk) + max_alignment - 1) & ~(max_alignment - 1);
+
+        chunk* head_;
+        char* current_;
+        char* end_;
+        std::size_t initial_chunk_size_;
+        std::size_t next_chunk_size_;
+        std::size_t bytes_allocated_;
+
+        // Noncopyable and nonmoveable
+        monotonic_arena(const monotonic_arena&) = delete;
+        monotonic_arena& operator=(const monotonic_arena&) = delete;
+    public:
+        explicit monotonic_arena(std::size_t initial_chunk_size = 4096)
+            : head_(nullptr), current_(nullptr), end_(nullptr),
+              initial_chunk_size_(initial_chunk_size > header_size ? initial_chunk_size : 2*header_size),
+              next_chunk_size_(initial_chunk_size_),
+              bytes_allocated_(0)
+        {
+        }
+
+        ~monotonic_arena() noexcept
+        {
+            release();
+        }
+
+        void* allocate(std::size_t n, std::size_t alignment = max_alignment)
+        {
+            std::size_t space = static_cast<std::size_t>(end_ - current_);
+            std::size_t padding = static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(current_)) & (alignment - 1);
+            if (current_ == nullptr || padding + n > space)
+            {
+                add_chunk(n + alignment);
+                padding = static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(current_)) & (alignment - 1);
+            }
+            char* p = current_ + padding;
+            current_ = p + n;
+            bytes_allocated_ += n;
+            return p;
+        }
+
+        // Frees all chunks at once, invalidating everything allocated from the arena
+        void release() noexcept
+        {
+            while (head_ != nullptr)
+            {
+                chunk* next = head_->next;
+                ::operator delete(head_);
+                head_ = next;
+            }
+            current_ = nullptr;
+            end_ = nullptr;
+            next_chunk_size_ = initial_chunk_size_;
+            bytes_allocated_ = 0;
+        }
+
+        std::size_t bytes_allocated() const
+        {
+            return bytes_allocated_;
+        }
+
+        std::size_t capacity() const
+        {
+            std::size_t n = 0;
+            for (const chunk* p = head_; p != nullptr; p = p->next)
+            {
+                n += p->size;
+            }
+            return n;
+        }
+    private:
+        void add_chunk(std::size_t min_size)
+        {
+            std::size_t size = next_chunk_size_;
+            while (size - header_size < min_size)
+            {
+                size *= 2;
+            }
+            chunk* p = static_cast<chunk*>(::operator new(size));
+            p->next = head_;
+            p->size = size;
+            head_ = p;
+            current_ = reinterpret_cast<char*>(p) + header_size;
+            end_ = reinterpret_cast<char*>(p) + size;
+            next_chunk_size_ = 2*size;
+        }
+    };
+
+    // arena_allocator: allocates from a monotonic_arena and never frees.
+    // A default constructed arena_allocator is not bound to an arena and
+    // allocates from the heap, so a copy of a value made with it, e.g.
+    // basic_json(val, arena_allocator<char>()), is independent of the arena.
+    // Copy construction selects such an allocator, so a plain copy is
+    // independent of the arena too. Like std::pmr::polymorphic_allocator,
+    // it does not propagate on container assignment or swap.
+
+    template <class T>
+    class arena_allocator
+    {
+        template <class U> friend class arena_allocator;
+
+        monotonic_arena* arena_;
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::false_type;
+        using propagate_on_container_swap = std::false_type;
+        using is_always_equal = std::false_type;
+
+        template <class U>
+        struct rebind
+        {
+            using other = arena_allocator<U>;
+        };
+
+        arena_allocator() noexcept
+            : arena_(nullptr)
+        {
+        }
+
+        arena_allocator(monotonic_arena& arena) noexcept
+            : arena_(std::addressof(arena))
+        {
+        }
+
+        arena_allocator(const arena_allocator&) noexcept = default;
+
+        template <class U>
+        arena_allocator(const arena_allocator<U>& other) noexcept
+            : arena_(other.arena_)
+        {
+        }
+
+        arena_allocator& operator=(const arena_allocator&) noexcept = default;
+
+        // A copy may outlive the arena, so it is allocated from the heap
+        arena_allocator select_on_container_copy_construction() const noexcept
+        {
+            return arena_allocator();
+        }
+
+        monotonic_arena* arena() const noexcept
+        {
+            return arena_;
+        }
+
+        T* allocate(std::size_t n)
+        {
+            if (arena_ != nullptr)
+            {
+                // Aligned as by operator new, basic_json places headers in char allocations
+                return static_cast<T*>(arena_->allocate(n*sizeof(T), alignof(T) > alignof(std::max_align_t) ? alignof(T) : alignof(std::max_align_t)));
+            }
+            return static_cast<T*>(::operator new(n*sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept
+        {
+            if (arena_ == nullptr)
+            {
+                ::operator delete(p);
+            }
+        }
+
+        friend bool operator==(const arena_allocator& lhs, const arena_allocator& rhs) noexcept
+        {
+            return lhs.arena_ == rhs.arena_;
+        }
+
+        friend bool operator!=(const arena_allocator& lhs, const arena_allocator& rhs) noexcept
+        {
+            return lhs.arena_ != rhs.arena_;
+        }
+    };
+
+    using arena_json = basic_json<char,sorted_policy,arena_allocator<char>>;
+    using arena_ojson = basic_json<char,preserve_order_policy,arena_allocator<char>>;
+
+    // basic_arena_document: a root value and the arena that holds it. If the
+    // root has only been read through the const root(), the destructor
+    // releases the arena without walking the tree. Once the non-const root()
+    // has handed out a reference, values allocated elsewhere may have been
+    // placed in the tree, so the root is destroyed before the arena is
+    // released. Destroying values that live in the arena frees nothing.
+
+    template <class Json>
+    class basic_arena_document
+    {
+    public:
+        using value_type = Json;
+        using char_type = typename Json::char_type;
+        using allocator_type = typename Json::allocator_type;
+
+        static_assert(std::is_same<allocator_type,arena_allocator<typename allocator_type::value_type>>::value,
+                      "basic_arena_document requires a basic_json with an arena_allocator");
+    private:
+        std::unique_ptr<monotonic_arena> arena_;
+        union
+        {
+            Json root_;
+        };
+        bool root_modifiable_;
+
+        basic_arena_document(const basic_arena_document&) = delete;
+        basic_arena_document& operator=(const basic_arena_document&) = delete;
+    public:
+        explicit basic_arena_document(std::size_t initial_chunk_size = 4096)
+            : arena_(new monotonic_arena(initial_chunk_size)), root_modifiable_(false)
+        {
+            ::new(static_cast<void*>(std::addressof(root_))) Json();
+        }
+
+        basic_arena_document(basic_arena_document&& other) noexcept
+            : arena_(std::move(other.arena_)), root_modifiable_(other.root_modifiable_)
+        {
+            ::new(static_cast<void*>(std::addressof(root_))) Json(std::move(other.root_));
+            other.root_modifiable_ = false;
+        }
+
+        ~basic_arena_document() noexcept
+        {
+            destroy_root();
+        }
+
+        basic_arena_document& operator=(basic_arena_document&& other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy_root();
+                arena_ = std::move(other.arena_);
+                ::new(static_cast<void*>(std::addressof(root_))) Json(std::move(other.root_));
+                root_modifiable_ = other.root_modifiable_;
+                other.root_modifiable_ = false;
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type(*arena_);
+        }
+
+        monotonic_arena& arena()
+        {
+            return *arena_;
+        }
+
+        const monotonic_arena& arena() const
+        {
+            return *arena_;
+        }
+
+        Json& root()
+        {
+            root_modifiable_ = true;
+            return root_;
+        }
+
+        const Json& root() const
+        {
+            return root_;
+        }
+
+        // Discards the root value and all memory allocated for it
+        void clear()
+        {
+            destroy_root();
+            ::new(static_cast<void*>(std::addressof(root_))) Json();
+            arena_->release();
+        }
+
+        template <class Source>
+        static
+        typename std::enable_if<jsoncons::detail::is_sequence_of<Source,char_type>::value,basic_arena_document>::type
+        parse(const Source& s,
+              const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+              std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
+        {
+            basic_arena_document doc(s.size() > 2048 ? 2*s.size() : 4096);
+            {
+                json_decoder<Json> decoder(result_allocator_arg, doc.get_allocator());
+                basic_json_parser<char_type> parser(options,err_handler);
+
+                auto result = unicons::skip_bom(s.begin(), s.end());
+                if (result.ec != unicons::encoding_errc())
+                {
+                    JSONCONS_THROW(ser_error(result.ec));
+                }
+                std::size_t offset = result.it - s.begin();
+                parser.update(s.data()+offset,s.size()-offset);
+                parser.parse_some(decoder);
+                parser.finish_parse(decoder);
+                parser.check_done();
+                if (!decoder.is_valid())
+                {
+                    JSONCONS_THROW(json_runtime_error<std::runtime_error>("Failed to parse json string"));
+                }
+                ::new(static_cast<void*>(std::addressof(doc.root_))) Json(decoder.get_result());
+            }
+            return doc;
+        }
+
+        static basic_arena_document parse(const char_type* s,
+                                          const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+                                          std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
+        {
+            return parse(jsoncons::basic_string_view<char_type>(s), options, err_handler);
+        }
+    private:
+        // Frees any values in the tree that were not allocated from the arena.
+        // A root that was never handed out by the non-const root() holds 
+        // only arena memory, and is left for the arena to release.
+        void destroy_root() noexcept
+        {
+            if (root_modifiable_)
+            {
+                root_.~Json();
+                root_modifiable_ = false;
+            }
+        }
+    };
+
+    using arena_json_document = basic_arena_document<arena_json>;
+    using arena_ojson_document = basic_arena_document<arena_ojson>;
+
+} // namespace jsoncons
+
+#endif
@@ -8,6 +8,7 @@
 #define JSONCONS_BASIC_JSON_HPP
 
 #include <limits> // std::numeric_limits
+#include <functional> // std::hash
 #include <string>
 #include <vector>
 #include <exception>
@@ -37,6 +38,10 @@
 #include <jsoncons/byte_string.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/string_wrapper.hpp>
+#include <jsoncons/detail/small_vector.hpp>
+#include <jsoncons/detail/hash.hpp>
+#include <jsoncons/detail/shared_node.hpp>
+#include <jsoncons/interned_key.hpp>
 
 namespace jsoncons { 
 
@@ -242,6 +247,8 @@ struct sorted_policy
     using key_storage = std::basic_string<CharT, CharTraits,Allocator>;
 
     using parse_error_handler_type = default_json_parsing;
+
+    static constexpr bool copy_on_write = false;
 };
 
 struct preserve_order_policy : public sorted_policy
@@ -249,6 +256,48 @@ struct preserve_order_policy : public sorted_policy
     using key_order = preserve_key_order;
 };
 
+// Keep small arrays and objects inside their json_array or json_object,
+// in a single allocation, growing onto the heap when they get larger
+
+struct compact_sorted_policy : public sorted_policy
+{
+    template <class T,class Allocator>
+    using sequence_container_type = jsoncons::detail::small_vector<T,Allocator>;
+};
+
+struct compact_preserve_order_policy : public compact_sorted_policy
+{
+    using key_order = preserve_key_order;
+};
+
+// Share object keys: copies of a key share one allocation, and a json_decoder
+// interns the keys it reads, so that equal keys in a document are stored once
+
+struct interned_key_sorted_policy : public sorted_policy
+{
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = basic_interned_key<CharT,CharTraits,Allocator>;
+};
+
+struct interned_key_preserve_order_policy : public interned_key_sorted_policy
+{
+    using key_order = preserve_key_order;
+};
+
+// Share arrays, objects and long strings between copies, copying an array 
+// or object only when a copy that shares it is accessed through a non-const
+// member function
+
+struct cow_sorted_policy : public sorted_policy
+{
+    static constexpr bool copy_on_write = true;
+};
+
+struct cow_preserve_order_policy : public cow_sorted_policy
+{
+    using key_order = preserve_key_order;
+};
+
 template <class IteratorT, class ConstIteratorT>
 class range 
 {
@@ -331,7 +380,7 @@ public:
 
     using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<char_type>;
 
-    using key_type = std::basic_string<char_type,char_traits_type,char_allocator_type>;
+    using key_type = typename implementation_policy::template key_storage<char_type,char_traits_type,char_allocator_type>;
 
 
     using reference = basic_json&;
@@ -560,7 +609,11 @@ private:
         uint8_t length_:4;
         semantic_tag tag_;
     private:
-        jsoncons::detail::string_wrapper<char_type,Allocator> s_;
+        using string_wrapper_type = typename std::conditional<implementation_policy::copy_on_write,
+            jsoncons::detail::shared_string_wrapper<char_type,Allocator>,
+            jsoncons::detail::string_wrapper<char_type,Allocator>>::type;
+
+        string_wrapper_type s_;
     public:
 
         long_string_storage(semantic_tag tag, const char_type* data, std::size_t length, const Allocator& a)
@@ -696,7 +749,10 @@ private:
         uint8_t length_:4;
         semantic_tag tag_;
     private:
-        using array_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<array>;
+        using node_type = typename std::conditional<implementation_policy::copy_on_write,
+            jsoncons::detail::shared_node<array>,array>::type;
+        using node_traits = jsoncons::detail::node_traits<node_type>;
+        using array_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type>;
         using pointer = typename std::allocator_traits<array_allocator>::pointer;
 
         pointer ptr_;
@@ -718,9 +774,12 @@ private:
 
         void destroy() noexcept
         {
-            array_allocator alloc(ptr_->get_allocator());
-            std::allocator_traits<array_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-            std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
+            if (node_traits::release(*ptr_))
+            {
+                array_allocator alloc(ptr_->get_allocator());
+                std::allocator_traits<array_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
+                std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
+            }
         }
     public:
         array_storage(const array& val, semantic_tag tag)
@@ -738,7 +797,14 @@ private:
         array_storage(const array_storage& val)
             : storage_(val.storage_), length_(0), tag_(val.tag_)
         {
-            create(val.ptr_->get_allocator(), *(val.ptr_));
+            if (node_traits::share(*val.ptr_))
+            {
+                ptr_ = val.ptr_;
+            }
+            else
+            {
+                create(val.ptr_->get_allocator(), node_traits::value(*val.ptr_));
+            }
         }
 
         array_storage(array_storage&& val) noexcept
@@ -751,7 +817,14 @@ private:
         array_storage(const array_storage& val, const Allocator& a)
             : storage_(val.storage_), length_(0), tag_(val.tag_)
         {
-            create(array_allocator(a), *(val.ptr_), a);
+            if (val.get_allocator() == a && node_traits::share(*val.ptr_))
+            {
+                ptr_ = val.ptr_;
+            }
+            else
+            {
+                create(array_allocator(a), node_traits::value(*val.ptr_), a);
+            }
         }
         ~array_storage() noexcept
         {
@@ -771,14 +844,57 @@ private:
             std::swap(val.ptr_,ptr_);
         }
 
+        // A reference that may escape, later copies can no longer share this array
         array& value()
         {
-            return *ptr_;
+            if (node_traits::is_shared(*ptr_))
+            {
+                unshare();
+            }
+            node_traits::set_unshareable(*ptr_);
+            return node_traits::value(*ptr_);
+        }
+
+        // For modifications that do not hand out references or iterators
+        array& modifiable_value()
+        {
+            if (node_traits::is_shared(*ptr_))
+            {
+                unshare();
+            }
+            return node_traits::value(*ptr_);
         }
 
         const array& value() const
         {
-            return *ptr_;
+            return node_traits::value(*ptr_);
+        }
+
+        // True if another value still holds a reference to this array
+        bool is_shared() const noexcept
+        {
+            return node_traits::is_shared(*ptr_);
+        }
+    private:
+        // Replaces a shared node with a copy of its own
+        void unshare()
+        {
+            pointer p = ptr_;
+            JSONCONS_TRY
+            {
+                create(p->get_allocator(), node_traits::value(*p));
+            }
+            JSONCONS_CATCH(...)
+            {
+                ptr_ = p;
+                JSONCONS_RETHROW;
+            }
+            if (node_traits::release(*p))
+            {
+                array_allocator alloc(p->get_allocator());
+                std::allocator_traits<array_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(p));
+                std::allocator_traits<array_allocator>::deallocate(alloc, p,1);
+            }
         }
     };
 
@@ -790,7 +906,10 @@ private:
         uint8_t length_:4;
         semantic_tag tag_;
     private:
-        using object_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<object>;
+        using node_type = typename std::conditional<implementation_policy::copy_on_write,
+            jsoncons::detail::shared_node<object>,object>::type;
+        using node_traits = jsoncons::detail::node_traits<node_type>;
+        using object_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<node_type>;
         using pointer = typename std::allocator_traits<object_allocator>::pointer;
 
         pointer ptr_;
@@ -825,7 +944,14 @@ private:
         explicit object_storage(const object_storage& val)
             : storage_(val.storage_), length_(0), tag_(val.tag_)
         {
-            create(val.ptr_->get_allocator(), *(val.ptr_));
+            if (node_traits::share(*val.ptr_))
+            {
+                ptr_ = val.ptr_;
+            }
+            else
+            {
+                create(val.ptr_->get_allocator(), node_traits::value(*val.ptr_));
+            }
         }
 
         explicit object_storage(object_storage&& val) noexcept
@@ -838,7 +964,14 @@ private:
         explicit object_storage(const object_storage& val, const Allocator& a)
             : storage_(val.storage_), length_(0), tag_(val.tag_)
         {
-            create(object_allocator(a), *(val.ptr_), a);
+            if (val.get_allocator() == a && node_traits::share(*val.ptr_))
+            {
+                ptr_ = val.ptr_;
+            }
+            else
+            {
+                create(object_allocator(a), node_traits::value(*val.ptr_), a);
+            }
         }
 
         ~object_storage() noexcept
@@ -854,15 +987,59 @@ private:
             std::swap(val.ptr_,ptr_);
         }
 
+        // A reference that may escape, later copies can no longer share this object
         object& value()
         {
-            return *ptr_;
+            if (node_traits::is_shared(*ptr_))
+            {
+                unshare();
+            }
+            node_traits::set_unshareable(*ptr_);
+            return node_traits::value(*ptr_);
+        }
+
+        // For modifications that do not hand out references or iterators
+        object& modifiable_value()
+        {
+            if (node_traits::is_shared(*ptr_))
+            {
+                unshare();
+            }
+            return node_traits::value(*ptr_);
         }
 
         const object& value() const
         {
-            return *ptr_;
+            return node_traits::value(*ptr_);
+        }
+
+        // True if another value still holds a reference to this object
+        bool is_shared() const noexcept
+        {
+            return node_traits::is_shared(*ptr_);
+        }
+    private:
+        // Replaces a shared node with a copy of its own
+        void unshare()
+        {
+            pointer p = ptr_;
+            JSONCONS_TRY
+            {
+                create(p->get_allocator(), node_traits::value(*p));
+            }
+            JSONCONS_CATCH(...)
+            {
+                ptr_ = p;
+                JSONCONS_RETHROW;
+            }
+            if (node_traits::release(*p))
+            {
+                object_allocator alloc(p->get_allocator());
+                std::allocator_traits<object_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(p));
+                std::allocator_traits<object_allocator>::deallocate(alloc, p,1);
+            }
         }
+    public:
 
         allocator_type get_allocator() const
         {
@@ -872,9 +1049,12 @@ private:
 
         void destroy() noexcept
         {
-            object_allocator alloc(ptr_->get_allocator());
-            std::allocator_traits<object_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-            std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
+            if (node_traits::release(*ptr_))
+            {
+                object_allocator alloc(ptr_->get_allocator());
+                std::allocator_traits<object_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
+                std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
+            }
         }
     };
 
@@ -2484,6 +2664,66 @@ public:
         }
     }
 
+    // A structural hash, consistent with operator==: values that compare
+    // equal have equal hashes. Numbers hash by their value as a double, so an
+    // int64 and an equal double agree, tags are ignored, and object members
+    // are combined without regard to order, so json and ojson agree.
+    std::size_t hash_code() const noexcept
+    {
+        switch (storage())
+        {
+            case storage_kind::null_value:
+                return static_cast<std::size_t>(0x9E3779B97F4A7C15ull);
+            case storage_kind::bool_value:
+                return cast<bool_storage>().value() ? static_cast<std::size_t>(0xA0761D6478BD642Full) : static_cast<std::size_t>(0xE7037ED1A0B428DBull);
+            case storage_kind::int64_value:
+                return hash_number(static_cast<double>(cast<int64_storage>().value()));
+            case storage_kind::uint64_value:
+                return hash_number(static_cast<double>(cast<uint64_storage>().value()));
+            case storage_kind::half_value:
+                return hash_number(jsoncons::detail::decode_half(cast<half_storage>().value()));
+            case storage_kind::double_value:
+                return hash_number(cast<double_storage>().value());
+            case storage_kind::short_string_value:
+            case storage_kind::long_string_value:
+            {
+                auto sv = as_string_view();
+                return jsoncons::detail::hash_string(sv.data(), sv.length(), 0x1);
+            }
+            case storage_kind::byte_string_value:
+            {
+                auto bs = as_byte_string_view();
+                return jsoncons::detail::hash_bytes(bs.data(), bs.size(), 0x2);
+            }
+            case storage_kind::array_value:
+            {
+                uint64_t h = 0x3;
+                for (const auto& item : array_range())
+                {
+                    h = jsoncons::detail::hash_mix(h ^ item.hash_code(), 0x8EBC6AF09C88C6E3ull);
+                }
+                return static_cast<std::size_t>(h);
+            }
+            case storage_kind::empty_object_value:
+            case storage_kind::object_value:
+            {
+                uint64_t h = 0;
+                for (const auto& member : object_range())
+                {
+                    string_view_type key(member.key().data(), member.key().length());
+                    h += jsoncons::detail::hash_mix(jsoncons::detail::hash_string(key.data(), key.length(), 0x4) ^ member.value().hash_code(),
+                                                    0x589965CC75374CC3ull);
+                }
+                return static_cast<std::size_t>(jsoncons::detail::hash_mix(h ^ 0x4, 0x1D8E4E27C47D124Full));
+            }
+            case storage_kind::json_const_pointer:
+                return cast<json_const_pointer_storage>().value()->hash_code();
+            default:
+                JSONCONS_UNREACHABLE();
+                break;
+        }
+    }
+
     friend bool operator==(const basic_json& lhs, const basic_json& rhs) noexcept
     {
         if (&lhs ==&rhs)
@@ -3030,7 +3270,17 @@ public:
 
     basic_json(const basic_json& other)
     {
-        Init_(other);
+        // The allocator chooses the allocator of a copy, arena_allocator
+        // for example copies to the heap so the copy can outlive its arena
+        allocator_type alloc = std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator());
+        if (alloc == other.get_allocator())
+        {
+            Init_(other);
+        }
+        else
+        {
+            Init_(other, alloc);
+        }
     }
 
     basic_json(const basic_json& other, const Allocator& alloc)
@@ -3930,17 +4180,17 @@ public:
             switch (storage())
             {
                 case storage_kind::array_value:
-                    array_value().reserve(n);
+                    modifiable_array_value().reserve(n);
                     break;
                 case storage_kind::empty_object_value:
                 {
                     create_object_implicitly();
-                    object_value().reserve(n);
+                    modifiable_object_value().reserve(n);
                 }
                 break;
                 case storage_kind::object_value:
                 {
-                    object_value().reserve(n);
+                    modifiable_object_value().reserve(n);
                 }
                     break;
                 default:
@@ -3954,7 +4204,7 @@ public:
         switch (storage())
         {
             case storage_kind::array_value:
-                array_value().resize(n);
+                modifiable_array_value().resize(n);
                 break;
             default:
                 break;
@@ -3967,7 +4217,7 @@ public:
         switch (storage())
         {
             case storage_kind::array_value:
-                array_value().resize(n, val);
+                modifiable_array_value().resize(n, val);
                 break;
             default:
                 break;
@@ -4436,10 +4686,10 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().shrink_to_fit();
+            modifiable_array_value().shrink_to_fit();
             break;
         case storage_kind::object_value:
-            object_value().shrink_to_fit();
+            modifiable_object_value().shrink_to_fit();
             break;
         default:
             break;
@@ -4451,10 +4701,10 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().clear();
+            modifiable_array_value().clear();
             break;
         case storage_kind::object_value:
-            object_value().clear();
+            modifiable_object_value().clear();
             break;
         default:
             break;
@@ -4526,7 +4776,7 @@ public:
         case storage_kind::empty_object_value:
             break;
         case storage_kind::object_value:
-            object_value().erase(name);
+            modifiable_object_value().erase(name);
             break;
         default:
             JSONCONS_THROW(not_an_object(name.data(),name.length()));
@@ -4785,7 +5035,7 @@ public:
         {
         case storage_kind::empty_object_value:
         case storage_kind::object_value:
-            object_value().insert(first, last, get_key_value<key_type,basic_json>());
+            modifiable_object_value().insert(first, last, get_key_value<key_type,basic_json>());
             break;
         default:
             {
@@ -4801,7 +5051,7 @@ public:
         {
         case storage_kind::empty_object_value:
         case storage_kind::object_value:
-            object_value().insert(tag, first, last, get_key_value<key_type,basic_json>());
+            modifiable_object_value().insert(tag, first, last, get_key_value<key_type,basic_json>());
             break;
         default:
             {
@@ -4850,7 +5100,7 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().push_back(std::forward<T>(val));
+            modifiable_array_value().push_back(std::forward<T>(val));
             break;
         default:
             {
@@ -5566,6 +5816,37 @@ public:
         }
     }
 
+    // Like array_value() and object_value(), for modifications that do not
+    // hand out references or iterators, with copy on write storage these 
+    // leave the array or object shareable
+
+    array& modifiable_array_value() 
+    {
+        switch (storage())
+        {
+        case storage_kind::array_value:
+            return cast<array_storage>().modifiable_value();
+        default:
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Bad array cast"));
+            break;
+        }
+    }
+
+    object& modifiable_object_value()
+    {
+        switch (storage())
+        {
+            case storage_kind::empty_object_value:
+                create_object_implicitly();
+                JSONCONS_FALLTHROUGH;
+            case storage_kind::object_value:
+                return cast<object_storage>().modifiable_value();
+            default:
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Bad object cast"));
+                break;
+        }
+    }
+
     const object& object_value() const
     {
         switch (storage())
@@ -5585,6 +5866,24 @@ public:
 
 private:
 
+    friend class json_array<basic_json>;
+
+    // True if this is an array or object whose storage is still referenced by 
+    // another value. Used when destroying nested containers, which must not
+    // unshare (and so copy) storage they are about to release.
+    bool is_shared_container() const noexcept
+    {
+        switch (storage())
+        {
+            case storage_kind::array_value:
+                return cast<array_storage>().is_shared();
+            case storage_kind::object_value:
+                return cast<object_storage>().is_shared();
+            default:
+                return false;
+        }
+    }
+
     void dump_noflush(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
     {
         const ser_context context{};
@@ -5683,6 +5982,19 @@ private:
         return is;
     }
 
+private:
+    static std::size_t hash_number(double d) noexcept
+    {
+        if (d == 0)
+        {
+            d = 0; // -0.0 == 0.0
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        return static_cast<std::size_t>(jsoncons::detail::hash_mix(bits, 0x9FB21C651E98DF25ull));
+    }
+public:
+
     friend basic_json deep_copy(const basic_json& other)
     {
         switch (other.storage())
@@ -5727,6 +6039,12 @@ using json = basic_json<char,sorted_policy,std::allocator<char>>;
 using wjson = basic_json<wchar_t,sorted_policy,std::allocator<char>>;
 using ojson = basic_json<char, preserve_order_policy, std::allocator<char>>;
 using wojson = basic_json<wchar_t, preserve_order_policy, std::allocator<char>>;
+using compact_json = basic_json<char,compact_sorted_policy,std::allocator<char>>;
+using compact_ojson = basic_json<char,compact_preserve_order_policy,std::allocator<char>>;
+using interned_json = basic_json<char,interned_key_sorted_policy,std::allocator<char>>;
+using interned_ojson = basic_json<char,interned_key_preserve_order_policy,std::allocator<char>>;
+using cow_json = basic_json<char,cow_sorted_policy,std::allocator<char>>;
+using cow_ojson = basic_json<char,cow_preserve_order_policy,std::allocator<char>>;
 
 #if !defined(JSONCONS_NO_DEPRECATED)
 JSONCONS_DEPRECATED_MSG("Instead, use wojson") typedef basic_json<wchar_t, preserve_order_policy, std::allocator<wchar_t>> owjson;
@@ -5767,4 +6085,15 @@ jsoncons::wojson operator "" _ojson(const wchar_t* s, std::size_t n)
 
 } // namespace jsoncons
 
+namespace std {
+    template <class CharT,class ImplementationPolicy,class Allocator>
+    struct hash<jsoncons::basic_json<CharT,ImplementationPolicy,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_json<CharT,ImplementationPolicy,Allocator>& val) const noexcept
+        {
+            return val.hash_code();
+        }
+    };
+}
+
 #endif
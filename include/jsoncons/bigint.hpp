@@ -21,6 +21,7 @@
 #include <initializer_list> // std::initializer_list
 #include <type_traits> // std::enable_if
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/integer_digits.hpp>
 
 namespace jsoncons {
 
@@ -396,18 +397,37 @@ public:
             neg = false;
         }
 
+        // Up to 19 digits at a time are accumulated in a uint64_t, then
+        // folded into v with one multiply and add
         basic_bigint<Allocator> v = 0;
-        for (size_type i = 0; i < length; i++)
-        {
-            CharT c = data[i];
-            switch (c)
+        const CharT* s = data;
+        const CharT* end = data + length;
+        while (s < end)
+        {
+            const CharT* last = (end - s) > 19 ? s + 19 : end;
+            uint64_t n = 0;
+            uint64_t p = 1;
+            const CharT* first = s;
+            s = jsoncons::detail::accumulate_eight_digits(n, s, last);
+            for (; first < s; ++first)
             {
-                case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                    v = (v * 10) + (uint64_t)(c - '0');
-                    break;
-                default:
-                    JSONCONS_THROW(std::runtime_error(std::string("Invalid digit ") + "\'" + (char)c + "\'"));
+                p *= 10;
             }
+            for (; s < last; ++s)
+            {
+                CharT c = *s;
+                switch (c)
+                {
+                    case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                        n = n*10 + (uint64_t)(c - '0');
+                        p *= 10;
+                        break;
+                    default:
+                        JSONCONS_THROW(std::runtime_error(std::string("Invalid digit ") + "\'" + (char)c + "\'"));
+                }
+            }
+            v *= p;
+            v += n;
         }
 
         if (neg)
@@ -1006,16 +1026,25 @@ public:
             basic_bigint<Allocator> R;
             basic_bigint<Allocator> LP10 = p10; // LP10 = p10 = ::pow(10, ip10)
 
+            const char* pairs = jsoncons::detail::digit_pairs();
             do
             {
                 v.divide( LP10, v, R, true );
                 r = (R.length() ? R.data()[0] : 0);
-                for ( size_type j=0; j < ip10; j++ )
+                // Digits are written least significant first, two at a time.
+                // All but the most significant chunk are zero padded to ip10 digits.
+                size_type j = 0;
+                while ( j + 2 <= ip10 && (r >= 10 || v.length()) )
+                {
+                    size_type i = static_cast<size_type>(r % 100) * 2;
+                    r /= 100;
+                    data.push_back(pairs[i+1]);
+                    data.push_back(pairs[i]);
+                    j += 2;
+                }
+                if ( j < ip10 && (r != 0 || v.length() || j == 0) )
                 {
                     data.push_back(char(r % 10 + '0'));
-                    r /= 10;
-                    if ( r + v.length() == 0 )
-                        break;
                 }
             } 
             while ( v.length() );
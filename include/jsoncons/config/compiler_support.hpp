@@ -285,6 +285,17 @@
 #endif
 #endif
 
+// SIMD instruction sets used by the scanning kernels in detail/simd_scan.hpp.
+// Define JSONCONS_NO_SIMD to force the portable scalar kernels.
+#if !defined(JSONCONS_NO_SIMD)
+#  if defined(__AVX2__)
+#    define JSONCONS_HAS_AVX2 1
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define JSONCONS_HAS_SSE2 1
+#  endif
+#endif
+
 // Follows boost config/detail/suffix.hpp
 #if defined(JSONCONS_HAS_INT128) && defined(__cplusplus)
 namespace jsoncons{
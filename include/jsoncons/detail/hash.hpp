@@ -0,0 +1,65 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_HASH_HPP
+#define JSONCONS_DETAIL_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+
+namespace jsoncons {
+namespace detail {
+
+    // Folds the 128 bit product of a and b to 64 bits
+    inline uint64_t hash_mix(uint64_t a, uint64_t b) noexcept
+    {
+    #if defined(__SIZEOF_INT128__)
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+    #else
+        uint64_t ha = a >> 32, la = static_cast<uint32_t>(a);
+        uint64_t hb = b >> 32, lb = static_cast<uint32_t>(b);
+        uint64_t rh = ha*hb, rm0 = ha*lb, rm1 = hb*la, rl = la*lb;
+        uint64_t t = rl + (rm0 << 32);
+        uint64_t carry = t < rl ? 1 : 0;
+        uint64_t lo = t + (rm1 << 32);
+        carry += lo < t ? 1 : 0;
+        uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+        return lo ^ hi;
+    #endif
+    }
+
+    // A fast, non-cryptographic hash of a byte sequence, eight bytes at a
+    // time. Not stable across platforms or versions, do not persist it.
+    inline std::size_t hash_bytes(const void* data, std::size_t length, uint64_t seed = 0) noexcept
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint64_t h = seed ^ (static_cast<uint64_t>(length) * 0x9E3779B97F4A7C15ull);
+        while (length >= 8)
+        {
+            uint64_t w;
+            std::memcpy(&w, p, 8);
+            h = hash_mix(h ^ w, 0xA0761D6478BD642Full);
+            p += 8;
+            length -= 8;
+        }
+        uint64_t w = 0;
+        std::memcpy(&w, p, length);
+        h = hash_mix(h ^ w, 0xE7037ED1A0B428DBull);
+        return static_cast<std::size_t>(hash_mix(h, 0x8EBC6AF09C88C6E3ull));
+    }
+
+    template <class CharT>
+    std::size_t hash_string(const CharT* s, std::size_t length, uint64_t seed = 0) noexcept
+    {
+        return hash_bytes(s, length*sizeof(CharT), seed);
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
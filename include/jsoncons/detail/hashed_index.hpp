@@ -0,0 +1,405 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_HASHED_INDEX_HPP
+#define JSONCONS_DETAIL_HASHED_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy, std::memset
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator_traits
+#include <utility> // std::swap
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/simd_scan.hpp> // count_trailing_zeros
+
+#if defined(JSONCONS_HAS_SSE2)
+#  include <emmintrin.h>
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    // hashed_index: an open addressing hash table of positions into a
+    // sequence, after Abseil's swiss tables. Each slot has a control byte
+    // that is empty, deleted, or holds the low seven bits of the hash of
+    // the element at the slot's position. A probe compares a group of
+    // sixteen control bytes at once (with SSE2 where available), and only
+    // looks at an element when its seven bits match. The hash is kept with
+    // the position so that growing never needs the elements, and the slot of
+    // each position is tracked so that inserting or erasing in the middle of
+    // the sequence only visits the positions that move.
+
+    template <class Allocator>
+    class hashed_index
+    {
+    public:
+        static constexpr std::size_t npos = (std::numeric_limits<std::size_t>::max)();
+    private:
+        static constexpr std::size_t group_width = 16;
+        static constexpr std::size_t min_capacity = 16;
+        static constexpr int8_t ctrl_empty = -128;
+        static constexpr int8_t ctrl_deleted = -2;
+
+        struct slot_type
+        {
+            std::size_t pos;
+            std::size_t hash;
+        };
+
+        using ctrl_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<int8_t>;
+        using slot_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<slot_type>;
+        using pos_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>;
+
+        // Bit i of a mask is set if control byte i of the group matches
+        class group
+        {
+            const int8_t* ctrl_;
+        public:
+            explicit group(const int8_t* ctrl)
+                : ctrl_(ctrl)
+            {
+            }
+
+        #if defined(JSONCONS_HAS_SSE2)
+            uint32_t match(int8_t h2) const
+            {
+                __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_));
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), g)));
+            }
+
+            uint32_t match_empty_or_deleted() const
+            {
+                __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_));
+                return static_cast<uint32_t>(_mm_movemask_epi8(g));
+            }
+        #else
+            uint32_t match(int8_t h2) const
+            {
+                uint32_t mask = 0;
+                for (std::size_t i = 0; i < group_width; ++i)
+                {
+                    mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+                }
+                return mask;
+            }
+
+            uint32_t match_empty_or_deleted() const
+            {
+                uint32_t mask = 0;
+                for (std::size_t i = 0; i < group_width; ++i)
+                {
+                    mask |= static_cast<uint32_t>(ctrl_[i] < 0) << i;
+                }
+                return mask;
+            }
+        #endif
+            uint32_t match_empty() const
+            {
+                return match(ctrl_empty);
+            }
+        };
+
+        Allocator alloc_;
+        int8_t* ctrl_; // capacity_ + group_width bytes, the last group_width mirror the first
+        slot_type* slots_;
+        std::size_t capacity_; // zero, or a power of two
+        std::size_t size_;
+        std::size_t growth_left_;
+        std::vector<std::size_t,pos_allocator_type> slot_of_; // slot of each position, or npos
+    public:
+        explicit hashed_index(const Allocator& alloc = Allocator())
+            : alloc_(alloc), ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+              slot_of_(pos_allocator_type(alloc))
+        {
+        }
+
+        hashed_index(const hashed_index& other)
+            : hashed_index(other, other.alloc_)
+        {
+        }
+
+        hashed_index(const hashed_index& other, const Allocator& alloc)
+            : alloc_(alloc), ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+              slot_of_(other.slot_of_, pos_allocator_type(alloc))
+        {
+            if (other.capacity_ != 0)
+            {
+                allocate(other.capacity_);
+                std::memcpy(ctrl_, other.ctrl_, capacity_ + group_width);
+                std::memcpy(static_cast<void*>(slots_), other.slots_, capacity_*sizeof(slot_type));
+                size_ = other.size_;
+                growth_left_ = other.growth_left_;
+            }
+        }
+
+        hashed_index(hashed_index&& other) noexcept
+            : alloc_(other.alloc_), ctrl_(other.ctrl_), slots_(other.slots_),
+              capacity_(other.capacity_), size_(other.size_), growth_left_(other.growth_left_),
+              slot_of_(std::move(other.slot_of_))
+        {
+            other.ctrl_ = nullptr;
+            other.slots_ = nullptr;
+            other.capacity_ = other.size_ = other.growth_left_ = 0;
+            other.slot_of_.clear();
+        }
+
+        hashed_index(hashed_index&& other, const Allocator& alloc)
+            : hashed_index(other, alloc)
+        {
+        }
+
+        ~hashed_index() noexcept
+        {
+            deallocate();
+        }
+
+        hashed_index& operator=(const hashed_index&) = delete;
+        hashed_index& operator=(hashed_index&&) = delete;
+
+        bool empty() const noexcept
+        {
+            return capacity_ == 0;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        void swap(hashed_index& other) noexcept
+        {
+            std::swap(ctrl_, other.ctrl_);
+            std::swap(slots_, other.slots_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(size_, other.size_);
+            std::swap(growth_left_, other.growth_left_);
+            slot_of_.swap(other.slot_of_);
+        }
+
+        // Releases the table
+        void clear() noexcept
+        {
+            deallocate();
+        }
+
+        // Makes room for n entries
+        void reserve(std::size_t n)
+        {
+            if (n > size_ + growth_left_)
+            {
+                rehash(n);
+            }
+            slot_of_.reserve(n);
+        }
+
+        // Returns the position whose hash is hash and for which equal(pos)
+        // is true, or npos
+        template <class Equal>
+        std::size_t find(std::size_t hash, Equal equal) const
+        {
+            if (capacity_ == 0)
+            {
+                return npos;
+            }
+            const std::size_t mask = capacity_ - 1;
+            const int8_t h2 = static_cast<int8_t>(hash & 0x7f);
+            std::size_t offset = (hash >> 7) & mask;
+            for (std::size_t step = group_width; ; step += group_width)
+            {
+                group g(ctrl_ + offset);
+                for (uint32_t m = g.match(h2); m != 0; m &= m - 1)
+                {
+                    const slot_type& slot = slots_[(offset + count_trailing_zeros(m)) & mask];
+                    if (slot.hash == hash && equal(slot.pos))
+                    {
+                        return slot.pos;
+                    }
+                }
+                if (g.match_empty() != 0)
+                {
+                    return npos;
+                }
+                offset = (offset + step) & mask;
+            }
+        }
+
+        // Adds pos, which must not already be present
+        void insert(std::size_t hash, std::size_t pos)
+        {
+            if (growth_left_ == 0)
+            {
+                rehash(size_ + 1);
+            }
+            if (pos >= slot_of_.size())
+            {
+                slot_of_.resize(pos + 1, npos);
+            }
+            std::size_t i = find_free_slot(hash);
+            if (ctrl_[i] == ctrl_empty)
+            {
+                --growth_left_;
+            }
+            set_ctrl(i, static_cast<int8_t>(hash & 0x7f));
+            slots_[i].pos = pos;
+            slots_[i].hash = hash;
+            ++size_;
+            slot_of_[pos] = i;
+        }
+
+        // Makes room for a new element at pos, positions at or above pos move up one
+        void shift_up(std::size_t pos)
+        {
+            if (pos >= slot_of_.size())
+            {
+                return;
+            }
+            slot_of_.insert(slot_of_.begin() + pos, npos);
+            for (std::size_t p = pos + 1; p < slot_of_.size(); ++p)
+            {
+                if (slot_of_[p] != npos)
+                {
+                    slots_[slot_of_[p]].pos = p;
+                }
+            }
+        }
+
+        // Removes positions [first,last), positions at or above last move down
+        void erase(std::size_t first, std::size_t last) noexcept
+        {
+            if (first >= slot_of_.size())
+            {
+                return;
+            }
+            if (last > slot_of_.size())
+            {
+                last = slot_of_.size();
+            }
+            for (std::size_t p = first; p < last; ++p)
+            {
+                if (slot_of_[p] != npos)
+                {
+                    set_ctrl(slot_of_[p], ctrl_deleted);
+                    --size_;
+                }
+            }
+            slot_of_.erase(slot_of_.begin() + first, slot_of_.begin() + last);
+            for (std::size_t p = first; p < slot_of_.size(); ++p)
+            {
+                if (slot_of_[p] != npos)
+                {
+                    slots_[slot_of_[p]].pos = p;
+                }
+            }
+        }
+    private:
+        std::size_t find_free_slot(std::size_t hash) const noexcept
+        {
+            const std::size_t mask = capacity_ - 1;
+            std::size_t offset = (hash >> 7) & mask;
+            for (std::size_t step = group_width; ; step += group_width)
+            {
+                uint32_t m = group(ctrl_ + offset).match_empty_or_deleted();
+                if (m != 0)
+                {
+                    return (offset + count_trailing_zeros(m)) & mask;
+                }
+                offset = (offset + step) & mask;
+            }
+        }
+
+        void set_ctrl(std::size_t i, int8_t h) noexcept
+        {
+            ctrl_[i] = h;
+            if (i < group_width)
+            {
+                ctrl_[capacity_ + i] = h;
+            }
+        }
+
+        // Load factor at most 7/8
+        static std::size_t max_load(std::size_t capacity) noexcept
+        {
+            return capacity - capacity/8;
+        }
+
+        void allocate(std::size_t capacity)
+        {
+            ctrl_allocator_type ctrl_alloc(alloc_);
+            slot_allocator_type slot_alloc(alloc_);
+            ctrl_ = to_plain_pointer(std::allocator_traits<ctrl_allocator_type>::allocate(ctrl_alloc, capacity + group_width));
+            JSONCONS_TRY
+            {
+                slots_ = to_plain_pointer(std::allocator_traits<slot_allocator_type>::allocate(slot_alloc, capacity));
+            }
+            JSONCONS_CATCH(...)
+            {
+                std::allocator_traits<ctrl_allocator_type>::deallocate(ctrl_alloc, ctrl_, capacity + group_width);
+                ctrl_ = nullptr;
+                JSONCONS_RETHROW;
+            }
+            std::memset(ctrl_, ctrl_empty, capacity + group_width);
+            capacity_ = capacity;
+            size_ = 0;
+            growth_left_ = max_load(capacity);
+        }
+
+        void deallocate() noexcept
+        {
+            if (capacity_ != 0)
+            {
+                ctrl_allocator_type ctrl_alloc(alloc_);
+                slot_allocator_type slot_alloc(alloc_);
+                std::allocator_traits<ctrl_allocator_type>::deallocate(ctrl_alloc, ctrl_, capacity_ + group_width);
+                std::allocator_traits<slot_allocator_type>::deallocate(slot_alloc, slots_, capacity_);
+                ctrl_ = nullptr;
+                slots_ = nullptr;
+                capacity_ = size_ = growth_left_ = 0;
+            }
+            slot_of_.clear();
+        }
+
+        // Rebuilds the table with room for at least n entries, dropping deleted slots
+        void rehash(std::size_t n)
+        {
+            std::size_t capacity = min_capacity;
+            while (max_load(capacity) < n || capacity < 2*n)
+            {
+                capacity *= 2;
+            }
+            hashed_index temp(alloc_);
+            temp.allocate(capacity);
+            temp.slot_of_.swap(slot_of_);
+            for (std::size_t i = 0; i < capacity_; ++i)
+            {
+                if (ctrl_[i] >= 0)
+                {
+                    std::size_t j = temp.find_free_slot(slots_[i].hash);
+                    temp.set_ctrl(j, static_cast<int8_t>(slots_[i].hash & 0x7f));
+                    temp.slots_[j] = slots_[i];
+                    temp.slot_of_[slots_[i].pos] = j;
+                    ++temp.size_;
+                    --temp.growth_left_;
+                }
+            }
+            swap(temp);
+        }
+    };
+
+    template <class Allocator>
+    constexpr std::size_t hashed_index<Allocator>::npos;
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
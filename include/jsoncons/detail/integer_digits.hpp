@@ -0,0 +1,129 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_INTEGER_DIGITS_HPP
+#define JSONCONS_DETAIL_INTEGER_DIGITS_HPP
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <type_traits> // std::enable_if
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/endian.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+
+// Digit kernels shared by the integer parsers and formatters. Parsing
+// validates and converts eight ASCII digits at a time in a 64-bit word
+// (SWAR), formatting emits two digits at a time from a lookup table.
+
+namespace jsoncons {
+namespace detail {
+
+    // Loads s[0..7] so that s[0] is the least significant byte
+    inline uint64_t load_eight_digits(const char* s)
+    {
+        uint64_t val;
+        std::memcpy(&val, s, sizeof(val));
+        return jsoncons::detail::endian::native == jsoncons::detail::endian::big ? byte_swap(val) : val;
+    }
+
+    inline bool is_eight_digits(uint64_t val)
+    {
+        return ((val & 0xF0F0F0F0F0F0F0F0ull) | (((val + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+    }
+
+    // Precondition: is_eight_digits(val)
+    inline uint32_t parse_eight_digits(uint64_t val)
+    {
+        const uint64_t mask = 0x000000FF000000FFull;
+        const uint64_t mul1 = 0x000F424000000064ull; // 100 + (1000000 << 32)
+        const uint64_t mul2 = 0x0000271000000001ull; // 1 + (10000 << 32)
+        val -= 0x3030303030303030ull;
+        val = (val * 10) + (val >> 8); // pairs of digits
+        val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+        return static_cast<uint32_t>(val);
+    }
+
+    // accumulate_eight_digits: n = n*10^8 + digits for each block of eight
+    // digits at the front of [s,end), stopping before a block could overflow n.
+    // Returns a pointer to the first character not consumed, the remaining
+    // digits (and any overflow) are left to the caller's digit-by-digit loop.
+
+    template <class T, class CharT>
+    typename std::enable_if<!(std::is_same<CharT,char>::value && sizeof(T) >= sizeof(uint32_t)),const CharT*>::type
+    accumulate_eight_digits(T&, const CharT* s, const CharT*)
+    {
+        return s;
+    }
+
+    template <class T, class CharT>
+    typename std::enable_if<std::is_same<CharT,char>::value && sizeof(T) >= sizeof(uint32_t),const CharT*>::type
+    accumulate_eight_digits(T& n, const CharT* s, const CharT* end)
+    {
+        static constexpr T max_value = (jsoncons::detail::integer_limits<T>::max)();
+        static constexpr T max_value_div_10e8 = (max_value - T(99999999)) / T(100000000);
+
+        while (end - s >= 8 && n <= max_value_div_10e8)
+        {
+            uint64_t val = load_eight_digits(s);
+            if (!is_eight_digits(val))
+            {
+                break;
+            }
+            n = n * T(100000000) + static_cast<T>(parse_eight_digits(val));
+            s += 8;
+        }
+        return s;
+    }
+
+    // accumulate_eight_digits_negative: as above, but n = n*10^8 - digits
+
+    template <class T, class CharT>
+    typename std::enable_if<!(std::is_same<CharT,char>::value && sizeof(T) >= sizeof(uint32_t)),const CharT*>::type
+    accumulate_eight_digits_negative(T&, const CharT* s, const CharT*)
+    {
+        return s;
+    }
+
+    template <class T, class CharT>
+    typename std::enable_if<std::is_same<CharT,char>::value && sizeof(T) >= sizeof(uint32_t),const CharT*>::type
+    accumulate_eight_digits_negative(T& n, const CharT* s, const CharT* end)
+    {
+        static constexpr T min_value = (jsoncons::detail::integer_limits<T>::lowest)();
+        static constexpr T min_value_div_10e8 = (min_value + T(99999999)) / T(100000000);
+
+        while (end - s >= 8 && n >= min_value_div_10e8)
+        {
+            uint64_t val = load_eight_digits(s);
+            if (!is_eight_digits(val))
+            {
+                break;
+            }
+            n = n * T(100000000) - static_cast<T>(parse_eight_digits(val));
+            s += 8;
+        }
+        return s;
+    }
+
+    // digit_pairs: "00" "01" ... "99", the digits of i at [2*i] and [2*i+1]
+
+    inline const char* digit_pairs()
+    {
+        return "00010203040506070809"
+               "10111213141516171819"
+               "20212223242526272829"
+               "30313233343536373839"
+               "40414243444546474849"
+               "50515253545556575859"
+               "60616263646566676869"
+               "70717273747576777879"
+               "80818283848586878889"
+               "90919293949596979899";
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
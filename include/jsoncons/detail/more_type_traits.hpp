@@ -18,6 +18,7 @@
 #include <cstddef> // std::byte
 #include <utility> // std::declval
 #include <climits> // CHAR_BIT
+#include <limits> // std::numeric_limits
 #include <jsoncons/config/compiler_support.hpp>
 
 namespace jsoncons {
@@ -404,6 +405,14 @@ namespace detail {
     using
     container_reserve_t = decltype(std::declval<Container>().reserve(typename Container::size_type()));
 
+    template<class Container, class CharT>
+    using
+    container_append_t = decltype(std::declval<Container&>().append(std::declval<const CharT*>(), std::size_t()));
+
+    template<class Container>
+    using
+    container_resize_t = decltype(std::declval<Container>().resize(typename Container::size_type()));
+
     template<class Container>
     using
     container_data_t = decltype(std::declval<Container>().data());
@@ -499,6 +508,18 @@ namespace detail {
     using
     has_reserve = is_detected<container_reserve_t, Container>;
 
+    // has_resize
+
+    template<class Container>
+    using
+    has_resize = is_detected<container_resize_t, Container>;
+
+    // has_append
+
+    template<class Container, class CharT>
+    using
+    has_append = is_detected<container_append_t, Container, CharT>;
+
     // is_back_insertable
 
     template<class Container>
@@ -541,6 +562,18 @@ namespace detail {
         static constexpr bool value = has_data<Container>::value && has_size<Container>::value;
     };
 
+    // is_resizable_contiguous_container
+
+    template <class Container, class Enable=void>
+    struct is_resizable_contiguous_container : std::false_type {};
+
+    template <class Container>
+    struct is_resizable_contiguous_container<Container, 
+           typename std::enable_if<has_data<Container>::value &&
+                                   has_resize<Container>::value &&
+                                   has_reserve<Container>::value
+    >::type> : std::true_type {};
+
     // is_byte_sequence
 
     template <class Container, class Enable=void>
@@ -17,6 +17,8 @@
 #include <type_traits> // std::enable_if
 #include <exception>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/eisel_lemire.hpp>
+#include <jsoncons/detail/integer_digits.hpp>
 #include <cctype>
 
 namespace jsoncons { namespace detail {
@@ -198,6 +200,7 @@ to_integer_decimal(const CharT* s, std::size_t length)
             {
                 static constexpr T max_value = (jsoncons::detail::integer_limits<T>::max)();
                 static constexpr T max_value_div_10 = max_value / 10;
+                s = jsoncons::detail::accumulate_eight_digits(n, s, end);
                 for (; s < end; ++s)
                 {
                     T x = 0;
@@ -391,6 +394,7 @@ to_integer(const CharT* s, std::size_t length)
             {
                 static constexpr T max_value = (jsoncons::detail::integer_limits<T>::max)();
                 static constexpr T max_value_div_10 = max_value / 10;
+                s = jsoncons::detail::accumulate_eight_digits(n, s, end);
                 for (; s < end; ++s)
                 {
                     T x = 0;
@@ -554,6 +558,7 @@ to_integer_unchecked(const CharT* s, std::size_t length)
     {
         static constexpr T max_value = (jsoncons::detail::integer_limits<T>::max)();
         static constexpr T max_value_div_10 = max_value / 10;
+        s = jsoncons::detail::accumulate_eight_digits(n, s, end);
         for (; s < end; ++s)
         {
             T x = static_cast<T>(*s) - static_cast<T>('0');
@@ -595,6 +600,7 @@ to_integer_unchecked(const CharT* s, std::size_t length)
         static constexpr T min_value = (jsoncons::detail::integer_limits<T>::lowest)();
         static constexpr T min_value_div_10 = min_value / 10;
         ++s;
+        s = jsoncons::detail::accumulate_eight_digits_negative(n, s, end);
         for (; s < end; ++s)
         {
             T x = (T)*s - (T)('0');
@@ -615,6 +621,7 @@ to_integer_unchecked(const CharT* s, std::size_t length)
     {
         static constexpr T max_value = (jsoncons::detail::integer_limits<T>::max)();
         static constexpr T max_value_div_10 = max_value / 10;
+        s = jsoncons::detail::accumulate_eight_digits(n, s, end);
         for (; s < end; ++s)
         {
             T x = static_cast<T>(*s) - static_cast<T>('0');
@@ -766,6 +773,94 @@ base16_to_integer(const CharT* s, std::size_t length)
     return to_integer_result<T>(n);
 }
 
+// decimal_to_double
+
+// Converts [s, s+length) to the nearest double without consulting the C locale, if 
+// the whole range is a decimal number with at most 19 significant digits and the 
+// Eisel-Lemire algorithm can round it with certainty. Returns false otherwise, 
+// in which case the caller falls back to the strtod family.
+template <class CharT>
+bool decimal_to_double(const CharT* s, std::size_t length, char decimal_point, double& val)
+{
+    const CharT* p = s;
+    const CharT* last = s + length;
+
+    bool negative = false;
+    if (p != last && *p == '-')
+    {
+        negative = true;
+        ++p;
+    }
+
+    uint64_t i = 0;
+    int64_t power = 0;
+    int significant_digits = 0;
+    bool has_digits = false;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p)
+    {
+        has_digits = true;
+        if (i == 0 && *p == '0')
+        {
+            continue;
+        }
+        if (++significant_digits > 19)
+        {
+            return false;
+        }
+        i = 10*i + static_cast<uint64_t>(*p - '0');
+    }
+    if (p != last && (*p == '.' || *p == decimal_point))
+    {
+        ++p;
+        for (; p != last && *p >= '0' && *p <= '9'; ++p)
+        {
+            has_digits = true;
+            --power;
+            if (i == 0 && *p == '0')
+            {
+                continue;
+            }
+            if (++significant_digits > 19)
+            {
+                return false;
+            }
+            i = 10*i + static_cast<uint64_t>(*p - '0');
+        }
+    }
+    if (!has_digits)
+    {
+        return false;
+    }
+    if (p != last && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool negative_exponent = false;
+        if (p != last && (*p == '-' || *p == '+'))
+        {
+            negative_exponent = *p == '-';
+            ++p;
+        }
+        if (p == last || !(*p >= '0' && *p <= '9'))
+        {
+            return false;
+        }
+        int64_t exponent = 0;
+        for (; p != last && *p >= '0' && *p <= '9'; ++p)
+        {
+            if (exponent < 100000)
+            {
+                exponent = 10*exponent + (*p - '0');
+            }
+        }
+        power += negative_exponent ? -exponent : exponent;
+    }
+    if (p != last)
+    {
+        return false;
+    }
+    return eisel_lemire(power, i, negative, val);
+}
+
 #if defined(JSONCONS_HAS_MSC__STRTOD_L)
 
 class to_double_t
@@ -800,10 +895,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, '.', val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = _strtod_l(s, &end, locale_);
+        val = _strtod_l(s, &end, locale_);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -813,10 +913,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, '.', val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = _wcstod_l(s, &end, locale_);
+        val = _wcstod_l(s, &end, locale_);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -860,8 +965,13 @@ public:
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
     operator()(const CharT* s, std::size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, '.', val))
+        {
+            return val;
+        }
         char *end = nullptr;
-        double val = strtold_l(s, &end, locale_);
+        val = strtold_l(s, &end, locale_);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -873,8 +983,13 @@ public:
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
     operator()(const CharT* s, std::size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, '.', val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = wcstold_l(s, &end, locale_);
+        val = wcstold_l(s, &end, locale_);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -915,10 +1030,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,char>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, decimal_point_, val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = strtod(s, &end);
+        val = strtod(s, &end);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -928,10 +1048,15 @@ public:
 
     template <class CharT>
     typename std::enable_if<std::is_same<CharT,wchar_t>::value,double>::type
-    operator()(const CharT* s, std::size_t /*length*/) const
+    operator()(const CharT* s, std::size_t length) const
     {
+        double val;
+        if (decimal_to_double(s, length, decimal_point_, val))
+        {
+            return val;
+        }
         CharT *end = nullptr;
-        double val = wcstod(s, &end);
+        val = wcstod(s, &end);
         if (s == end)
         {
             JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Convert string to double failed"));
@@ -0,0 +1,129 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SHARED_NODE_HPP
+#define JSONCONS_DETAIL_SHARED_NODE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility> // std::forward
+
+namespace jsoncons {
+namespace detail {
+
+    // shared_node: a heap allocated value with a reference count, for
+    // copy on write storage. A node stops being shareable once a mutable
+    // reference into it has been handed out, since later copies must not
+    // see changes made through that reference. Copies of an unshareable
+    // node are deep (one level, the elements themselves may still share).
+
+    template <class T>
+    struct shared_node
+    {
+        mutable std::atomic<std::size_t> refs;
+        bool shareable;
+        T value;
+
+        template <class... Args>
+        explicit shared_node(Args&&... args)
+            : refs(1), shareable(true), value(std::forward<Args>(args)...)
+        {
+        }
+
+        shared_node(const shared_node&) = delete;
+        shared_node& operator=(const shared_node&) = delete;
+
+        auto get_allocator() const -> decltype(value.get_allocator())
+        {
+            return value.get_allocator();
+        }
+    };
+
+    // node_traits gives plain and shared nodes one interface, a plain node
+    // is never shared
+
+    template <class T>
+    struct node_traits
+    {
+        using value_type = T;
+
+        static T& value(T& node) noexcept
+        {
+            return node;
+        }
+
+        static const T& value(const T& node) noexcept
+        {
+            return node;
+        }
+
+        // Adds a reference to node if it can be shared
+        static bool share(const T&) noexcept
+        {
+            return false;
+        }
+
+        // Drops a reference to node, returns true if it was the last
+        static bool release(T&) noexcept
+        {
+            return true;
+        }
+
+        static bool is_shared(const T&) noexcept
+        {
+            return false;
+        }
+
+        static void set_unshareable(T&) noexcept
+        {
+        }
+    };
+
+    template <class T>
+    struct node_traits<shared_node<T>>
+    {
+        using value_type = T;
+
+        static T& value(shared_node<T>& node) noexcept
+        {
+            return node.value;
+        }
+
+        static const T& value(const shared_node<T>& node) noexcept
+        {
+            return node.value;
+        }
+
+        static bool share(const shared_node<T>& node) noexcept
+        {
+            if (!node.shareable)
+            {
+                return false;
+            }
+            node.refs.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        static bool release(shared_node<T>& node) noexcept
+        {
+            return node.refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        static bool is_shared(const shared_node<T>& node) noexcept
+        {
+            return node.refs.load(std::memory_order_acquire) > 1;
+        }
+
+        static void set_unshareable(shared_node<T>& node) noexcept
+        {
+            node.shareable = false;
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
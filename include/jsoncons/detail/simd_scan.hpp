@@ -0,0 +1,321 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SIMD_SCAN_HPP
+#define JSONCONS_DETAIL_SIMD_SCAN_HPP
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <type_traits> // std::make_unsigned
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_AVX2)
+#  include <immintrin.h>
+#elif defined(JSONCONS_HAS_SSE2)
+#  include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+// Scanning kernels used by the text parsers and encoders to skip over runs
+// of characters that need no per-character handling. Each kernel returns a
+// pointer to the first character in [first,last) that stops the run, or last.
+// The char overloads process 32 (AVX2), 16 (SSE2) or 8 (SWAR) bytes at a
+// time, the kernel being selected at compile time.
+
+namespace jsoncons {
+namespace detail {
+
+    inline int count_trailing_zeros(uint32_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(x);
+    #elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((x & 1) == 0)
+        {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // SWAR helpers, each byte of the result has its high bit set if the
+    // corresponding byte of x satisfies the predicate. Bytes above a match
+    // may report false positives, so these are used to detect, not locate.
+
+    constexpr uint64_t swar_ones = 0x0101010101010101ull;
+    constexpr uint64_t swar_highs = 0x8080808080808080ull;
+
+    inline uint64_t swar_has_byte(uint64_t x, uint8_t b)
+    {
+        uint64_t y = x ^ (swar_ones * b);
+        return (y - swar_ones) & ~y & swar_highs;
+    }
+
+    inline uint64_t swar_has_less(uint64_t x, uint8_t n)
+    {
+        return (x - swar_ones * n) & ~x & swar_highs;
+    }
+
+    inline uint64_t load_u64(const char* p)
+    {
+        uint64_t x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+
+    // find_string_special: the next quotation mark, reverse solidus or control character
+
+    template <class CharT>
+    const CharT* find_string_special(const CharT* first, const CharT* last)
+    {
+        while (first != last && !(*first == '\"' || *first == '\\' || static_cast<typename std::make_unsigned<CharT>::type>(*first) < 0x20))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    inline const char* find_string_special(const char* first, const char* last)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1f);
+        while (last - first >= 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash));
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi8(_mm256_min_epu8(v, control), v));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 32;
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i control = _mm_set1_epi8(0x1f);
+            while (last - first >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+                m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m));
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 16;
+            }
+        }
+    #endif
+        while (last - first >= 8)
+        {
+            uint64_t x = load_u64(first);
+            if ((swar_has_byte(x, '\"') | swar_has_byte(x, '\\') | swar_has_less(x, 0x20)) != 0)
+            {
+                break;
+            }
+            first += 8;
+        }
+        while (first != last)
+        {
+            uint8_t c = static_cast<uint8_t>(*first);
+            if (c == '\"' || c == '\\' || c < 0x20)
+            {
+                break;
+            }
+            ++first;
+        }
+        return first;
+    }
+
+    // find_escape_char: the next character that an encoder may need to escape,
+    // the quote character, a reverse solidus, a control character or DEL, and
+    // optionally a solidus or any non-ASCII character. Encoders copy the run
+    // before it unchanged and handle the character itself case by case.
+
+    template <class CharT>
+    const CharT* find_escape_char(const CharT* first, const CharT* last, CharT quote, bool solidus, bool non_ascii)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+        while (first != last)
+        {
+            uchar_type c = static_cast<uchar_type>(*first);
+            if (c < 0x20 || c == 0x7f || *first == quote || c == '\\' || (solidus && c == '/') || (non_ascii && c >= 0x80))
+            {
+                break;
+            }
+            ++first;
+        }
+        return first;
+    }
+
+    inline const char* find_escape_char(const char* first, const char* last, char quote, bool solidus, bool non_ascii)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        {
+            const __m256i quote_v = _mm256_set1_epi8(quote);
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i control = _mm256_set1_epi8(0x1f);
+            const __m256i del = _mm256_set1_epi8(0x7f);
+            // Without the solidus option, compare against a character already tested for
+            const __m256i slash = _mm256_set1_epi8(solidus ? '/' : '\\');
+            const uint32_t high_mask = non_ascii ? 0xffffffffu : 0;
+            while (last - first >= 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote_v), _mm256_cmpeq_epi8(v, backslash));
+                m = _mm256_or_si256(m, _mm256_cmpeq_epi8(_mm256_min_epu8(v, control), v));
+                m = _mm256_or_si256(m, _mm256_or_si256(_mm256_cmpeq_epi8(v, del), _mm256_cmpeq_epi8(v, slash)));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m)) |
+                                (static_cast<uint32_t>(_mm256_movemask_epi8(v)) & high_mask);
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 32;
+            }
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i quote_v = _mm_set1_epi8(quote);
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i control = _mm_set1_epi8(0x1f);
+            const __m128i del = _mm_set1_epi8(0x7f);
+            const __m128i slash = _mm_set1_epi8(solidus ? '/' : '\\');
+            const uint32_t high_mask = non_ascii ? 0xffffu : 0;
+            while (last - first >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, quote_v), _mm_cmpeq_epi8(v, backslash));
+                m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+                m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi8(v, del), _mm_cmpeq_epi8(v, slash)));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m)) |
+                                (static_cast<uint32_t>(_mm_movemask_epi8(v)) & high_mask);
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 16;
+            }
+        }
+    #endif
+        {
+            const uint8_t slash = solidus ? '/' : '\\';
+            const uint64_t high_mask = non_ascii ? swar_highs : 0;
+            while (last - first >= 8)
+            {
+                uint64_t x = load_u64(first);
+                if ((swar_has_byte(x, static_cast<uint8_t>(quote)) | swar_has_byte(x, '\\') | swar_has_less(x, 0x20) |
+                     swar_has_byte(x, 0x7f) | swar_has_byte(x, slash) | (x & high_mask)) != 0)
+                {
+                    break;
+                }
+                first += 8;
+            }
+        }
+        while (first != last)
+        {
+            uint8_t c = static_cast<uint8_t>(*first);
+            if (c < 0x20 || c == 0x7f || *first == quote || c == '\\' || (solidus && c == '/') || (non_ascii && c >= 0x80))
+            {
+                break;
+            }
+            ++first;
+        }
+        return first;
+    }
+
+    // skip_blanks: past spaces and horizontal tabs
+
+    template <class CharT>
+    const CharT* skip_blanks(const CharT* first, const CharT* last)
+    {
+        while (first != last && (*first == ' ' || *first == '\t'))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    inline const char* skip_blanks(const char* first, const char* last)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab));
+            uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(m)) & 0xffff;
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+    #endif
+        while (first != last && (*first == ' ' || *first == '\t'))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    // skip_digits: past decimal digits
+
+    template <class CharT>
+    const CharT* skip_digits(const CharT* first, const CharT* last)
+    {
+        while (first != last && (*first >= '0' && *first <= '9'))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    inline const char* skip_digits(const char* first, const char* last)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i nine = _mm_set1_epi8(9);
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)), zero);
+            __m128i m = _mm_cmpeq_epi8(_mm_min_epu8(v, nine), v);
+            uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(m)) & 0xffff;
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+    #endif
+        while (first != last && (*first >= '0' && *first <= '9'))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
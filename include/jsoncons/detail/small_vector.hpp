@@ -0,0 +1,608 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SMALL_VECTOR_HPP
+#define JSONCONS_DETAIL_SMALL_VECTOR_HPP
+
+#include <algorithm> // std::move, std::move_backward, std::rotate, std::equal, std::lexicographical_compare
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator_traits, std::addressof
+#include <stdexcept> // std::out_of_range
+#include <type_traits>
+#include <utility> // std::move, std::forward, std::swap
+#include <jsoncons/config/compiler_support.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // small_vector: a std::vector work-alike that stores as many elements
+    // as fit in InlineBytes inside the object itself, and moves them to the
+    // heap when it grows beyond that. Used as a policy's
+    // sequence_container_type, it keeps a small array or object in the same
+    // allocation as its json_array or json_object. The inline buffer is sized
+    // in bytes rather than elements so that the layout does not depend on
+    // sizeof(T), and T may be incomplete (basic_json names its own array
+    // iterator types in its class body.) Iterators are plain pointers.
+
+    template <class T, class Allocator, std::size_t InlineBytes = 128>
+    class small_vector
+    {
+    public:
+        using value_type = T;
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    private:
+        using alloc_traits = std::allocator_traits<allocator_type>;
+
+        static_assert(std::is_same<typename alloc_traits::pointer,T*>::value,
+                      "small_vector requires an allocator with raw pointers");
+
+        // Empty base optimization for stateless allocators
+        struct impl : public allocator_type
+        {
+            T* data_;
+            size_type size_;
+            size_type capacity_;
+
+            impl(const allocator_type& alloc) noexcept
+                : allocator_type(alloc), data_(nullptr), size_(0), capacity_(inline_capacity())
+            {
+            }
+        };
+
+        impl impl_;
+        alignas(std::max_align_t) unsigned char inline_[InlineBytes];
+
+        static constexpr size_type inline_capacity() noexcept
+        {
+            return InlineBytes/sizeof(T);
+        }
+
+        T* inline_data() noexcept
+        {
+            return reinterpret_cast<T*>(inline_);
+        }
+
+        bool is_inline() const noexcept
+        {
+            return impl_.data_ == reinterpret_cast<const T*>(inline_);
+        }
+
+        allocator_type& alloc() noexcept
+        {
+            return impl_;
+        }
+
+        const allocator_type& alloc() const noexcept
+        {
+            return impl_;
+        }
+    public:
+        small_vector() noexcept(std::is_nothrow_default_constructible<allocator_type>::value)
+            : impl_(allocator_type())
+        {
+            impl_.data_ = inline_data();
+        }
+
+        explicit small_vector(const allocator_type& alloc) noexcept
+            : impl_(alloc)
+        {
+            impl_.data_ = inline_data();
+        }
+
+        explicit small_vector(size_type n, const allocator_type& alloc = allocator_type())
+            : impl_(alloc)
+        {
+            impl_.data_ = inline_data();
+            resize(n);
+        }
+
+        small_vector(size_type n, const T& value, const allocator_type& alloc = allocator_type())
+            : impl_(alloc)
+        {
+            impl_.data_ = inline_data();
+            resize(n, value);
+        }
+
+        template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        small_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : impl_(alloc)
+        {
+            impl_.data_ = inline_data();
+            append(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+        }
+
+        small_vector(std::initializer_list<T> init, const allocator_type& alloc = allocator_type())
+            : impl_(alloc)
+        {
+            impl_.data_ = inline_data();
+            append(init.begin(), init.end(), std::random_access_iterator_tag());
+        }
+
+        small_vector(const small_vector& other)
+            : impl_(alloc_traits::select_on_container_copy_construction(other.alloc()))
+        {
+            impl_.data_ = inline_data();
+            append(other.begin(), other.end(), std::random_access_iterator_tag());
+        }
+
+        small_vector(const small_vector& other, const allocator_type& alloc)
+            : impl_(alloc)
+        {
+            impl_.data_ = inline_data();
+            append(other.begin(), other.end(), std::random_access_iterator_tag());
+        }
+
+        small_vector(small_vector&& other) noexcept
+            : impl_(other.alloc())
+        {
+            impl_.data_ = inline_data();
+            steal(other);
+        }
+
+        small_vector(small_vector&& other, const allocator_type& alloc)
+            : impl_(alloc)
+        {
+            impl_.data_ = inline_data();
+            if (alloc == other.alloc())
+            {
+                steal(other);
+            }
+            else
+            {
+                move_elements_from(other);
+            }
+        }
+
+        ~small_vector() noexcept
+        {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "small_vector does not support over-aligned types");
+            clear();
+            deallocate_heap();
+        }
+
+        small_vector& operator=(const small_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if (alloc_traits::propagate_on_container_copy_assignment::value && alloc() != other.alloc())
+                {
+                    deallocate_heap();
+                    alloc() = other.alloc();
+                }
+                append(other.begin(), other.end(), std::random_access_iterator_tag());
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                if (alloc_traits::propagate_on_container_move_assignment::value)
+                {
+                    deallocate_heap();
+                    alloc() = other.alloc();
+                    steal(other);
+                }
+                else if (alloc() == other.alloc())
+                {
+                    deallocate_heap();
+                    steal(other);
+                }
+                else
+                {
+                    move_elements_from(other);
+                }
+            }
+            return *this;
+        }
+
+        small_vector& operator=(std::initializer_list<T> init)
+        {
+            clear();
+            append(init.begin(), init.end(), std::random_access_iterator_tag());
+            return *this;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc();
+        }
+
+        // Iterators
+
+        iterator begin() noexcept {return impl_.data_;}
+        const_iterator begin() const noexcept {return impl_.data_;}
+        const_iterator cbegin() const noexcept {return impl_.data_;}
+        iterator end() noexcept {return impl_.data_ + impl_.size_;}
+        const_iterator end() const noexcept {return impl_.data_ + impl_.size_;}
+        const_iterator cend() const noexcept {return impl_.data_ + impl_.size_;}
+        reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+        const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+        reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+        const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+        // Capacity
+
+        bool empty() const noexcept {return impl_.size_ == 0;}
+        size_type size() const noexcept {return impl_.size_;}
+        size_type capacity() const noexcept {return impl_.capacity_;}
+        size_type max_size() const noexcept {return alloc_traits::max_size(alloc());}
+
+        void reserve(size_type n)
+        {
+            if (n > impl_.capacity_)
+            {
+                reallocate(n);
+            }
+        }
+
+        void shrink_to_fit()
+        {
+            if (!is_inline() && impl_.capacity_ > impl_.size_)
+            {
+                reallocate(impl_.size_);
+            }
+        }
+
+        // Element access
+
+        reference operator[](size_type i) {return impl_.data_[i];}
+        const_reference operator[](size_type i) const {return impl_.data_[i];}
+
+        reference at(size_type i)
+        {
+            if (i >= impl_.size_)
+            {
+                JSONCONS_THROW(std::out_of_range("small_vector index out of range"));
+            }
+            return impl_.data_[i];
+        }
+
+        const_reference at(size_type i) const
+        {
+            if (i >= impl_.size_)
+            {
+                JSONCONS_THROW(std::out_of_range("small_vector index out of range"));
+            }
+            return impl_.data_[i];
+        }
+
+        reference front() {return impl_.data_[0];}
+        const_reference front() const {return impl_.data_[0];}
+        reference back() {return impl_.data_[impl_.size_-1];}
+        const_reference back() const {return impl_.data_[impl_.size_-1];}
+        T* data() noexcept {return impl_.data_;}
+        const T* data() const noexcept {return impl_.data_;}
+
+        // Modifiers
+
+        void clear() noexcept
+        {
+            destroy_range(impl_.data_, impl_.data_ + impl_.size_);
+            impl_.size_ = 0;
+        }
+
+        template <class... Args>
+        reference emplace_back(Args&&... args)
+        {
+            if (impl_.size_ == impl_.capacity_)
+            {
+                // Construct the new element first, args may refer to an element
+                size_type new_capacity = grown_capacity(impl_.size_ + 1);
+                T* p = allocate(new_capacity);
+                JSONCONS_TRY
+                {
+                    alloc_traits::construct(alloc(), p + impl_.size_, std::forward<Args>(args)...);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    alloc_traits::deallocate(alloc(), p, new_capacity);
+                    JSONCONS_RETHROW;
+                }
+                relocate_to(p, new_capacity);
+            }
+            else
+            {
+                alloc_traits::construct(alloc(), impl_.data_ + impl_.size_, std::forward<Args>(args)...);
+            }
+            ++impl_.size_;
+            return back();
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back()
+        {
+            --impl_.size_;
+            alloc_traits::destroy(alloc(), impl_.data_ + impl_.size_);
+        }
+
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            size_type index = static_cast<size_type>(pos - begin());
+            if (index == impl_.size_)
+            {
+                emplace_back(std::forward<Args>(args)...);
+                return begin() + index;
+            }
+            T value(std::forward<Args>(args)...);
+            emplace_back(std::move(back()));
+            std::move_backward(begin() + index, end() - 2, end() - 1);
+            impl_.data_[index] = std::move(value);
+            return begin() + index;
+        }
+
+        iterator insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        template <class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        iterator insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            size_type index = static_cast<size_type>(pos - begin());
+            size_type old_size = impl_.size_;
+            append(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+            std::rotate(begin() + index, begin() + old_size, end());
+            return begin() + index;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            iterator p = begin() + (first - cbegin());
+            iterator q = begin() + (last - cbegin());
+            if (p != q)
+            {
+                iterator new_end = std::move(q, end(), p);
+                destroy_range(new_end, end());
+                impl_.size_ -= static_cast<size_type>(q - p);
+            }
+            return p;
+        }
+
+        void resize(size_type n)
+        {
+            if (n < impl_.size_)
+            {
+                erase(begin() + n, end());
+            }
+            else
+            {
+                reserve(n);
+                while (impl_.size_ < n)
+                {
+                    alloc_traits::construct(alloc(), impl_.data_ + impl_.size_);
+                    ++impl_.size_;
+                }
+            }
+        }
+
+        void resize(size_type n, const T& value)
+        {
+            if (n < impl_.size_)
+            {
+                erase(begin() + n, end());
+            }
+            else
+            {
+                if (n > impl_.capacity_)
+                {
+                    T copy(value);
+                    reserve(n);
+                    fill_to(n, copy);
+                }
+                else
+                {
+                    fill_to(n, value);
+                }
+            }
+        }
+
+        void swap(small_vector& other) noexcept
+        {
+            if (!is_inline() && !other.is_inline() && (alloc_traits::propagate_on_container_swap::value || alloc() == other.alloc()))
+            {
+                std::swap(impl_.data_, other.impl_.data_);
+                std::swap(impl_.size_, other.impl_.size_);
+                std::swap(impl_.capacity_, other.impl_.capacity_);
+                if (alloc_traits::propagate_on_container_swap::value)
+                {
+                    using std::swap;
+                    swap(alloc(), other.alloc());
+                }
+            }
+            else
+            {
+                small_vector temp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(temp);
+            }
+        }
+
+        friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+        {
+            return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const small_vector& lhs, const small_vector& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const small_vector& lhs, const small_vector& rhs)
+        {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend void swap(small_vector& lhs, small_vector& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+    private:
+        T* allocate(size_type n)
+        {
+            return alloc_traits::allocate(alloc(), n);
+        }
+
+        void deallocate_heap() noexcept
+        {
+            if (!is_inline())
+            {
+                alloc_traits::deallocate(alloc(), impl_.data_, impl_.capacity_);
+                impl_.data_ = inline_data();
+                impl_.capacity_ = inline_capacity();
+            }
+        }
+
+        void destroy_range(T* first, T* last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                alloc_traits::destroy(alloc(), first);
+            }
+        }
+
+        size_type grown_capacity(size_type min_capacity) const
+        {
+            size_type n = 2*impl_.capacity_;
+            return n < min_capacity ? min_capacity : n;
+        }
+
+        // Moves the elements to p, which has room for capacity elements,
+        // and makes it the storage. If capacity fits, moves back inline.
+        void relocate_to(T* p, size_type capacity) noexcept
+        {
+            for (size_type i = 0; i < impl_.size_; ++i)
+            {
+                alloc_traits::construct(alloc(), p + i, std::move(impl_.data_[i]));
+                alloc_traits::destroy(alloc(), impl_.data_ + i);
+            }
+            deallocate_heap();
+            impl_.data_ = p;
+            impl_.capacity_ = capacity;
+        }
+
+        void reallocate(size_type n)
+        {
+            if (n <= inline_capacity())
+            {
+                if (!is_inline())
+                {
+                    T* old_data = impl_.data_;
+                    size_type old_capacity = impl_.capacity_;
+                    T* p = inline_data();
+                    for (size_type i = 0; i < impl_.size_; ++i)
+                    {
+                        alloc_traits::construct(alloc(), p + i, std::move(old_data[i]));
+                        alloc_traits::destroy(alloc(), old_data + i);
+                    }
+                    alloc_traits::deallocate(alloc(), old_data, old_capacity);
+                    impl_.data_ = p;
+                    impl_.capacity_ = inline_capacity();
+                }
+                return;
+            }
+            relocate_to(allocate(n), n);
+        }
+
+        // Takes other's heap buffer, or moves its inline elements
+        void steal(small_vector& other) noexcept
+        {
+            if (other.is_inline())
+            {
+                move_elements_from(other);
+            }
+            else
+            {
+                impl_.data_ = other.impl_.data_;
+                impl_.size_ = other.impl_.size_;
+                impl_.capacity_ = other.impl_.capacity_;
+                other.impl_.data_ = other.inline_data();
+                other.impl_.size_ = 0;
+                other.impl_.capacity_ = inline_capacity();
+            }
+        }
+
+        void move_elements_from(small_vector& other)
+        {
+            reserve(other.size());
+            for (auto& item : other)
+            {
+                alloc_traits::construct(alloc(), impl_.data_ + impl_.size_, std::move(item));
+                ++impl_.size_;
+            }
+            other.clear();
+        }
+
+        void fill_to(size_type n, const T& value)
+        {
+            while (impl_.size_ < n)
+            {
+                alloc_traits::construct(alloc(), impl_.data_ + impl_.size_, value);
+                ++impl_.size_;
+            }
+        }
+
+        template <class InputIt>
+        void append(InputIt first, InputIt last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+
+        template <class ForwardIt>
+        void append(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+        {
+            reserve(impl_.size_ + static_cast<size_type>(std::distance(first, last)));
+            for (; first != last; ++first)
+            {
+                alloc_traits::construct(alloc(), impl_.data_ + impl_.size_, *first);
+                ++impl_.size_;
+            }
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -13,6 +13,7 @@
 #include <ostream>
 #include <cstring> // std::memcpy
 #include <memory> // std::allocator
+#include <atomic>
 #include <jsoncons/config/compiler_support.hpp>
 
 namespace jsoncons { 
@@ -364,6 +365,144 @@ namespace detail {
         }
     };
 
+    // shared_string_wrapper: a string_wrapper whose copies share one
+    // allocation, with an atomic reference count
+
+    template <class CharT,class Allocator>
+    class shared_string_wrapper
+    {
+    public:
+        using char_type = CharT;
+    private:
+        struct str_t
+        {
+            Allocator alloc_;
+            mutable std::atomic<std::size_t> refs_;
+            std::size_t length_;
+            const char_type* p_;
+
+            str_t(const Allocator& alloc)
+                : alloc_(alloc), refs_(1), length_(0), p_(nullptr)
+            {
+            }
+
+            str_t(const str_t&) = delete;
+            str_t& operator=(const str_t&) = delete;
+        };
+
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<char> byte_allocator_type;  
+        using byte_pointer = typename std::allocator_traits<byte_allocator_type>::pointer;
+
+        struct storage_t
+        {
+            str_t data;
+            char_type c[1];
+        };
+        typedef typename std::aligned_storage<sizeof(storage_t), alignof(storage_t)>::type storage_kind;
+
+        str_t* ptr_;
+    public:
+        shared_string_wrapper(const char_type* data, std::size_t length, const Allocator& a) 
+        {
+            ptr_ = create(data,length,a);
+        }
+
+        shared_string_wrapper(const shared_string_wrapper& val) noexcept
+            : ptr_(val.ptr_)
+        {
+            if (ptr_ != nullptr)
+            {
+                ptr_->refs_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        shared_string_wrapper(const shared_string_wrapper& val, const Allocator& a) 
+        {
+            if (val.get_allocator() == a)
+            {
+                ptr_ = val.ptr_;
+                ptr_->refs_.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                ptr_ = create(val.data(),val.length(),a);
+            }
+        }
+
+        explicit shared_string_wrapper(std::nullptr_t) noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        ~shared_string_wrapper() noexcept
+        {
+            if (ptr_ != nullptr && ptr_->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                destroy(ptr_);
+            }
+        }
+
+        shared_string_wrapper& operator=(const shared_string_wrapper&) = delete;
+
+        void swap(shared_string_wrapper& other) noexcept
+        {
+            std::swap(ptr_,other.ptr_);
+        }
+
+        const char_type* data() const
+        {
+            return ptr_->p_;
+        }
+
+        const char_type* c_str() const
+        {
+            return ptr_->p_;
+        }
+
+        std::size_t length() const
+        {
+            return ptr_->length_;
+        }
+
+        Allocator get_allocator() const
+        {
+            return ptr_->alloc_;
+        }
+    private:
+        static size_t aligned_size(std::size_t n)
+        {
+            return sizeof(storage_kind) + n;
+        }
+
+        static str_t* create(const char_type* s, std::size_t length, const Allocator& alloc)
+        {
+            std::size_t mem_size = aligned_size(length*sizeof(char_type));
+
+            byte_allocator_type byte_alloc(alloc);
+            byte_pointer ptr = byte_alloc.allocate(mem_size);
+
+            char* storage = to_plain_pointer(ptr);
+            str_t* ps = new(storage)str_t(alloc);
+
+            auto psa = launder_cast<storage_t*>(storage); 
+
+            CharT* p = new(&psa->c)char_type[length + 1];
+            std::memcpy(p, s, length*sizeof(char_type));
+            p[length] = 0;
+            ps->p_ = p;
+            ps->length_ = length;
+            return ps;
+        }
+
+        static void destroy(str_t* ps)
+        {
+            std::size_t mem_size = aligned_size(ps->length_*sizeof(char_type));
+            byte_allocator_type byte_alloc(ps->alloc_);
+            ps->~str_t();
+            byte_alloc.deallocate(std::pointer_traits<byte_pointer>::pointer_to(*launder_cast<char*>(ps)),mem_size);
+        }
+    };
+
 } // namespace detail
 } // namespace jsoncons
 
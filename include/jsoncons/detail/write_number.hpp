@@ -16,7 +16,7 @@
 #include <stdio.h> // snprintf
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_options.hpp>
-#include <jsoncons/detail/grisu3.hpp>
+#include <jsoncons/detail/ryu.hpp>
 #include <jsoncons/detail/parse_number.hpp>
 #include <jsoncons/detail/more_type_traits.hpp>
 
@@ -36,39 +36,42 @@ namespace detail {
     from_integer(Integer value, Result& result)
     {
         using char_type = typename Result::value_type;
+        using U = typename jsoncons::detail::make_unsigned<Integer>::type;
 
         char_type buf[255];
-        char_type *p = buf;
-        const char_type* last = buf+255;
+        char_type* last = buf+255;
+        char_type* p = last;
 
         bool is_negative = value < 0;
+        U u = is_negative ? U(0) - static_cast<U>(value) : static_cast<U>(value);
 
-        if (value < 0)
+        // Two digits at a time, from the least significant end
+        const char* pairs = jsoncons::detail::digit_pairs();
+        while (u >= 100)
         {
-            do
-            {
-                *p++ = static_cast<char_type>(48 - (value % 10));
-            }
-            while ((value /= 10) && (p < last));
+            std::size_t i = static_cast<std::size_t>(u % 100) * 2;
+            u /= 100;
+            *--p = static_cast<char_type>(pairs[i+1]);
+            *--p = static_cast<char_type>(pairs[i]);
+        }
+        if (u >= 10)
+        {
+            std::size_t i = static_cast<std::size_t>(u) * 2;
+            *--p = static_cast<char_type>(pairs[i+1]);
+            *--p = static_cast<char_type>(pairs[i]);
         }
         else
         {
-
-            do
-            {
-                *p++ = static_cast<char_type>(48 + value % 10);
-            }
-            while ((value /= 10) && (p < last));
+            *--p = static_cast<char_type>('0' + static_cast<int>(u));
         }
-        JSONCONS_ASSERT(p != last);
 
-        std::size_t count = (p - buf);
+        std::size_t count = (last - p);
         if (is_negative)
         {
             result.push_back('-');
             ++count;
         }
-        while (--p >= buf)
+        for (; p < last; ++p)
         {
             result.push_back(*p);
         }
@@ -283,8 +286,28 @@ namespace detail {
         }
     }
 
+    // d[.ddd]e(+|-)dd from v = buffer * 10^k
+    template <class Result>
+    void scientific_string(const char *buffer, std::size_t length, int k, Result& result)
+    {
+        int nb_digits = (int)length;
+        int exp = nb_digits + k - 1;
+
+        result.push_back(buffer[0]);
+        if (nb_digits > 1)
+        {
+            result.push_back('.');
+            for (int i = 1; i < nb_digits; ++i)
+            {
+                result.push_back(buffer[i]);
+            }
+        }
+        result.push_back('e');
+        fill_exponent(exp, result);
+    }
+
     template<class Result>
-    bool dtoa_scientific(double val, char decimal_point, Result& result)
+    bool dtoa_scientific(double val, char decimal_point, Result& result, std::false_type)
     {
         if (val == 0)
         {
@@ -303,7 +326,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*e", precision2, val);
@@ -316,6 +339,38 @@ namespace detail {
         return true;
     }
 
+    template<class Result>
+    bool dtoa_scientific(double v, char decimal_point, Result& result, std::true_type)
+    {
+        if (v == 0)
+        {
+            result.push_back('0');
+            result.push_back('.');
+            result.push_back('0');
+            return true;
+        }
+
+        int length = 0;
+        int k;
+
+        char buffer[100];
+
+        double u = std::signbit(v) ? -v : v;
+        if (jsoncons::detail::ryu(u, buffer, &length, &k))
+        {
+            if (std::signbit(v))
+            {
+                result.push_back('-');
+            }
+            jsoncons::detail::scientific_string(buffer, length, k, result);
+            return true;
+        }
+        else
+        {
+            return dtoa_scientific(v, decimal_point, result, std::false_type());
+        }
+    }
+
     template<class Result>
     bool dtoa_general(double val, char decimal_point, Result& result, std::false_type)
     {
@@ -336,7 +391,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*g", precision2, val);
@@ -366,7 +421,7 @@ namespace detail {
         char buffer[100];
 
         double u = std::signbit(v) ? -v : v;
-        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
+        if (jsoncons::detail::ryu(u, buffer, &length, &k))
         {
             if (std::signbit(v))
             {
@@ -403,7 +458,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*f", precision2, val);
@@ -433,7 +488,7 @@ namespace detail {
         char buffer[100];
 
         double u = std::signbit(v) ? -v : v;
-        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
+        if (jsoncons::detail::ryu(u, buffer, &length, &k))
         {
             if (std::signbit(v))
             {
@@ -454,6 +509,12 @@ namespace detail {
         return dtoa_fixed(v, decimal_point, result, std::integral_constant<bool, std::numeric_limits<double>::is_iec559>());
     }
 
+    template<class Result>
+    bool dtoa_scientific(double v, char decimal_point, Result& result)
+    {
+        return dtoa_scientific(v, decimal_point, result, std::integral_constant<bool, std::numeric_limits<double>::is_iec559>());
+    }
+
     template<class Result>
     bool dtoa_general(double v, char decimal_point, Result& result)
     {
@@ -0,0 +1,259 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_GATHER_SINK_HPP
+#define JSONCONS_GATHER_SINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <cerrno>
+#include <algorithm> // std::min
+#include <functional>
+#include <system_error>
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/sink.hpp>
+
+#if !defined(_WIN32)
+#  include <climits> // IOV_MAX
+#  include <sys/uio.h>
+#  include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+    // A run of output bytes, either copied into the sink's buffer or
+    // referenced in place
+
+    struct gather_segment
+    {
+        const uint8_t* data;
+        std::size_t size;
+    };
+
+    // gather_sink: a binary sink that copies headers and small values into a
+    // buffer, but records payloads of reference_threshold bytes or more that
+    // are handed to append_ref by pointer, without copying them. On flush,
+    // or when the buffer fills, the segment list is passed to a handler, or
+    // on POSIX platforms written to a file descriptor with writev.
+    //
+    // Referenced payloads must stay valid until the next flush. Encoders
+    // pass strings and byte strings as given to their visit functions, so
+    // this sink suits encoding values that outlive the call, e.g. encode_cbor
+    // of a basic_json, but not transcoding from a streaming reader.
+
+    class gather_sink
+    {
+    public:
+        using value_type = uint8_t;
+        using segment_handler = std::function<void(const gather_segment*, std::size_t)>;
+
+        static constexpr std::size_t default_buffer_length = 16384;
+        static constexpr std::size_t default_reference_threshold = 4096;
+    private:
+        segment_handler handler_;
+        std::vector<uint8_t> buffer_;
+        uint8_t* begin_buffer_;
+        const uint8_t* end_buffer_;
+        uint8_t* p_;
+        const uint8_t* run_start_;
+        std::size_t reference_threshold_;
+        std::vector<gather_segment> segments_;
+
+        // Noncopyable
+        gather_sink(const gather_sink&) = delete;
+        gather_sink& operator=(const gather_sink&) = delete;
+    public:
+        gather_sink(gather_sink&&) = default;
+
+        explicit gather_sink(segment_handler handler,
+                             std::size_t buflen = default_buffer_length,
+                             std::size_t reference_threshold = default_reference_threshold)
+            : handler_(std::move(handler)),
+              buffer_(buflen > 0 ? buflen : 1),
+              begin_buffer_(buffer_.data()),
+              end_buffer_(begin_buffer_ + buffer_.size()),
+              p_(begin_buffer_),
+              run_start_(begin_buffer_),
+              reference_threshold_((std::min)(reference_threshold, buffer_.size()))
+        {
+        }
+
+#if !defined(_WIN32)
+        explicit gather_sink(int fd,
+                             std::size_t buflen = default_buffer_length,
+                             std::size_t reference_threshold = default_reference_threshold)
+            : gather_sink(fd_writer(fd), buflen, reference_threshold)
+        {
+        }
+#endif
+
+        ~gather_sink() noexcept
+        {
+            JSONCONS_TRY
+            {
+                flush();
+            }
+            JSONCONS_CATCH(...)
+            {
+            }
+        }
+
+        gather_sink& operator=(gather_sink&&) = default;
+
+        std::size_t reference_threshold() const
+        {
+            return reference_threshold_;
+        }
+
+        void flush()
+        {
+            close_run();
+            if (!segments_.empty())
+            {
+                handler_(segments_.data(), segments_.size());
+                segments_.clear();
+            }
+            p_ = begin_buffer_;
+            run_start_ = begin_buffer_;
+        }
+
+        void push_back(uint8_t ch)
+        {
+            if (p_ == end_buffer_)
+            {
+                flush();
+            }
+            *p_++ = ch;
+        }
+
+        void append(const uint8_t* s, std::size_t length)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < length)
+            {
+                flush();
+                if (length >= buffer_.size())
+                {
+                    // Too large to buffer, write it out on its own
+                    gather_segment segment{s, length};
+                    handler_(&segment, 1);
+                    return;
+                }
+            }
+            std::memcpy(p_, s, length);
+            p_ += length;
+        }
+
+        // Like append, but a payload at or above the threshold is referenced
+        // in place rather than copied
+        void append_ref(const uint8_t* s, std::size_t length)
+        {
+            if (length < reference_threshold_)
+            {
+                append(s, length);
+                return;
+            }
+            close_run();
+            segments_.push_back(gather_segment{s, length});
+        }
+
+        void reserve(std::size_t n)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < n)
+            {
+                flush();
+                if (buffer_.size() < n)
+                {
+                    buffer_.resize(n);
+                    begin_buffer_ = buffer_.data();
+                    end_buffer_ = begin_buffer_ + buffer_.size();
+                    p_ = begin_buffer_;
+                    run_start_ = begin_buffer_;
+                }
+            }
+        }
+
+        uint8_t* write_ptr(std::size_t n)
+        {
+            reserve(n);
+            return p_;
+        }
+
+        void commit(std::size_t n)
+        {
+            p_ += n;
+        }
+
+    private:
+        // Closes the run of buffered bytes since the last referenced segment.
+        // The buffer never moves while segments point into it, it only grows
+        // right after a flush.
+        void close_run()
+        {
+            if (p_ != run_start_)
+            {
+                segments_.push_back(gather_segment{run_start_, static_cast<std::size_t>(p_ - run_start_)});
+                run_start_ = p_;
+            }
+        }
+
+#if !defined(_WIN32)
+        class fd_writer
+        {
+            int fd_;
+            std::vector<struct iovec> iov_;
+        public:
+            explicit fd_writer(int fd)
+                : fd_(fd)
+            {
+            }
+
+            void operator()(const gather_segment* segments, std::size_t count)
+            {
+                iov_.resize(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    iov_[i].iov_base = const_cast<uint8_t*>(segments[i].data);
+                    iov_[i].iov_len = segments[i].size;
+                }
+
+                // writev may write less than asked for, and takes at most IOV_MAX entries
+                struct iovec* iov = iov_.data();
+                std::size_t remaining = count;
+                while (remaining > 0)
+                {
+                    int n = static_cast<int>((std::min)(remaining, static_cast<std::size_t>(IOV_MAX)));
+                    ssize_t written = ::writev(fd_, iov, n);
+                    if (written < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        JSONCONS_THROW(std::system_error(errno, std::system_category(), "writev"));
+                    }
+                    std::size_t w = static_cast<std::size_t>(written);
+                    while (remaining > 0 && w >= iov->iov_len)
+                    {
+                        w -= iov->iov_len;
+                        ++iov;
+                        --remaining;
+                    }
+                    if (remaining > 0)
+                    {
+                        iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + w;
+                        iov->iov_len -= w;
+                    }
+                }
+            }
+        };
+#endif
+    };
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,608 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INTERNED_KEY_HPP
+#define JSONCONS_INTERNED_KEY_HPP
+
+#include <algorithm> // std::max
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <memory> // std::allocator, std::shared_ptr
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility> // std::swap
+#include <vector>
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/detail/hash.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/string_view.hpp>
+#include <jsoncons/detail/string_wrapper.hpp> // launder_cast
+
+namespace jsoncons {
+
+    template <class CharT,class Traits,class Allocator>
+    class basic_key_table;
+
+    // basic_interned_key: an immutable, reference counted object key.
+    // Copies share one allocation, and keys obtained from the same
+    // basic_key_table with equal contents share one allocation, so that
+    // comparing them compares pointers. An empty key holds no allocation.
+
+    template <class CharT,class Traits = std::char_traits<CharT>,class Allocator = std::allocator<CharT>>
+    class basic_interned_key
+    {
+        friend class basic_key_table<CharT,Traits,Allocator>;
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using const_iterator = const CharT*;
+        using iterator = const CharT*;
+        using string_view_type = jsoncons::basic_string_view<CharT,Traits>;
+        using table_type = basic_key_table<CharT,Traits,Allocator>;
+    private:
+        using byte_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+
+        struct node_type
+        {
+            std::atomic<std::size_t> refs_;
+            std::size_t length_;
+            std::size_t hash_;
+            byte_allocator_type alloc_;
+
+            node_type(std::size_t length, std::size_t hash, const byte_allocator_type& alloc)
+                : refs_(1), length_(length), hash_(hash), alloc_(alloc)
+            {
+            }
+
+            const CharT* data() const
+            {
+                return reinterpret_cast<const CharT*>(reinterpret_cast<const char*>(this) + header_size());
+            }
+        };
+
+        static constexpr std::size_t header_size()
+        {
+            return (sizeof(node_type) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        }
+
+        node_type* ptr_;
+
+        explicit basic_interned_key(node_type* ptr) noexcept
+            : ptr_(ptr)
+        {
+        }
+    public:
+        basic_interned_key() noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        explicit basic_interned_key(const allocator_type&) noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        basic_interned_key(const CharT* s, size_type length, const allocator_type& alloc = allocator_type())
+            : ptr_(length == 0 ? nullptr : create(s, length, hash(s, length), alloc))
+        {
+        }
+
+        basic_interned_key(const CharT* s, const allocator_type& alloc = allocator_type())
+            : basic_interned_key(s, Traits::length(s), alloc)
+        {
+        }
+
+        basic_interned_key(const CharT* first, const CharT* last, const allocator_type& alloc = allocator_type())
+            : basic_interned_key(first, static_cast<size_type>(last - first), alloc)
+        {
+        }
+
+        template <class InputIt>
+        basic_interned_key(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : ptr_(nullptr)
+        {
+            std::basic_string<CharT,Traits> s(first, last);
+            basic_interned_key(s.data(), s.length(), alloc).swap(*this);
+        }
+
+        explicit basic_interned_key(const string_view_type& sv, const allocator_type& alloc = allocator_type())
+            : basic_interned_key(sv.data(), sv.length(), alloc)
+        {
+        }
+
+        template <class Tr,class A>
+        basic_interned_key(const std::basic_string<CharT,Tr,A>& s, const allocator_type& alloc = allocator_type())
+            : basic_interned_key(s.data(), s.length(), alloc)
+        {
+        }
+
+        basic_interned_key(const basic_interned_key& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            add_ref();
+        }
+
+        // Shares other's allocation if it comes from an equal allocator,
+        // otherwise makes a copy with alloc
+        basic_interned_key(const basic_interned_key& other, const allocator_type& alloc)
+            : ptr_(other.ptr_)
+        {
+            if (ptr_ != nullptr && byte_allocator_type(alloc) != ptr_->alloc_)
+            {
+                ptr_ = create(other.data(), other.length(), ptr_->hash_, alloc);
+            }
+            else
+            {
+                add_ref();
+            }
+        }
+
+        basic_interned_key(basic_interned_key&& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            other.ptr_ = nullptr;
+        }
+
+        ~basic_interned_key() noexcept
+        {
+            release();
+        }
+
+        basic_interned_key& operator=(const basic_interned_key& other) noexcept
+        {
+            basic_interned_key(other).swap(*this);
+            return *this;
+        }
+
+        basic_interned_key& operator=(basic_interned_key&& other) noexcept
+        {
+            basic_interned_key(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        const CharT* data() const noexcept
+        {
+            return ptr_ != nullptr ? ptr_->data() : empty_data();
+        }
+
+        const CharT* c_str() const noexcept
+        {
+            return data();
+        }
+
+        size_type length() const noexcept
+        {
+            return ptr_ != nullptr ? ptr_->length_ : 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return length();
+        }
+
+        bool empty() const noexcept
+        {
+            return ptr_ == nullptr;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return data() + length();
+        }
+
+        allocator_type get_allocator() const
+        {
+            return ptr_ != nullptr ? allocator_type(ptr_->alloc_) : allocator_type();
+        }
+
+        // Keys that share an allocation are known to be equal
+        bool shares_with(const basic_interned_key& other) const noexcept
+        {
+            return ptr_ == other.ptr_;
+        }
+
+        operator string_view_type() const noexcept
+        {
+            return string_view_type(data(), length());
+        }
+
+        template <class Tr,class A>
+        explicit operator std::basic_string<CharT,Tr,A>() const
+        {
+            return std::basic_string<CharT,Tr,A>(data(), length());
+        }
+
+        int compare(const basic_interned_key& other) const noexcept
+        {
+            return ptr_ == other.ptr_ ? 0 : string_view_type(*this).compare(string_view_type(other));
+        }
+
+        int compare(const string_view_type& s) const noexcept
+        {
+            return string_view_type(*this).compare(s);
+        }
+
+        void swap(basic_interned_key& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+        }
+
+        void shrink_to_fit() noexcept
+        {
+        }
+
+        friend bool operator==(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            if (lhs.ptr_ == rhs.ptr_)
+            {
+                return true;
+            }
+            if (lhs.ptr_ == nullptr || rhs.ptr_ == nullptr || lhs.ptr_->hash_ != rhs.ptr_->hash_)
+            {
+                return false;
+            }
+            return lhs.compare(rhs) == 0;
+        }
+        friend bool operator==(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) == 0;
+        }
+        friend bool operator==(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) == 0;
+        }
+        friend bool operator==(const basic_interned_key& lhs, const CharT* rhs) noexcept
+        {
+            return lhs.compare(string_view_type(rhs)) == 0;
+        }
+
+        friend bool operator!=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator!=(const basic_interned_key& lhs, const CharT* rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+        friend bool operator<(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+        friend bool operator<(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) > 0;
+        }
+
+        friend bool operator<=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) <= 0;
+        }
+        friend bool operator<=(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) <= 0;
+        }
+        friend bool operator<=(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) >= 0;
+        }
+
+        friend bool operator>(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) > 0;
+        }
+        friend bool operator>(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) > 0;
+        }
+        friend bool operator>(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) < 0;
+        }
+
+        friend bool operator>=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) >= 0;
+        }
+        friend bool operator>=(const basic_interned_key& lhs, const string_view_type& rhs) noexcept
+        {
+            return lhs.compare(rhs) >= 0;
+        }
+        friend bool operator>=(const string_view_type& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return rhs.compare(lhs) <= 0;
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_interned_key& key)
+        {
+            os.write(key.data(), key.length());
+            return os;
+        }
+
+        friend void swap(basic_interned_key& lhs, basic_interned_key& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+    private:
+        static const CharT* empty_data() noexcept
+        {
+            static const CharT s[1] = {0};
+            return s;
+        }
+
+        static std::size_t hash(const CharT* s, std::size_t length) noexcept
+        {
+            return jsoncons::detail::hash_string(s, length);
+        }
+
+        static node_type* create(const CharT* s, std::size_t length, std::size_t hash, const allocator_type& alloc)
+        {
+            byte_allocator_type byte_alloc(alloc);
+            char* storage = jsoncons::detail::to_plain_pointer(byte_alloc.allocate(header_size() + (length+1)*sizeof(CharT)));
+            node_type* p = ::new(storage)node_type(length, hash, byte_alloc);
+            CharT* chars = jsoncons::detail::launder_cast<CharT*>(storage + header_size());
+            std::memcpy(chars, s, length*sizeof(CharT));
+            chars[length] = 0;
+            return p;
+        }
+
+        void add_ref() noexcept
+        {
+            if (ptr_ != nullptr)
+            {
+                ptr_->refs_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void release() noexcept
+        {
+            if (ptr_ != nullptr && ptr_->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                byte_allocator_type byte_alloc(ptr_->alloc_);
+                std::size_t mem_size = header_size() + (ptr_->length_+1)*sizeof(CharT);
+                ptr_->~node_type();
+                byte_alloc.deallocate(reinterpret_cast<char*>(ptr_), mem_size);
+            }
+            ptr_ = nullptr;
+        }
+    };
+
+    // basic_key_table: a set of interned keys. intern returns a key that
+    // shares its allocation with every other key interned from the table
+    // with the same contents. The table holds a reference to each of its
+    // keys, keys remain valid after the table is destroyed, and purge drops
+    // the keys nothing else holds. A table may be shared by several
+    // decoders, but not concurrently.
+
+    template <class CharT,class Traits = std::char_traits<CharT>,class Allocator = std::allocator<CharT>>
+    class basic_key_table
+    {
+    public:
+        using key_type = basic_interned_key<CharT,Traits,Allocator>;
+        using allocator_type = Allocator;
+        using string_view_type = jsoncons::basic_string_view<CharT,Traits>;
+    private:
+        using node_type = typename key_type::node_type;
+        using slot_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<key_type>;
+
+        allocator_type alloc_;
+        std::vector<key_type,slot_allocator_type> slots_;
+        std::size_t size_;
+    public:
+        explicit basic_key_table(const allocator_type& alloc = allocator_type())
+            : alloc_(alloc), slots_(slot_allocator_type(alloc)), size_(0)
+        {
+        }
+
+        basic_key_table(const basic_key_table&) = delete;
+        basic_key_table& operator=(const basic_key_table&) = delete;
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        key_type intern(const string_view_type& s)
+        {
+            if (s.length() == 0)
+            {
+                return key_type();
+            }
+            if (2*(size_+1) > slots_.size())
+            {
+                rehash(slots_.empty() ? 64 : 2*slots_.size());
+            }
+            std::size_t h = key_type::hash(s.data(), s.length());
+            std::size_t mask = slots_.size() - 1;
+            for (std::size_t i = h & mask; ; i = (i + 1) & mask)
+            {
+                key_type& slot = slots_[i];
+                if (slot.ptr_ == nullptr)
+                {
+                    slot = key_type(key_type::create(s.data(), s.length(), h, alloc_));
+                    ++size_;
+                    return slot;
+                }
+                if (slot.ptr_->hash_ == h && slot.compare(s) == 0)
+                {
+                    return slot;
+                }
+            }
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        // Drops the table's references, keys already handed out remain valid
+        void clear()
+        {
+            slots_.clear();
+            size_ = 0;
+        }
+
+        // Drops the keys that are referenced only by the table
+        void purge()
+        {
+            std::size_t count = 0;
+            for (auto& key : slots_)
+            {
+                if (key.ptr_ != nullptr)
+                {
+                    if (key.ptr_->refs_.load(std::memory_order_acquire) == 1)
+                    {
+                        key = key_type();
+                    }
+                    else
+                    {
+                        ++count;
+                    }
+                }
+            }
+            size_ = count;
+            if (size_ == 0)
+            {
+                std::vector<key_type,slot_allocator_type>(slot_allocator_type(alloc_)).swap(slots_);
+                return;
+            }
+            std::size_t capacity = 64;
+            while (2*(size_+1) > capacity)
+            {
+                capacity *= 2;
+            }
+            rehash(capacity);
+        }
+    private:
+        void rehash(std::size_t capacity)
+        {
+            std::vector<key_type,slot_allocator_type> slots(capacity, key_type(), slot_allocator_type(alloc_));
+            std::size_t mask = capacity - 1;
+            for (auto& key : slots_)
+            {
+                if (key.ptr_ != nullptr)
+                {
+                    std::size_t i = key.ptr_->hash_ & mask;
+                    while (slots[i].ptr_ != nullptr)
+                    {
+                        i = (i + 1) & mask;
+                    }
+                    slots[i] = std::move(key);
+                }
+            }
+            slots_.swap(slots);
+        }
+    };
+
+    using key_table = basic_key_table<char>;
+    using wkey_table = basic_key_table<wchar_t>;
+
+    template <class T>
+    struct is_interned_key : std::false_type {};
+
+    template <class CharT,class Traits,class Allocator>
+    struct is_interned_key<basic_interned_key<CharT,Traits,Allocator>> : std::true_type {};
+
+namespace detail {
+
+    // key_factory: makes object keys for json_decoder. Interned keys come
+    // from a key table that is created on first use, or supplied by the user.
+
+    template <class Key,class Enable = void>
+    class key_factory
+    {
+    public:
+        template <class Alloc>
+        Key operator()(const jsoncons::basic_string_view<typename Key::value_type>& s, const Alloc& alloc)
+        {
+            return Key(s.data(), s.length(), alloc);
+        }
+
+        void reset()
+        {
+        }
+    };
+
+    template <class Key>
+    class key_factory<Key,typename std::enable_if<is_interned_key<Key>::value>::type>
+    {
+        using table_type = typename Key::table_type;
+
+        static constexpr std::size_t min_purge_size = 1024;
+
+        std::shared_ptr<table_type> table_;
+        std::size_t purge_size_;
+    public:
+        key_factory()
+            : purge_size_(min_purge_size)
+        {
+        }
+
+        // Called between documents. Once the table has doubled since the last
+        // purge, drops the keys no decoded value holds any more, so that a
+        // decoder reused over a stream of documents with ever new keys stays
+        // bounded by the keys in use.
+        void reset()
+        {
+            if (table_ && table_->size() >= purge_size_)
+            {
+                table_->purge();
+                purge_size_ = (std::max)(min_purge_size, 2*table_->size());
+            }
+        }
+
+        template <class Alloc>
+        Key operator()(const jsoncons::basic_string_view<typename Key::value_type>& s, const Alloc& alloc)
+        {
+            if (!table_)
+            {
+                table_ = std::make_shared<table_type>(typename Key::allocator_type(alloc));
+            }
+            return table_->intern(s);
+        }
+
+        const std::shared_ptr<table_type>& table() const
+        {
+            return table_;
+        }
+
+        void table(std::shared_ptr<table_type> table)
+        {
+            table_ = std::move(table);
+            purge_size_ = (std::max)(min_purge_size, table_ ? 2*table_->size() : 0);
+        }
+    };
+
+    template <class Key>
+    constexpr std::size_t key_factory<Key,typename std::enable_if<is_interned_key<Key>::value>::type>::min_purge_size;
+
+} // namespace detail
+
+} // namespace jsoncons
+
+#endif
@@ -21,6 +21,8 @@
 #include <type_traits> // std::enable_if
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/allocator_holder.hpp>
+#include <jsoncons/detail/hash.hpp>
+#include <jsoncons/detail/hashed_index.hpp>
 
 namespace jsoncons {
 
@@ -83,8 +85,13 @@ namespace jsoncons {
         }
         json_array(const json_array& val, const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
-              elements_(val.elements_,value_allocator_type(alloc))
+              elements_(value_allocator_type(alloc))
         {
+            elements_.reserve(val.elements_.size());
+            for (const auto& item : val.elements_)
+            {
+                elements_.emplace_back(item, alloc);
+            }
         }
 
         json_array(json_array&& val) noexcept
@@ -286,6 +293,13 @@ namespace jsoncons {
             {
                 value_type current = std::move(elements_.back());
                 elements_.pop_back();
+                if (current.is_shared_container())
+                {
+                    // Another value still holds this container, so dropping
+                    // our reference is enough. Walking it through the non-const
+                    // ranges would unshare it, and copy it, only to destroy it.
+                    continue;
+                }
                 switch (current.storage())
                 {
                     case storage_kind::array_value:
@@ -381,6 +395,11 @@ namespace jsoncons {
         {
         }
 
+        key_value(const key_value& member, const allocator_type& alloc)
+            : key_(member.key_, typename key_type::allocator_type(alloc)), value_(member.value_, alloc)
+        {
+        }
+
         key_value(key_value&& member) noexcept
             : key_(std::move(member.key_)), value_(std::move(member.value_))
         {
@@ -575,8 +594,13 @@ namespace jsoncons {
 
         json_object(const json_object& val, const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
-              members_(val.members_,key_value_allocator_type(alloc))
+              members_(key_value_allocator_type(alloc))
         {
+            members_.reserve(val.members_.size());
+            for (const auto& member : val.members_)
+            {
+                members_.emplace_back(member, alloc);
+            }
         }
 
         json_object(json_object&& val,const allocator_type& alloc) 
@@ -593,11 +617,7 @@ namespace jsoncons {
             {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*s));
             }
-            std::stable_sort(members_.begin(),members_.end(),
-                             [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
-            auto it = std::unique(members_.begin(), members_.end(),
-                                  [](const key_value_type& a, const key_value_type& b) -> bool { return !(a.key().compare(b.key()));});
-            members_.erase(it, members_.end());
+            sort_unique_members();
         }
 
         template<class InputIt>
@@ -612,11 +632,7 @@ namespace jsoncons {
             {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*s));
             }
-            std::stable_sort(members_.begin(),members_.end(),
-                             [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
-            auto it = std::unique(members_.begin(), members_.end(),
-                                  [](const key_value_type& a, const key_value_type& b) -> bool { return !(a.key().compare(b.key()));});
-            members_.erase(it, members_.end());
+            sort_unique_members();
         }
 
         json_object(const std::initializer_list<std::pair<std::basic_string<char_type>,Json>>& init, 
@@ -753,11 +769,7 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
-            std::stable_sort(members_.begin(),members_.end(),
-                             [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
-            auto it = std::unique(members_.begin(), members_.end(),
-                                  [](const key_value_type& a, const key_value_type& b) -> bool { return !(a.key().compare(b.key()));});
-            members_.erase(it, members_.end());
+            sort_unique_members();
         }
 
         template<class InputIt, class Convert>
@@ -1208,6 +1220,35 @@ namespace jsoncons {
         }
 
         json_object& operator=(const json_object&) = delete;
+    private:
+        // Sorts the members by key and removes those with duplicate keys,
+        // keeping the first, members that are already in strictly ascending
+        // order, as decoded members usually are, are left as they are
+        void sort_unique_members()
+        {
+            auto it = std::adjacent_find(members_.begin(), members_.end(),
+                                         [](const key_value_type& a, const key_value_type& b) -> bool {return !(a.key().compare(b.key()) < 0);});
+            if (it == members_.end())
+            {
+                return;
+            }
+            auto less = [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;};
+            if (members_.size() <= 16)
+            {
+                // A stable insertion sort, std::stable_sort allocates a buffer
+                for (auto first = members_.begin() + 1; first != members_.end(); ++first)
+                {
+                    std::rotate(std::upper_bound(members_.begin(), first, *first, less), first, first + 1);
+                }
+            }
+            else
+            {
+                std::stable_sort(members_.begin(),members_.end(), less);
+            }
+            auto last = std::unique(members_.begin(), members_.end(),
+                                    [](const key_value_type& a, const key_value_type& b) -> bool { return !(a.key().compare(b.key()));});
+            members_.erase(last, members_.end());
+        }
     };
 
     // Preserve order
@@ -1228,9 +1269,15 @@ namespace jsoncons {
         using key_value_container_type = typename implementation_policy::template sequence_container_type<key_value_type,key_value_allocator_type>;
         typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::size_t> index_allocator_type;
         using index_container_type = typename implementation_policy::template sequence_container_type<std::size_t,index_allocator_type>;
+        using hashed_index_type = jsoncons::detail::hashed_index<index_allocator_type>;
+
+        // Objects with at least this many members are indexed by hashed_index_,
+        // smaller objects by index_, positions sorted by key
+        static constexpr std::size_t hashed_index_threshold = 32;
 
         key_value_container_type members_;
         index_container_type index_;
+        hashed_index_type hashed_index_;
     public:
         using iterator = typename key_value_container_type::iterator;
         using const_iterator = typename key_value_container_type::const_iterator;
@@ -1243,35 +1290,45 @@ namespace jsoncons {
         json_object(const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(index_allocator_type(alloc)),
+              hashed_index_(index_allocator_type(alloc))
         {
         }
 
         json_object(const json_object& val)
             : allocator_holder<allocator_type>(val.get_allocator()), 
               members_(val.members_),
-              index_(val.index_)
+              index_(val.index_),
+              hashed_index_(val.hashed_index_)
         {
         }
 
         json_object(json_object&& val)
             : allocator_holder<allocator_type>(val.get_allocator()), 
               members_(std::move(val.members_)),
-              index_(std::move(val.index_))
+              index_(std::move(val.index_)),
+              hashed_index_(std::move(val.hashed_index_))
         {
         }
 
         json_object(const json_object& val, const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
-              members_(val.members_,key_value_allocator_type(alloc)),
-              index_(val.index_,index_allocator_type(alloc))
+              members_(key_value_allocator_type(alloc)),
+              index_(val.index_,index_allocator_type(alloc)),
+              hashed_index_(val.hashed_index_,index_allocator_type(alloc))
         {
+            members_.reserve(val.members_.size());
+            for (const auto& member : val.members_)
+            {
+                members_.emplace_back(member, alloc);
+            }
         }
 
         json_object(json_object&& val,const allocator_type& alloc) 
             : allocator_holder<allocator_type>(alloc), 
               members_(std::move(val.members_),key_value_allocator_type(alloc)),
-              index_(std::move(val.index_),index_allocator_type(alloc))
+              index_(std::move(val.index_),index_allocator_type(alloc)),
+              hashed_index_(std::move(val.hashed_index_),index_allocator_type(alloc))
         {
         }
 
@@ -1285,7 +1342,7 @@ namespace jsoncons {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*s));
             }
 
-            build_index();
+            build_sorted_index();
             auto last_unique = std::unique(index_.begin(), index_.end(),
                 [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
 
@@ -1315,7 +1372,8 @@ namespace jsoncons {
                     const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(index_allocator_type(alloc)),
+              hashed_index_(index_allocator_type(alloc))
         {
             std::size_t count = std::distance(first,last);
             members_.reserve(count);
@@ -1324,7 +1382,7 @@ namespace jsoncons {
                 members_.emplace_back(get_key_value<KeyT,Json>()(*s));
             }
 
-            build_index();
+            build_sorted_index();
             auto last_unique = std::unique(index_.begin(), index_.end(),
                 [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
 
@@ -1353,7 +1411,8 @@ namespace jsoncons {
                     const allocator_type& alloc = allocator_type())
             : allocator_holder<allocator_type>(alloc), 
               members_(key_value_allocator_type(alloc)), 
-              index_(index_allocator_type(alloc))
+              index_(index_allocator_type(alloc)),
+              hashed_index_(index_allocator_type(alloc))
         {
             members_.reserve(init.size());
             for (auto& item : init)
@@ -1370,6 +1429,8 @@ namespace jsoncons {
         void swap(json_object& val) noexcept
         {
             members_.swap(val.members_);
+            index_.swap(val.index_);
+            hashed_index_.swap(val.hashed_index_);
         }
 
         iterator begin()
@@ -1400,6 +1461,7 @@ namespace jsoncons {
         {
             members_.clear();
             index_.clear();
+            hashed_index_.clear();
         }
 
         void shrink_to_fit() 
@@ -1434,30 +1496,12 @@ namespace jsoncons {
 
         iterator find(const string_view_type& name) noexcept
         {
-            auto it = std::lower_bound(index_.begin(),index_.end(), name, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
-            if (it != index_.end() && members_.at(*it).key() == name)
-            {
-                return members_.begin() + *it;
-            }
-            else
-            {
-                return members_.end();
-            }
+            return members_.begin() + find_position(name);
         }
 
         const_iterator find(const string_view_type& name) const noexcept
         {
-            auto it = std::lower_bound(index_.begin(),index_.end(), name, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
-            if (it != index_.end() && members_.at(*it).key() == name)
-            {
-                return members_.begin() + *it;
-            }
-            else
-            {
-                return members_.end();
-            }
+            return members_.begin() + find_position(name);
         }
 
         void erase(const_iterator first, const_iterator last) 
@@ -1476,7 +1520,10 @@ namespace jsoncons {
     #else
                 members_.erase(first,last);
     #endif
-                //build_index();
+                if (!hashed_index_.empty() && members_.size() < hashed_index_threshold/2)
+                {
+                    build_index();
+                }
             }
         }
 
@@ -1495,6 +1542,10 @@ namespace jsoncons {
     #else
                 members_.erase(pos);
     #endif
+                if (!hashed_index_.empty() && members_.size() < hashed_index_threshold/2)
+                {
+                    build_index();
+                }
             }
         }
 
@@ -1508,7 +1559,7 @@ namespace jsoncons {
                 members_.emplace_back(convert(*s));
             }
 
-            build_index();
+            build_sorted_index();
             auto last_unique = std::unique(index_.begin(), index_.end(),
                 [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
 
@@ -1529,8 +1580,18 @@ namespace jsoncons {
                         members_.erase(members_.begin() + (*it + 1), members_.begin() + *result);
                     }
                 }
+                build_index();
+            }
+            else if (members_.size() >= hashed_index_threshold)
+            {
+                build_hashed_index();
+            }
+            else
+            {
+                // The sorted index is already built, drop a hashed index left
+                // over from when the object was larger
+                hashed_index_.clear();
             }
-            build_index();
         }
 
         template<class InputIt, class Convert>
@@ -1900,9 +1961,57 @@ namespace jsoncons {
             }
         }
 
+        static std::size_t hash_key(const string_view_type& key) noexcept
+        {
+            return jsoncons::detail::hash_string(key.data(), key.length());
+        }
+
+        // The position of the member with this key, or size() 
+        std::size_t find_position(const string_view_type& name) const noexcept
+        {
+            if (!hashed_index_.empty())
+            {
+                std::size_t pos = hashed_index_.find(hash_key(name), 
+                                                     [&](std::size_t i) -> bool {return members_[i].key() == name;});
+                return pos == hashed_index_type::npos ? members_.size() : pos;
+            }
+            auto it = std::lower_bound(index_.begin(),index_.end(), name, 
+                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
+            if (it != index_.end() && members_.at(*it).key() == name)
+            {
+                return *it;
+            }
+            return members_.size();
+        }
+
+        // Returns the position of the member with this key and false if 
+        // there is one, otherwise makes room in the index for a new member
+        // at pos and returns pos and true
         std::pair<std::size_t,bool> insert_index_entry(const string_view_type& key, std::size_t pos)
         {
-            JSONCONS_ASSERT(pos <= index_.size());
+            JSONCONS_ASSERT(pos <= members_.size());
+
+            if (hashed_index_.empty() && members_.size() + 1 >= hashed_index_threshold)
+            {
+                build_hashed_index();
+            }
+            if (!hashed_index_.empty())
+            {
+                std::size_t hash = hash_key(key);
+                std::size_t found = hashed_index_.find(hash, 
+                                                       [&](std::size_t i) -> bool {return members_[i].key() == key;});
+                if (found != hashed_index_type::npos)
+                {
+                    return std::make_pair(found,false);
+                }
+                hashed_index_.reserve(hashed_index_.size() + 1);
+                if (pos < members_.size())
+                {
+                    hashed_index_.shift_up(pos);
+                }
+                hashed_index_.insert(hash, pos);
+                return std::make_pair(pos,true);
+            }
 
             auto it = std::lower_bound(index_.begin(),index_.end(), key, 
                                         [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
@@ -1944,42 +2053,71 @@ namespace jsoncons {
         void erase_index_entries(std::size_t pos1, std::size_t pos2)
         {
             JSONCONS_ASSERT(pos1 <= pos2);
-            JSONCONS_ASSERT(pos2 <= index_.size());
+            JSONCONS_ASSERT(pos2 <= members_.size());
 
-            const size_t offset = pos2 - pos1;
-            const size_t n = index_.size() - offset;
-            for (std::size_t i = 0; i < index_.size(); ++i)
+            if (!hashed_index_.empty())
             {
-                if (offset == index_.size())
-                {
-                    index_.erase(index_.begin()+i,index_.end());
-                    i += offset;
-                }
-                else if (index_[i] >= pos1 && index_[i] < pos2)
-                {
-                    index_.erase(index_.begin()+i);
-                }
+                hashed_index_.erase(pos1, pos2);
+                return;
             }
-            for (std::size_t i = 0; i < index_.size(); ++i)
+
+            const std::size_t offset = pos2 - pos1;
+            index_.erase(std::remove_if(index_.begin(), index_.end(),
+                                        [&](std::size_t i) -> bool {return i >= pos1 && i < pos2;}),
+                         index_.end());
+            for (auto& i : index_)
             {
-                if (index_[i] >= pos2)
+                if (i >= pos2)
                 {
-                    index_[i] -= offset;
+                    i -= offset;
                 }
             }
-            JSONCONS_ASSERT(index_.size() == n);
         }
 
         void build_index()
+        {
+            if (members_.size() >= hashed_index_threshold)
+            {
+                build_hashed_index();
+            }
+            else
+            {
+                hashed_index_.clear();
+                build_sorted_index();
+            }
+        }
+
+        void build_sorted_index()
         {
             index_.clear();
             index_.reserve(members_.size());
+            bool sorted = true;
             for (std::size_t i = 0; i < members_.size(); ++i)
             {
+                if (sorted && i > 0 && members_[i].key().compare(members_[i-1].key()) < 0)
+                {
+                    sorted = false;
+                }
                 index_.push_back(i);
             }
-            std::stable_sort(index_.begin(),index_.end(),
-                             [&](std::size_t a, std::size_t b) -> bool {return members_.at(a).key().compare(members_.at(b).key()) < 0;});
+            if (!sorted)
+            {
+                std::stable_sort(index_.begin(),index_.end(),
+                                 [&](std::size_t a, std::size_t b) -> bool {return members_.at(a).key().compare(members_.at(b).key()) < 0;});
+            }
+        }
+
+        // Keys are unique
+        void build_hashed_index()
+        {
+            index_.clear();
+            index_.shrink_to_fit();
+            hashed_index_.clear();
+            hashed_index_.reserve(members_.size());
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                hashed_index_.insert(hash_key(members_[i].key()), i);
+            }
         }
 
         json_object& operator=(const json_object&) = delete;
@@ -58,7 +58,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
                       const Allocator& alloc = Allocator(),
                       typename std::enable_if<!std::is_constructible<jsoncons::basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(accept_all),
          buffer_(alloc),
@@ -145,7 +145,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler,
                       std::error_code& ec,
                       typename std::enable_if<!std::is_constructible<jsoncons::basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(accept_all),
          buffer_(alloc),
@@ -246,29 +246,26 @@ public:
 
     void read_buffer(std::error_code& ec)
     {
-        buffer_.clear();
-        buffer_.resize(buffer_length_);
-        std::size_t count = source_.read(buffer_.data(), buffer_length_);
-        buffer_.resize(static_cast<std::size_t>(count));
-        if (buffer_.size() == 0)
+        auto chunk = source_reader<source_type>::read_chunk(source_, buffer_, buffer_length_);
+        if (chunk.size() == 0)
         {
             eof_ = true;
         }
         else if (begin_)
         {
-            auto result = unicons::skip_bom(buffer_.begin(), buffer_.end());
+            auto result = unicons::skip_bom(chunk.begin(), chunk.end());
             if (result.ec != unicons::encoding_errc())
             {
                 ec = result.ec;
                 return;
             }
-            std::size_t offset = result.it - buffer_.begin();
-            parser_.update(buffer_.data()+offset,buffer_.size()-offset);
+            std::size_t offset = result.it - chunk.begin();
+            parser_.update(chunk.data()+offset,chunk.size()-offset);
             begin_ = false;
         }
         else
         {
-            parser_.update(buffer_.data(),buffer_.size());
+            parser_.update(chunk.data(),chunk.size());
         }
     }
 
@@ -356,7 +353,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
                       const Allocator& alloc = Allocator(),
                       typename std::enable_if<!std::is_constructible<jsoncons::basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(filter),
          buffer_(alloc),
@@ -452,7 +449,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler,
                       std::error_code& ec,
                       typename std::enable_if<!std::is_constructible<jsoncons::basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(filter),
          buffer_(alloc),
@@ -13,8 +13,10 @@
 #include <memory> // std::allocator
 #include <iterator> // std::make_move_iterator
 #include <utility> // std::move
+#include <algorithm> // std::min, std::max
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/interned_key.hpp>
 
 namespace jsoncons {
 
@@ -77,11 +79,15 @@ private:
     Json result_;
 
     key_type name_;
+    jsoncons::detail::key_factory<key_type> key_factory_;
     std::vector<stack_item,stack_item_allocator_type> item_stack_;
     std::vector<structure_info,structure_info_allocator_type> structure_stack_;
+    std::size_t length_hint_limit_;
     bool is_valid_;
 
 public:
+    static constexpr std::size_t default_length_hint_limit = 65536;
+
     json_decoder(const temp_allocator_type& temp_alloc = temp_allocator_type())
         : result_allocator_(result_allocator_type()),
           temp_allocator_(temp_alloc),
@@ -89,6 +95,7 @@ public:
           name_(result_allocator_),
           item_stack_(temp_allocator_),
           structure_stack_(temp_allocator_),
+          length_hint_limit_(default_length_hint_limit),
           is_valid_(false) 
     {
         item_stack_.reserve(1000);
@@ -104,6 +111,7 @@ public:
           name_(result_allocator_),
           item_stack_(),
           structure_stack_(),
+          length_hint_limit_(default_length_hint_limit),
           is_valid_(false)
     {
         item_stack_.reserve(1000);
@@ -120,6 +128,7 @@ public:
           name_(result_allocator_),
           item_stack_(temp_allocator_),
           structure_stack_(temp_allocator_),
+          length_hint_limit_(default_length_hint_limit),
           is_valid_(false)
     {
         item_stack_.reserve(1000);
@@ -133,6 +142,39 @@ public:
         item_stack_.clear();
         structure_stack_.clear();
         structure_stack_.emplace_back(structure_type::root_t, 0);
+        key_factory_.reset();
+    }
+
+    // For interned keys, the table that keys are interned in. It is created
+    // on first use and kept across reset(), or it may be shared with other
+    // decoders to share keys across documents. reset() purges keys that no
+    // decoded value holds once the table has doubled in size.
+    template <class K = key_type>
+    typename std::enable_if<is_interned_key<K>::value,const std::shared_ptr<typename K::table_type>&>::type
+    key_table() const
+    {
+        return key_factory_.table();
+    }
+
+    template <class K = key_type>
+    typename std::enable_if<is_interned_key<K>::value>::type
+    key_table(std::shared_ptr<typename K::table_type> table)
+    {
+        key_factory_.table(std::move(table));
+    }
+
+    // Binary formats give the length of an array or object up front, and
+    // the decoder reserves room for that many elements. Since the length
+    // comes from the input, at most length_hint_limit elements are reserved
+    // ahead of their arrival, beyond that the decoder grows as usual.
+    std::size_t length_hint_limit() const
+    {
+        return length_hint_limit_;
+    }
+
+    void length_hint_limit(std::size_t value)
+    {
+        length_hint_limit_ = value;
     }
 
     bool is_valid() const
@@ -173,6 +215,13 @@ private:
         return true;
     }
 
+    bool visit_begin_object(std::size_t length, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+    {
+        bool more = visit_begin_object(tag, context, ec);
+        reserve_items(length);
+        return more;
+    }
+
     bool visit_end_object(const ser_context&, std::error_code&) override
     {
         JSONCONS_ASSERT(structure_stack_.size() > 0);
@@ -182,7 +231,7 @@ private:
         const size_t count = item_stack_.size() - (structure_index + 1);
         auto first = item_stack_.begin() + (structure_index+1);
         auto last = first + count;
-        item_stack_[structure_index].value_.object_value().insert(
+        item_stack_[structure_index].value_.modifiable_object_value().insert(
             std::make_move_iterator(first),
             std::make_move_iterator(last),
             [](stack_item&& val){return key_value_type(std::move(val.name_), std::move(val.value_));}
@@ -211,6 +260,13 @@ private:
         return true;
     }
 
+    bool visit_begin_array(std::size_t length, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+    {
+        bool more = visit_begin_array(tag, context, ec);
+        reserve_items(length);
+        return more;
+    }
+
     bool visit_end_array(const ser_context&, std::error_code&) override
     {
         JSONCONS_ASSERT(structure_stack_.size() > 1);
@@ -225,12 +281,13 @@ private:
 
         if (size > 0)
         {
-            container.reserve(size);
+            auto& elements = container.modifiable_array_value();
+            elements.reserve(size);
             auto first = item_stack_.begin() + (container_index+1);
             auto last = first + size;
             for (auto it = first; it != last; ++it)
             {
-                container.push_back(std::move(it->value_));
+                elements.push_back(std::move(it->value_));
             }
             item_stack_.erase(first, item_stack_.end());
         }
@@ -246,9 +303,22 @@ private:
         return true;
     }
 
+    void reserve_items(std::size_t length)
+    {
+        const std::size_t size = item_stack_.size();
+        const std::size_t capacity = item_stack_.capacity();
+        const std::size_t needed = size + (std::min)(length, length_hint_limit_);
+        if (needed > capacity)
+        {
+            // Grow geometrically, so that many small hints don't each reallocate,
+            // but never more than the limit ahead of the items actually present
+            item_stack_.reserve((std::max)(needed, (std::min)(2*capacity, size + length_hint_limit_)));
+        }
+    }
+
     bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
     {
-        name_ = key_type(name.data(),name.length(),result_allocator_);
+        name_ = key_factory_(name, result_allocator_);
         return true;
     }
 
@@ -415,6 +485,9 @@ private:
     }
 };
 
+template <class Json,class TempAllocator>
+constexpr std::size_t json_decoder<Json,TempAllocator>::default_length_hint_limit;
+
 }
 
 #endif
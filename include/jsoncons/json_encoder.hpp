@@ -23,6 +23,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/sink.hpp>
 #include <jsoncons/detail/write_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -45,10 +46,22 @@ namespace detail {
                          Sink& sink)
     {
         std::size_t count = 0;
-        const CharT* begin = s;
         const CharT* end = s + length;
-        for (const CharT* it = begin; it != end; ++it)
+        for (const CharT* it = s; it != end; ++it)
         {
+            // Copy the run of characters that need no escaping in one go
+            const CharT* run_end = jsoncons::detail::find_escape_char(it, end, static_cast<CharT>('\"'), escape_solidus, escape_all_non_ascii);
+            if (run_end != it)
+            {
+                jsoncons::detail::sink_append(sink, it, static_cast<std::size_t>(run_end - it));
+                count += static_cast<std::size_t>(run_end - it);
+                it = run_end;
+                if (it == end)
+                {
+                    break;
+                }
+            }
+
             CharT c = *it;
             switch (c)
             {
@@ -21,6 +21,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -263,9 +264,12 @@ public:
             {
                 case ' ':
                 case '\t':
-                    ++input_ptr_;
-                    ++position_;
+                {
+                    const CharT* p = jsoncons::detail::skip_blanks(input_ptr_ + 1, local_input_end);
+                    position_ += (p - input_ptr_);
+                    input_ptr_ = p;
                     break;
+                }
                 case '\r': 
                     push_state(state_);
                     ++input_ptr_;
@@ -1857,10 +1861,13 @@ integer:
                 state_ = json_parse_state::expect_comma_or_end;
                 return;
             case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                string_buffer_.push_back(static_cast<char>(*input_ptr_));
-                ++input_ptr_;
-                ++position_;
+            {
+                const CharT* p = jsoncons::detail::skip_digits(input_ptr_ + 1, local_input_end);
+                string_buffer_.append(input_ptr_, p - input_ptr_);
+                position_ += (p - input_ptr_);
+                input_ptr_ = p;
                 goto integer;
+            }
             case '.':
                 string_buffer_.push_back(to_double_.get_decimal_point());
                 ++input_ptr_;
@@ -1962,10 +1969,13 @@ fraction2:
                 ++position_;
                 return;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                string_buffer_.push_back(static_cast<char>(*input_ptr_));
-                ++input_ptr_;
-                ++position_;
+            {
+                const CharT* p = jsoncons::detail::skip_digits(input_ptr_ + 1, local_input_end);
+                string_buffer_.append(input_ptr_, p - input_ptr_);
+                position_ += (p - input_ptr_);
+                input_ptr_ = p;
                 goto fraction2;
+            }
             case 'e':case 'E':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
@@ -2138,6 +2148,11 @@ exp3:
 string_u1:
         while (input_ptr_ < local_input_end)
         {
+            input_ptr_ = jsoncons::detail::find_string_special(input_ptr_, local_input_end);
+            if (input_ptr_ == local_input_end)
+            {
+                break;
+            }
             switch (*input_ptr_)
             {
                 JSONCONS_ILLEGAL_CONTROL_CHARACTER:
@@ -2215,6 +2230,7 @@ string_u1:
                 }
                 case '\"':
                 {
+                    // No escapes and no buffer boundary, report a view into the input
                     if (string_buffer_.length() == 0)
                     {
                         end_string_value(sb,input_ptr_-sb, visitor, ec);
@@ -2383,8 +2399,7 @@ escape_u4:
                 unicons::convert(&cp_, &cp_ + 1, std::back_inserter(string_buffer_));
                 sb = ++input_ptr_;
                 ++position_;
-                state_ = json_parse_state::string;
-                return;
+                goto string_u1;
             }
         }
 
@@ -159,6 +159,8 @@ private:
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT> char_allocator_type;
 
     static constexpr size_t default_max_buffer_length = 16384;
+    // Limit for adaptive growth of the buffer length
+    static constexpr size_t max_adaptive_buffer_length = 1048576;
 
     basic_default_json_visitor<CharT> default_visitor_;
 
@@ -170,6 +172,8 @@ private:
     bool eof_;
     bool begin_;
     std::size_t buffer_length_;
+    bool adaptive_buffer_length_;
+    std::size_t characters_read_;
     std::vector<CharT,char_allocator_type> buffer_;
 
     // Noncopyable and nonmoveable
@@ -275,6 +279,8 @@ public:
          eof_(false),
          begin_(true),
          buffer_length_(default_max_buffer_length),
+         adaptive_buffer_length_(true),
+         characters_read_(0),
          buffer_(alloc)
     {
         buffer_.reserve(buffer_length_);
@@ -292,9 +298,12 @@ public:
          eof_(false),
          begin_(false),
          buffer_length_(0),
+         adaptive_buffer_length_(false),
+         characters_read_(0),
          buffer_(alloc)
     {
         jsoncons::basic_string_view<CharT> sv(std::forward<Source>(source));
+        characters_read_ = sv.size();
         auto result = unicons::skip_bom(sv.begin(), sv.end());
         if (result.ec != unicons::encoding_errc())
         {
@@ -304,16 +313,26 @@ public:
         parser_.update(sv.data()+offset,sv.size()-offset);
     }
 
+    // The length of the next read. It starts at default_max_buffer_length and
+    // grows up to max_adaptive_buffer_length while reads fill the buffer.
     std::size_t buffer_length() const
     {
         return buffer_length_;
     }
 
+    // Fixes the length of every later read, and turns off adaptive growth
+    // for the lifetime of the reader
     void buffer_length(std::size_t length)
     {
         buffer_length_ = length;
+        adaptive_buffer_length_ = false;
         buffer_.reserve(buffer_length_);
     }
+
+    std::size_t characters_read() const
+    {
+        return characters_read_;
+    }
 #if !defined(JSONCONS_NO_DEPRECATED)
     JSONCONS_DEPRECATED_MSG("Instead, use max_nesting_depth() on options")
     int max_nesting_depth() const
@@ -473,8 +492,7 @@ public:
     JSONCONS_DEPRECATED_MSG("Instead, use buffer_length(std::size_t)")
     void buffer_capacity(std::size_t length)
     {
-        buffer_length_ = length;
-        buffer_.reserve(buffer_length_);
+        buffer_length(length);
     }
 #endif
 
@@ -482,33 +500,40 @@ private:
 
     void read_buffer(std::error_code& ec)
     {
-        buffer_.clear();
-        buffer_.resize(buffer_length_);
-        std::size_t count = source_.read(buffer_.data(), buffer_length_);
-        buffer_.resize(static_cast<std::size_t>(count));
-        if (buffer_.size() == 0)
+        auto chunk = source_reader<source_type>::read_chunk(source_, buffer_, buffer_length_);
+        characters_read_ += chunk.size();
+        // A full buffer suggests a large input, double the length of the next read
+        // to reduce the number of refills, unless the length was set by the user
+        if (adaptive_buffer_length_ && chunk.size() == buffer_length_ && buffer_length_ < max_adaptive_buffer_length)
+        {
+            buffer_length_ = (std::min)(2*buffer_length_, max_adaptive_buffer_length);
+        }
+        if (chunk.size() == 0)
         {
             eof_ = true;
         }
         else if (begin_)
         {
-            auto result = unicons::skip_bom(buffer_.begin(), buffer_.end());
+            auto result = unicons::skip_bom(chunk.begin(), chunk.end());
             if (result.ec != unicons::encoding_errc())
             {
                 ec = result.ec;
                 return;
             }
-            std::size_t offset = result.it - buffer_.begin();
-            parser_.update(buffer_.data()+offset,buffer_.size()-offset);
+            std::size_t offset = result.it - chunk.begin();
+            parser_.update(chunk.data()+offset,chunk.size()-offset);
             begin_ = false;
         }
         else
         {
-            parser_.update(buffer_.data(),buffer_.size());
+            parser_.update(chunk.data(),chunk.size());
         }
     }
 };
 
+template<class CharT,class Src,class Allocator>
+constexpr size_t basic_json_reader<CharT,Src,Allocator>::max_adaptive_buffer_length;
+
 using json_reader = basic_json_reader<char>;
 using wjson_reader = basic_json_reader<wchar_t>;
 
@@ -22,6 +22,7 @@
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/bigint.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/interned_key.hpp>
 #include <jsoncons/detail/more_type_traits.hpp>
 #include <string>
 #include <tuple>
@@ -450,6 +451,36 @@ has_can_convert = jsoncons::detail::is_detected<traits_can_convert_t, Json, T>;
         }
     };
 
+    template<class Json, typename T>
+    struct json_type_traits<Json, T, 
+                            typename std::enable_if<!is_json_type_traits_declared<T>::value && 
+                                                    is_interned_key<T>::value &&
+                                                    std::is_same<typename Json::char_type,typename T::value_type>::value>::type>
+    {
+        using allocator_type = typename Json::allocator_type;
+        using string_view_type = typename Json::string_view_type;
+
+        static bool is(const Json& j) noexcept
+        {
+            return j.is_string();
+        }
+
+        static T as(const Json& j)
+        {
+            return T(j.as_string_view());
+        }
+
+        static Json to_json(const T& val)
+        {
+            return Json(string_view_type(val.data(),val.length()), semantic_tag::none);
+        }
+
+        static Json to_json(const T& val, const allocator_type& alloc)
+        {
+            return Json(string_view_type(val.data(),val.length()), semantic_tag::none, alloc);
+        }
+    };
+
     // array back insertable
 
     template<class Json, typename T>
@@ -0,0 +1,915 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_LAZY_JSON_HPP
+#define JSONCONS_LAZY_JSON_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator> // std::forward_iterator_tag
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_error.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+
+namespace jsoncons {
+
+    template <class CharT,class Allocator>
+    class basic_lazy_json;
+
+namespace detail {
+
+    enum class tape_kind : uint8_t {null_value, true_value, false_value, string_value, number_value, array_value, object_value};
+
+    // One entry per value, and per object key, in document order. An object's
+    // entries are its keys and values, alternating.
+    struct tape_entry
+    {
+        static constexpr uint8_t escaped = 0x01; // string with escape sequences
+        static constexpr uint8_t integer = 0x02; // number without fraction or exponent
+
+        std::size_t offset; // position of the value's text, for a string just past the opening quote
+        std::size_t length; // length of the value's text, for a string excluding the quotes
+        std::size_t next; // index of the entry following the value and all its elements
+        uint32_t size; // number of elements or members of an array or object
+        tape_kind kind;
+        uint8_t flags;
+
+        tape_entry(tape_kind kind, std::size_t offset, std::size_t index)
+            : offset(offset), length(0), next(index + 1), size(0), kind(kind), flags(0)
+        {
+        }
+    };
+
+    // tape_builder: a single validating pass over the text that records the
+    // extent of each value. Structure, literals and numbers are checked here,
+    // escape sequences and UTF-8 are checked when a string is decoded.
+    template <class CharT,class TapeAllocator>
+    class tape_builder
+    {
+        const CharT* begin_;
+        const CharT* p_;
+        const CharT* end_;
+        std::vector<tape_entry,TapeAllocator>& tape_;
+        std::vector<std::size_t> stack_;
+    public:
+        tape_builder(const CharT* data, std::size_t length, std::vector<tape_entry,TapeAllocator>& tape)
+            : begin_(data), p_(data), end_(data+length), tape_(tape)
+        {
+        }
+
+        std::size_t position() const
+        {
+            return static_cast<std::size_t>(p_ - begin_);
+        }
+
+        void build(std::error_code& ec)
+        {
+            tape_.clear();
+            tape_.reserve(static_cast<std::size_t>(end_ - begin_)/8 + 1);
+            skip_whitespace();
+            if (!parse_value(ec))
+            {
+                return;
+            }
+            while (!stack_.empty())
+            {
+                tape_entry& container = tape_[stack_.back()];
+                skip_whitespace();
+                if (p_ == end_)
+                {
+                    ec = json_errc::unexpected_eof;
+                    return;
+                }
+                const CharT close = container.kind == tape_kind::array_value ? ']' : '}';
+                if (*p_ == close)
+                {
+                    ++p_;
+                    end_container(container);
+                    continue;
+                }
+                if (container.size > 0)
+                {
+                    if (*p_ != ',')
+                    {
+                        ec = container.kind == tape_kind::array_value ? json_errc::expected_comma_or_right_bracket : json_errc::expected_comma_or_right_brace;
+                        return;
+                    }
+                    ++p_;
+                    skip_whitespace();
+                }
+                else if (*p_ == ',')
+                {
+                    ec = json_errc::extra_comma;
+                    return;
+                }
+                if (container.size == (std::numeric_limits<uint32_t>::max)())
+                {
+                    ec = json_errc::source_error;
+                    return;
+                }
+                ++container.size;
+                if (container.kind == tape_kind::object_value)
+                {
+                    if (p_ == end_)
+                    {
+                        ec = json_errc::unexpected_eof;
+                        return;
+                    }
+                    if (*p_ != '\"')
+                    {
+                        ec = *p_ == close ? json_errc::extra_comma : json_errc::expected_key;
+                        return;
+                    }
+                    if (!parse_string(ec))
+                    {
+                        return;
+                    }
+                    skip_whitespace();
+                    if (p_ == end_ || *p_ != ':')
+                    {
+                        ec = p_ == end_ ? json_errc::unexpected_eof : json_errc::expected_colon;
+                        return;
+                    }
+                    ++p_;
+                    skip_whitespace();
+                }
+                else if (p_ != end_ && *p_ == close)
+                {
+                    ec = json_errc::extra_comma;
+                    return;
+                }
+                if (!parse_value(ec))
+                {
+                    return;
+                }
+            }
+            skip_whitespace();
+            if (p_ != end_)
+            {
+                ec = json_errc::extra_character;
+            }
+        }
+
+    private:
+        void skip_whitespace()
+        {
+            while (p_ != end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r'))
+            {
+                ++p_;
+            }
+        }
+
+        void end_container(tape_entry& container)
+        {
+            container.length = position() - container.offset;
+            container.next = tape_.size();
+            stack_.pop_back();
+        }
+
+        bool parse_value(std::error_code& ec)
+        {
+            if (p_ == end_)
+            {
+                ec = json_errc::unexpected_eof;
+                return false;
+            }
+            switch (*p_)
+            {
+                case '\"':
+                    return parse_string(ec);
+                case '[':
+                    tape_.emplace_back(tape_kind::array_value, position(), tape_.size());
+                    stack_.push_back(tape_.size()-1);
+                    ++p_;
+                    return true;
+                case '{':
+                    tape_.emplace_back(tape_kind::object_value, position(), tape_.size());
+                    stack_.push_back(tape_.size()-1);
+                    ++p_;
+                    return true;
+                case 't':
+                    return parse_literal("true", tape_kind::true_value, ec);
+                case 'f':
+                    return parse_literal("false", tape_kind::false_value, ec);
+                case 'n':
+                    return parse_literal("null", tape_kind::null_value, ec);
+                case ']':
+                    ec = json_errc::unexpected_right_bracket;
+                    return false;
+                case '}':
+                    ec = json_errc::unexpected_right_brace;
+                    return false;
+                case '\'':
+                    ec = json_errc::single_quote;
+                    return false;
+                default:
+                    if (*p_ == '-' || (*p_ >= '0' && *p_ <= '9'))
+                    {
+                        return parse_number(ec);
+                    }
+                    ec = json_errc::expected_value;
+                    return false;
+            }
+        }
+
+        bool parse_literal(const char* literal, tape_kind kind, std::error_code& ec)
+        {
+            const CharT* first = p_;
+            for (const char* q = literal; *q != 0; ++q, ++p_)
+            {
+                if (p_ == end_)
+                {
+                    ec = json_errc::unexpected_eof;
+                    return false;
+                }
+                if (*p_ != static_cast<CharT>(*q))
+                {
+                    ec = json_errc::invalid_value;
+                    return false;
+                }
+            }
+            tape_.emplace_back(kind, static_cast<std::size_t>(first - begin_), tape_.size());
+            tape_.back().length = static_cast<std::size_t>(p_ - first);
+            return true;
+        }
+
+        bool parse_string(std::error_code& ec)
+        {
+            ++p_;
+            tape_.emplace_back(tape_kind::string_value, position(), tape_.size());
+            tape_entry& entry = tape_.back();
+            while (true)
+            {
+                p_ = jsoncons::detail::find_string_special(p_, end_);
+                if (p_ == end_)
+                {
+                    ec = json_errc::unexpected_eof;
+                    return false;
+                }
+                if (*p_ == '\"')
+                {
+                    entry.length = position() - entry.offset;
+                    ++p_;
+                    return true;
+                }
+                if (*p_ == '\\')
+                {
+                    entry.flags |= tape_entry::escaped;
+                    if (++p_ == end_)
+                    {
+                        ec = json_errc::unexpected_eof;
+                        return false;
+                    }
+                    ++p_;
+                }
+                else
+                {
+                    ec = json_errc::illegal_control_character;
+                    return false;
+                }
+            }
+        }
+
+        bool parse_number(std::error_code& ec)
+        {
+            const CharT* first = p_;
+            bool integer = true;
+            if (*p_ == '-')
+            {
+                ++p_;
+            }
+            if (p_ == end_)
+            {
+                ec = json_errc::unexpected_eof;
+                return false;
+            }
+            if (*p_ == '0')
+            {
+                ++p_;
+                if (p_ != end_ && *p_ >= '0' && *p_ <= '9')
+                {
+                    ec = json_errc::leading_zero;
+                    return false;
+                }
+            }
+            else if (!skip_digits())
+            {
+                ec = json_errc::invalid_number;
+                return false;
+            }
+            if (p_ != end_ && *p_ == '.')
+            {
+                integer = false;
+                ++p_;
+                if (!skip_digits())
+                {
+                    ec = json_errc::invalid_number;
+                    return false;
+                }
+            }
+            if (p_ != end_ && (*p_ == 'e' || *p_ == 'E'))
+            {
+                integer = false;
+                ++p_;
+                if (p_ != end_ && (*p_ == '+' || *p_ == '-'))
+                {
+                    ++p_;
+                }
+                if (!skip_digits())
+                {
+                    ec = json_errc::invalid_number;
+                    return false;
+                }
+            }
+            tape_.emplace_back(tape_kind::number_value, static_cast<std::size_t>(first - begin_), tape_.size());
+            tape_.back().length = static_cast<std::size_t>(p_ - first);
+            if (integer)
+            {
+                tape_.back().flags |= tape_entry::integer;
+            }
+            return true;
+        }
+
+        bool skip_digits()
+        {
+            const CharT* first = p_;
+            p_ = jsoncons::detail::skip_digits(p_, end_);
+            return p_ != first;
+        }
+    };
+
+} // namespace detail
+
+    // basic_lazy_json_document: owns the text of a JSON document and a tape
+    // of the extent of each value in it. Values are decoded when accessed,
+    // through basic_lazy_json.
+
+    template <class CharT,class Allocator = std::allocator<char>>
+    class basic_lazy_json_document
+    {
+        friend class basic_lazy_json<CharT,Allocator>;
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<char_type>;
+        using string_type = std::basic_string<char_type,std::char_traits<char_type>,char_allocator_type>;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+        using value_type = basic_lazy_json<CharT,Allocator>;
+    private:
+        using tape_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<jsoncons::detail::tape_entry>;
+
+        string_type text_;
+        std::vector<jsoncons::detail::tape_entry,tape_allocator_type> tape_;
+        jsoncons::detail::to_double_t to_double_;
+    public:
+        explicit basic_lazy_json_document(const allocator_type& alloc = allocator_type())
+            : text_(char_allocator_type(alloc)), tape_(tape_allocator_type(alloc))
+        {
+        }
+
+        basic_lazy_json_document(basic_lazy_json_document&&) = default;
+        basic_lazy_json_document& operator=(basic_lazy_json_document&&) = default;
+
+        // Copies s
+        static basic_lazy_json_document parse(const string_view_type& s, const allocator_type& alloc = allocator_type())
+        {
+            basic_lazy_json_document doc(alloc);
+            doc.text_.assign(s.data(), s.size());
+            doc.build();
+            return doc;
+        }
+
+        // Takes ownership of s
+        template <class Source>
+        static typename std::enable_if<std::is_same<Source,string_type>::value,basic_lazy_json_document>::type
+        parse(Source&& s)
+        {
+            basic_lazy_json_document doc(s.get_allocator());
+            doc.text_ = std::move(s);
+            doc.build();
+            return doc;
+        }
+
+        value_type root() const
+        {
+            return value_type(this, 0);
+        }
+
+        // The number of entries in the tape, one per value and per object key
+        std::size_t tape_size() const
+        {
+            return tape_.size();
+        }
+
+        allocator_type get_allocator() const
+        {
+            return tape_.get_allocator();
+        }
+
+    private:
+        void build()
+        {
+            std::error_code ec;
+            jsoncons::detail::tape_builder<char_type,tape_allocator_type> builder(text_.data(), text_.size(), tape_);
+            builder.build(ec);
+            if (ec)
+            {
+                std::size_t line = 1;
+                std::size_t column = 1;
+                for (std::size_t i = 0; i < builder.position() && i < text_.size(); ++i)
+                {
+                    if (text_[i] == '\n')
+                    {
+                        ++line;
+                        column = 1;
+                    }
+                    else
+                    {
+                        ++column;
+                    }
+                }
+                JSONCONS_THROW(ser_error(ec, line, column));
+            }
+        }
+    };
+
+    // basic_lazy_json: a read only reference to a value in a basic_lazy_json_document,
+    // which must outlive it. Navigation uses the tape, and only the values that
+    // are converted with as<T>() are decoded.
+
+    template <class CharT,class Allocator = std::allocator<char>>
+    class basic_lazy_json
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = Allocator;
+        using document_type = basic_lazy_json_document<CharT,Allocator>;
+        using string_view_type = jsoncons::basic_string_view<char_type>;
+        using string_type = std::basic_string<char_type>;
+
+        class array_iterator;
+        class object_iterator;
+        class key_value_type;
+    private:
+        friend class basic_lazy_json_document<CharT,Allocator>;
+        using tape_entry = jsoncons::detail::tape_entry;
+        using tape_kind = jsoncons::detail::tape_kind;
+        using json_value_type = basic_json<char_type,sorted_policy,allocator_type>;
+
+        const document_type* doc_;
+        std::size_t index_;
+
+        basic_lazy_json(const document_type* doc, std::size_t index)
+            : doc_(doc), index_(index)
+        {
+        }
+
+        const tape_entry& entry() const
+        {
+            return doc_->tape_[index_];
+        }
+
+        const char_type* text() const
+        {
+            return doc_->text_.data() + entry().offset;
+        }
+    public:
+        json_type type() const
+        {
+            switch (entry().kind)
+            {
+                case tape_kind::null_value:
+                    return json_type::null_value;
+                case tape_kind::true_value:
+                case tape_kind::false_value:
+                    return json_type::bool_value;
+                case tape_kind::string_value:
+                    return json_type::string_value;
+                case tape_kind::number_value:
+                    if (!(entry().flags & tape_entry::integer))
+                    {
+                        return json_type::double_value;
+                    }
+                    return text()[0] == '-' ? json_type::int64_value : json_type::uint64_value;
+                case tape_kind::array_value:
+                    return json_type::array_value;
+                default:
+                    return json_type::object_value;
+            }
+        }
+
+        bool is_null() const noexcept
+        {
+            return entry().kind == tape_kind::null_value;
+        }
+
+        bool is_bool() const noexcept
+        {
+            return entry().kind == tape_kind::true_value || entry().kind == tape_kind::false_value;
+        }
+
+        bool is_string() const noexcept
+        {
+            return entry().kind == tape_kind::string_value;
+        }
+
+        bool is_number() const noexcept
+        {
+            return entry().kind == tape_kind::number_value;
+        }
+
+        bool is_array() const noexcept
+        {
+            return entry().kind == tape_kind::array_value;
+        }
+
+        bool is_object() const noexcept
+        {
+            return entry().kind == tape_kind::object_value;
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        // The number of elements of an array or members of an object, otherwise 0
+        std::size_t size() const noexcept
+        {
+            return entry().size;
+        }
+
+        // The text of the value in the document
+        string_view_type raw() const
+        {
+            const tape_entry& e = entry();
+            return e.kind == tape_kind::string_value ? string_view_type(text() - 1, e.length + 2) : string_view_type(text(), e.length);
+        }
+
+        bool contains(const string_view_type& key) const
+        {
+            return find_member(key) != 0;
+        }
+
+        basic_lazy_json at(const string_view_type& key) const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(not_an_object(key.data(),key.length()));
+            }
+            std::size_t i = find_member(key);
+            if (i == 0)
+            {
+                JSONCONS_THROW(key_not_found(key.data(),key.length()));
+            }
+            return basic_lazy_json(doc_, i);
+        }
+
+        basic_lazy_json at(std::size_t i) const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+            if (i >= size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            std::size_t pos = index_ + 1;
+            for (std::size_t k = 0; k < i; ++k)
+            {
+                pos = doc_->tape_[pos].next;
+            }
+            return basic_lazy_json(doc_, pos);
+        }
+
+        basic_lazy_json operator[](const string_view_type& key) const
+        {
+            return at(key);
+        }
+
+        basic_lazy_json operator[](std::size_t i) const
+        {
+            return at(i);
+        }
+
+        object_iterator find(const string_view_type& key) const
+        {
+            std::size_t i = is_object() ? find_member(key) : 0;
+            return i == 0 ? object_iterator(doc_, entry().next) : object_iterator(doc_, i - 1);
+        }
+
+        range<array_iterator,array_iterator> array_range() const
+        {
+            if (!is_array())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+            return range<array_iterator,array_iterator>(array_iterator(doc_, index_ + 1), array_iterator(doc_, entry().next));
+        }
+
+        range<object_iterator,object_iterator> object_range() const
+        {
+            if (!is_object())
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+            return range<object_iterator,object_iterator>(object_iterator(doc_, index_ + 1), object_iterator(doc_, entry().next));
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            switch (entry().kind)
+            {
+                case tape_kind::true_value:
+                    return true;
+                case tape_kind::false_value:
+                    return false;
+                default:
+                    return decode().template as<T>();
+            }
+        }
+
+        template <class T>
+        typename std::enable_if<jsoncons::detail::is_integer<T>::value && !std::is_same<T,bool>::value,T>::type
+        as() const
+        {
+            const tape_entry& e = entry();
+            if (e.kind == tape_kind::number_value && (e.flags & tape_entry::integer))
+            {
+                auto result = jsoncons::detail::to_integer_decimal<T>(text(), e.length);
+                if (result)
+                {
+                    return result.value();
+                }
+            }
+            return decode().template as<T>();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value,T>::type
+        as() const
+        {
+            const tape_entry& e = entry();
+            if (e.kind == tape_kind::number_value)
+            {
+                return static_cast<T>(doc_->to_double_(text(), e.length));
+            }
+            return decode().template as<T>();
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_same<T,string_type>::value,T>::type
+        as() const
+        {
+            const tape_entry& e = entry();
+            if (e.kind == tape_kind::string_value && !(e.flags & tape_entry::escaped))
+            {
+                validate_string(text(), e.length);
+                return T(text(), e.length);
+            }
+            return decode().template as<T>();
+        }
+
+        // Decodes the value and its elements into a basic_json
+        template <class T>
+        typename std::enable_if<jsoncons::detail::is_basic_json<T>::value,T>::type
+        as() const
+        {
+            return T::parse(raw());
+        }
+
+        // A view into the document text. A string with escape sequences has no
+        // unescaped form in the text to view, use as<string_type>() instead.
+        template <class T>
+        typename std::enable_if<jsoncons::detail::is_basic_string_view<T>::value,T>::type
+        as() const
+        {
+            static_assert(std::is_same<typename T::value_type,char_type>::value, "View must have the document's character type");
+            const tape_entry& e = entry();
+            if (e.kind != tape_kind::string_value)
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+            }
+            if (e.flags & tape_entry::escaped)
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("String has escape sequences, no view into the document text"));
+            }
+            validate_string(text(), e.length);
+            return T(text(), e.length);
+        }
+
+        template <class T>
+        typename std::enable_if<!std::is_same<T,bool>::value && !jsoncons::detail::is_integer<T>::value &&
+                                !std::is_floating_point<T>::value && !std::is_same<T,string_type>::value &&
+                                !jsoncons::detail::is_basic_json<T>::value &&
+                                !jsoncons::detail::is_basic_string_view<T>::value,T>::type
+        as() const
+        {
+            // The decoded value is a temporary, a view into it would dangle
+            static_assert(!std::is_same<T,byte_string_view>::value, "as<byte_string_view>() is not supported");
+            return decode().template as<T>();
+        }
+
+    private:
+        json_value_type decode() const
+        {
+            return json_value_type::parse(raw());
+        }
+
+        static void validate_string(const char_type* s, std::size_t length)
+        {
+            auto result = unicons::validate(s, s + length);
+            if (result.ec != unicons::conv_errc())
+            {
+                JSONCONS_THROW(ser_error(json_errc::illegal_codepoint));
+            }
+        }
+
+        static bool key_equals(const document_type* doc, const tape_entry& key_entry, const string_view_type& key)
+        {
+            const char_type* s = doc->text_.data() + key_entry.offset;
+            if (!(key_entry.flags & tape_entry::escaped))
+            {
+                return string_view_type(s, key_entry.length) == key;
+            }
+            return json_value_type::parse(string_view_type(s - 1, key_entry.length + 2)).as_string_view() == key;
+        }
+
+        // Returns the tape index of the value of the member named key, or 0
+        std::size_t find_member(const string_view_type& key) const
+        {
+            const std::size_t last = entry().next;
+            std::size_t pos = index_ + 1;
+            while (pos < last)
+            {
+                if (key_equals(doc_, doc_->tape_[pos], key))
+                {
+                    return pos + 1;
+                }
+                pos = doc_->tape_[pos + 1].next;
+            }
+            return 0;
+        }
+
+    public:
+        class array_iterator
+        {
+            friend class basic_lazy_json;
+            const document_type* doc_;
+            std::size_t pos_;
+
+            array_iterator(const document_type* doc, std::size_t pos)
+                : doc_(doc), pos_(pos)
+            {
+            }
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = basic_lazy_json;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const basic_lazy_json*;
+            using reference = basic_lazy_json;
+
+            array_iterator()
+                : doc_(nullptr), pos_(0)
+            {
+            }
+
+            basic_lazy_json operator*() const
+            {
+                return basic_lazy_json(doc_, pos_);
+            }
+
+            array_iterator& operator++()
+            {
+                pos_ = doc_->tape_[pos_].next;
+                return *this;
+            }
+
+            array_iterator operator++(int)
+            {
+                array_iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+
+            friend bool operator==(const array_iterator& lhs, const array_iterator& rhs)
+            {
+                return lhs.pos_ == rhs.pos_;
+            }
+
+            friend bool operator!=(const array_iterator& lhs, const array_iterator& rhs)
+            {
+                return lhs.pos_ != rhs.pos_;
+            }
+        };
+
+        class key_value_type
+        {
+            friend class basic_lazy_json::object_iterator;
+            const document_type* doc_;
+            std::size_t pos_; // the key's entry, the value's follows
+        public:
+            key_value_type()
+                : doc_(nullptr), pos_(0)
+            {
+            }
+
+            key_value_type(const document_type* doc, std::size_t pos)
+                : doc_(doc), pos_(pos)
+            {
+            }
+
+            string_type key() const
+            {
+                return basic_lazy_json(doc_, pos_).template as<string_type>();
+            }
+
+            basic_lazy_json value() const
+            {
+                return basic_lazy_json(doc_, pos_ + 1);
+            }
+        };
+
+        class object_iterator
+        {
+            friend class basic_lazy_json;
+            key_value_type kv_;
+
+            object_iterator(const document_type* doc, std::size_t pos)
+                : kv_(doc, pos)
+            {
+            }
+
+            std::size_t pos() const
+            {
+                return kv_.pos_;
+            }
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = key_value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const key_value_type*;
+            using reference = const key_value_type&;
+
+            object_iterator() = default;
+
+            reference operator*() const
+            {
+                return kv_;
+            }
+
+            pointer operator->() const
+            {
+                return &kv_;
+            }
+
+            object_iterator& operator++()
+            {
+                kv_.pos_ = kv_.doc_->tape_[kv_.pos_ + 1].next;
+                return *this;
+            }
+
+            object_iterator operator++(int)
+            {
+                object_iterator temp(*this);
+                ++*this;
+                return temp;
+            }
+
+            friend bool operator==(const object_iterator& lhs, const object_iterator& rhs)
+            {
+                return lhs.pos() == rhs.pos();
+            }
+
+            friend bool operator!=(const object_iterator& lhs, const object_iterator& rhs)
+            {
+                return lhs.pos() != rhs.pos();
+            }
+        };
+    };
+
+    using lazy_json_document = basic_lazy_json_document<char>;
+    using wlazy_json_document = basic_lazy_json_document<wchar_t>;
+    using lazy_json = basic_lazy_json<char>;
+    using wlazy_json = basic_lazy_json<wchar_t>;
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,382 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MMAP_SOURCE_HPP
+#define JSONCONS_MMAP_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <cerrno>
+#include <limits> // std::numeric_limits
+#include <algorithm> // std::min
+#include <string>
+#include <system_error>
+#include <utility> // std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+#if defined(_WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+    enum class mmap_access_hint : uint8_t {normal, sequential, random};
+
+    // mmap_source: a read-only memory mapping of a file, or of a window
+    // [offset, offset+length) of it. Being contiguous, it is handed to the
+    // text parsers in place, without copying through an intermediate buffer.
+    // On 32-bit POSIX platforms, offsets beyond 2GB require _FILE_OFFSET_BITS=64.
+
+    template <class CharT>
+    class mmap_source
+    {
+    public:
+        using value_type = CharT;
+        static constexpr std::size_t npos = (std::numeric_limits<std::size_t>::max)();
+    private:
+        void* map_;
+        std::size_t map_length_;
+        const value_type* data_;
+        const value_type* current_;
+        const value_type* end_;
+        std::error_code ec_;
+
+        // Noncopyable
+        mmap_source(const mmap_source&) = delete;
+        mmap_source& operator=(const mmap_source&) = delete;
+    public:
+        mmap_source()
+            : map_(nullptr), map_length_(0), data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+        }
+
+        explicit mmap_source(const std::string& path,
+                             mmap_access_hint hint = mmap_access_hint::sequential)
+            : mmap_source(path, 0, npos, hint)
+        {
+        }
+
+        mmap_source(const std::string& path,
+                    uint64_t offset,
+                    std::size_t length,
+                    mmap_access_hint hint = mmap_access_hint::sequential)
+            : map_(nullptr), map_length_(0), data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+            map_file(path, offset, length, hint);
+        }
+
+        mmap_source(mmap_source&& other) noexcept
+            : map_(nullptr), map_length_(0), data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+            swap(other);
+        }
+
+        ~mmap_source() noexcept
+        {
+            unmap();
+        }
+
+        mmap_source& operator=(mmap_source&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(mmap_source& other) noexcept
+        {
+            std::swap(map_, other.map_);
+            std::swap(map_length_, other.map_length_);
+            std::swap(data_, other.data_);
+            std::swap(current_, other.current_);
+            std::swap(end_, other.end_);
+            std::swap(ec_, other.ec_);
+        }
+
+        std::error_code error_code() const
+        {
+            return ec_;
+        }
+
+        const value_type* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return end_ - data_;
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;
+        }
+
+        bool is_error() const
+        {
+            return ec_ ? true : false;
+        }
+
+        std::size_t position() const
+        {
+            return (current_ - data_) + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (current_ < end_)
+            {
+                return character_result<value_type>(*current_++);
+            }
+            else
+            {
+                return character_result<value_type>();
+            }
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len = (std::min)(static_cast<std::size_t>(end_ - current_), count);
+            current_ += len;
+        }
+
+        character_result<value_type> peek_character()
+        {
+            return current_ < end_ ? character_result<value_type>(*current_) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len = (std::min)(static_cast<std::size_t>(end_ - current_), length);
+            std::memcpy(p, current_, len*sizeof(value_type));
+            current_ += len;
+            return len;
+        }
+
+        span<const value_type> read_span(std::size_t length)
+        {
+            std::size_t len = (std::min)(static_cast<std::size_t>(end_ - current_), length);
+            span<const value_type> s(current_, len);
+            current_ += len;
+            return s;
+        }
+
+    private:
+        void set_view(const char* p, std::size_t length)
+        {
+            data_ = reinterpret_cast<const value_type*>(p);
+            current_ = data_;
+            end_ = data_ + length/sizeof(value_type);
+        }
+
+#if defined(_WIN32)
+        void map_file(const std::string& path, uint64_t offset, std::size_t length, mmap_access_hint hint)
+        {
+            DWORD flags = FILE_ATTRIBUTE_NORMAL;
+            if (hint == mmap_access_hint::sequential)
+            {
+                flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+            }
+            else if (hint == mmap_access_hint::random)
+            {
+                flags |= FILE_FLAG_RANDOM_ACCESS;
+            }
+            HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                ec_ = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                return;
+            }
+            LARGE_INTEGER file_size;
+            if (!::GetFileSizeEx(file, &file_size))
+            {
+                ec_ = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                ::CloseHandle(file);
+                return;
+            }
+            std::size_t delta = 0;
+            if (!window(static_cast<uint64_t>(file_size.QuadPart), offset, length, allocation_granularity(), delta))
+            {
+                ::CloseHandle(file);
+                return;
+            }
+            if (length == 0)
+            {
+                ::CloseHandle(file);
+                return;
+            }
+            HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr)
+            {
+                ec_ = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                ::CloseHandle(file);
+                return;
+            }
+            uint64_t aligned = offset - delta;
+            map_length_ = length + delta;
+            // The view keeps the mapping alive after the handles are closed
+            map_ = ::MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(aligned >> 32), static_cast<DWORD>(aligned & 0xffffffff), map_length_);
+            if (map_ == nullptr)
+            {
+                ec_ = std::error_code(static_cast<int>(::GetLastError()), std::system_category());
+                map_length_ = 0;
+            }
+            ::CloseHandle(mapping);
+            ::CloseHandle(file);
+            if (map_ != nullptr)
+            {
+                set_view(static_cast<const char*>(map_) + delta, length);
+            }
+        }
+
+        static uint64_t allocation_granularity()
+        {
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            return info.dwAllocationGranularity;
+        }
+
+        void unmap() noexcept
+        {
+            if (map_ != nullptr)
+            {
+                ::UnmapViewOfFile(map_);
+                map_ = nullptr;
+            }
+        }
+#else
+        void map_file(const std::string& path, uint64_t offset, std::size_t length, mmap_access_hint hint)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                ec_ = std::error_code(errno, std::system_category());
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ec_ = std::error_code(errno, std::system_category());
+                ::close(fd);
+                return;
+            }
+            std::size_t delta = 0;
+            if (!window(static_cast<uint64_t>(st.st_size), offset, length, static_cast<uint64_t>(::sysconf(_SC_PAGESIZE)), delta))
+            {
+                ::close(fd);
+                return;
+            }
+            uint64_t aligned = offset - delta;
+            if (aligned > static_cast<uint64_t>((std::numeric_limits<off_t>::max)()))
+            {
+                ec_ = std::make_error_code(std::errc::value_too_large);
+                ::close(fd);
+                return;
+            }
+            if (length == 0)
+            {
+                ::close(fd);
+                return;
+            }
+            map_length_ = length + delta;
+#if defined(POSIX_FADV_SEQUENTIAL)
+            // Widens the kernel's read-ahead for the window and starts reading
+            // it in the background, so the parser seldom waits on page faults
+            switch (hint)
+            {
+                case mmap_access_hint::sequential:
+                    ::posix_fadvise(fd, static_cast<off_t>(aligned), static_cast<off_t>(map_length_), POSIX_FADV_SEQUENTIAL);
+                    ::posix_fadvise(fd, static_cast<off_t>(aligned), static_cast<off_t>(map_length_), POSIX_FADV_WILLNEED);
+                    break;
+                case mmap_access_hint::random:
+                    ::posix_fadvise(fd, static_cast<off_t>(aligned), static_cast<off_t>(map_length_), POSIX_FADV_RANDOM);
+                    break;
+                default:
+                    break;
+            }
+#endif
+            void* p = ::mmap(nullptr, map_length_, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(aligned));
+            if (p == MAP_FAILED)
+            {
+                ec_ = std::error_code(errno, std::system_category());
+                map_length_ = 0;
+                ::close(fd);
+                return;
+            }
+            // The mapping stays valid after the descriptor is closed
+            ::close(fd);
+            map_ = p;
+
+            switch (hint)
+            {
+                case mmap_access_hint::sequential:
+                    ::posix_madvise(map_, map_length_, POSIX_MADV_SEQUENTIAL);
+                    break;
+                case mmap_access_hint::random:
+                    ::posix_madvise(map_, map_length_, POSIX_MADV_RANDOM);
+                    break;
+                default:
+                    break;
+            }
+            set_view(static_cast<const char*>(map_) + delta, length);
+        }
+
+        void unmap() noexcept
+        {
+            if (map_ != nullptr)
+            {
+                ::munmap(map_, map_length_);
+                map_ = nullptr;
+            }
+        }
+#endif
+
+        // Clamps length to the end of the file and computes the distance of
+        // offset from the preceding boundary the mapping must start at
+        bool window(uint64_t file_size, uint64_t offset, std::size_t& length, uint64_t alignment, std::size_t& delta)
+        {
+            if (offset > file_size)
+            {
+                ec_ = std::make_error_code(std::errc::invalid_argument);
+                return false;
+            }
+            uint64_t available = file_size - offset;
+            if (static_cast<uint64_t>(length) > available)
+            {
+                length = static_cast<std::size_t>(available);
+            }
+            if (available > static_cast<uint64_t>((std::numeric_limits<std::size_t>::max)()) && length == npos)
+            {
+                ec_ = std::make_error_code(std::errc::value_too_large);
+                return false;
+            }
+            delta = static_cast<std::size_t>(offset % alignment);
+            return true;
+        }
+    };
+
+    template <class CharT>
+    constexpr std::size_t mmap_source<CharT>::npos;
+
+    using binary_mmap_source = mmap_source<uint8_t>;
+
+} // namespace jsoncons
+
+#endif
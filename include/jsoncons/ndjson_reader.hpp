@@ -0,0 +1,557 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_NDJSON_READER_HPP
+#define JSONCONS_NDJSON_READER_HPP
+
+#include <algorithm> // std::count
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception> // std::exception_ptr
+#include <functional>
+#include <memory> // std::unique_ptr
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/decode_traits.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/unicode_traits.hpp>
+
+namespace jsoncons {
+
+    template <class CharT>
+    class basic_ndjson_options
+    {
+        std::size_t max_threads_;
+        std::size_t batch_length_;
+        bool ordered_;
+    public:
+        basic_ndjson_options()
+            : max_threads_(0), batch_length_(1048576), ordered_(true)
+        {
+        }
+
+        std::size_t max_threads() const
+        {
+            return max_threads_;
+        }
+
+        // 0 means std::thread::hardware_concurrency()
+        basic_ndjson_options& max_threads(std::size_t value)
+        {
+            max_threads_ = value;
+            return *this;
+        }
+
+        std::size_t batch_length() const
+        {
+            return batch_length_;
+        }
+
+        // Number of characters read from the source per batch of records
+        basic_ndjson_options& batch_length(std::size_t value)
+        {
+            batch_length_ = value;
+            return *this;
+        }
+
+        bool ordered() const
+        {
+            return ordered_;
+        }
+
+        // If false, batches are delivered as soon as they are decoded
+        basic_ndjson_options& ordered(bool value)
+        {
+            ordered_ = value;
+            return *this;
+        }
+    };
+
+    using ndjson_options = basic_ndjson_options<char>;
+    using wndjson_options = basic_ndjson_options<wchar_t>;
+
+namespace detail {
+
+    // A run of complete lines and the records decoded from them
+
+    template <class T, class CharT>
+    struct ndjson_batch
+    {
+        std::basic_string<CharT> text;
+        std::size_t first_line;
+        std::vector<T> values;
+        std::vector<std::size_t> lines;
+        std::error_code ec;
+        std::size_t error_line;
+        std::size_t error_column;
+        std::exception_ptr exception;
+        bool done;
+
+        ndjson_batch()
+            : first_line(1), error_line(0), error_column(0), done(false)
+        {
+        }
+    };
+
+    // Decodes one record, a basic_json through basic_json_parser and json_decoder,
+    // any other type through decode_traits
+
+    template <class T, class CharT, class Enable = void>
+    class ndjson_record_decoder
+    {
+        basic_json_decode_options<CharT> options_;
+        std::function<bool(json_errc,const ser_context&)> err_handler_;
+        json_decoder<basic_json<CharT>> decoder_;
+    public:
+        ndjson_record_decoder(const basic_json_decode_options<CharT>& options,
+                              std::function<bool(json_errc,const ser_context&)> err_handler)
+            : options_(options), err_handler_(err_handler)
+        {
+        }
+
+        void decode(const CharT* data, std::size_t length, std::vector<T>& values,
+                    std::error_code& ec, std::size_t& line, std::size_t& column)
+        {
+            basic_json_cursor<CharT> cursor(jsoncons::basic_string_view<CharT>(data, length), options_, err_handler_, ec);
+            if (!ec)
+            {
+                T val = decode_traits<T,CharT>::decode(cursor, decoder_, ec);
+                if (!ec)
+                {
+                    cursor.check_done(ec);
+                }
+                if (!ec)
+                {
+                    values.push_back(std::move(val));
+                }
+            }
+            if (ec)
+            {
+                line = cursor.context().line();
+                column = cursor.context().column();
+            }
+        }
+    };
+
+    template <class T, class CharT>
+    class ndjson_record_decoder<T,CharT,typename std::enable_if<is_basic_json<T>::value>::type>
+    {
+        basic_json_parser<CharT> parser_;
+        json_decoder<T> decoder_;
+    public:
+        ndjson_record_decoder(const basic_json_decode_options<CharT>& options,
+                              std::function<bool(json_errc,const ser_context&)> err_handler)
+            : parser_(options, err_handler)
+        {
+        }
+
+        void decode(const CharT* data, std::size_t length, std::vector<T>& values,
+                    std::error_code& ec, std::size_t& line, std::size_t& column)
+        {
+            parser_.reset();
+            decoder_.reset();
+            parser_.update(data, length);
+            parser_.parse_some(decoder_, ec);
+            if (!ec)
+            {
+                parser_.finish_parse(decoder_, ec);
+            }
+            if (!ec)
+            {
+                parser_.check_done(ec);
+            }
+            if (!ec && !decoder_.is_valid())
+            {
+                ec = convert_errc::conversion_failed;
+            }
+            if (ec)
+            {
+                line = parser_.line();
+                column = parser_.column();
+                return;
+            }
+            values.push_back(decoder_.get_result());
+        }
+    };
+
+    // Decodes the records in a batch, one per line, skipping blank lines and
+    // stopping at the first error
+
+    template <class T, class CharT, class RecordDecoder>
+    void decode_ndjson_batch(ndjson_batch<T,CharT>& batch, RecordDecoder& record_decoder)
+    {
+        const CharT* p = batch.text.data();
+        const CharT* end = p + batch.text.size();
+        std::size_t line = batch.first_line;
+
+        while (p < end)
+        {
+            const CharT* eol = std::char_traits<CharT>::find(p, end - p, '\n');
+            const CharT* next = eol ? eol + 1 : end;
+            const CharT* last = eol ? eol : end;
+            if (last > p && *(last-1) == '\r')
+            {
+                --last;
+            }
+            const CharT* first = p;
+            while (first < last && (*first == ' ' || *first == '\t' || *first == '\r'))
+            {
+                ++first;
+            }
+            if (first < last)
+            {
+                std::size_t record_line = 0;
+                std::size_t record_column = 0;
+                JSONCONS_TRY
+                {
+                    record_decoder.decode(p, last - p, batch.values, batch.ec, record_line, record_column);
+                }
+                JSONCONS_CATCH(const ser_error& e)
+                {
+                    batch.ec = e.code();
+                    record_line = e.line();
+                    record_column = e.column();
+                }
+                JSONCONS_CATCH(...)
+                {
+                    batch.exception = std::current_exception();
+                    return;
+                }
+                if (batch.ec)
+                {
+                    batch.error_line = line + (record_line > 0 ? record_line - 1 : 0);
+                    batch.error_column = record_column;
+                    return;
+                }
+                batch.lines.push_back(line);
+            }
+            p = next;
+            ++line;
+        }
+    }
+
+} // namespace detail
+
+    // basic_ndjson_reader: reads newline-delimited JSON, one JSON text per line.
+    // The calling thread splits the input into batches of complete lines, worker
+    // threads decode the batches, and the records are passed to a consumer on
+    // the calling thread, in input order or, if the ordered option is false, a
+    // batch at a time as batches complete. The err_handler is called from the
+    // worker threads.
+
+    template <class CharT,class Src=jsoncons::stream_source<CharT>>
+    class basic_ndjson_reader
+    {
+    public:
+        using char_type = CharT;
+        using source_type = Src;
+    private:
+        source_type source_;
+        basic_ndjson_options<CharT> ndjson_options_;
+        basic_json_decode_options<CharT> options_;
+        std::function<bool(json_errc,const ser_context&)> err_handler_;
+        std::basic_string<CharT> carry_;
+        std::size_t next_line_;
+        std::size_t line_;
+        std::size_t column_;
+        bool begin_;
+
+        // Noncopyable and nonmoveable
+        basic_ndjson_reader(const basic_ndjson_reader&) = delete;
+        basic_ndjson_reader& operator=(const basic_ndjson_reader&) = delete;
+
+        template <class Batch>
+        struct work_queue
+        {
+            std::mutex mutex;
+            std::condition_variable work_available;
+            std::condition_variable work_done;
+            std::deque<Batch*> pending;
+            bool stop = false;
+        };
+
+        // Joins the workers however read leaves, including by a consumer exception
+        template <class Batch>
+        class worker_pool
+        {
+            work_queue<Batch>& queue_;
+            std::vector<std::thread> threads_;
+        public:
+            worker_pool(work_queue<Batch>& queue)
+                : queue_(queue)
+            {
+            }
+
+            ~worker_pool() noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> lock(queue_.mutex);
+                    queue_.stop = true;
+                }
+                queue_.work_available.notify_all();
+                for (auto& t : threads_)
+                {
+                    t.join();
+                }
+            }
+
+            template <class F>
+            void start(F f)
+            {
+                threads_.emplace_back(f);
+            }
+        };
+    public:
+        template <class Source>
+        explicit basic_ndjson_reader(Source&& source,
+                                     const basic_ndjson_options<CharT>& ndjson_options = basic_ndjson_options<CharT>(),
+                                     const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                                     std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
+            : source_(std::forward<Source>(source)),
+              ndjson_options_(ndjson_options),
+              options_(options),
+              err_handler_(err_handler),
+              next_line_(1),
+              line_(0),
+              column_(0),
+              begin_(true)
+        {
+        }
+
+        // Line and column of the last error
+        std::size_t line() const
+        {
+            return line_;
+        }
+
+        std::size_t column() const
+        {
+            return column_;
+        }
+
+        // Calls f(T&& value, std::size_t line) for each record
+        template <class T, class Consumer>
+        void read(Consumer f)
+        {
+            std::error_code ec;
+            read<T>(f, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec, line_, column_));
+            }
+        }
+
+        template <class T, class Consumer>
+        void read(Consumer f, std::error_code& ec)
+        {
+            using batch_type = jsoncons::detail::ndjson_batch<T,CharT>;
+            using record_decoder_type = jsoncons::detail::ndjson_record_decoder<T,CharT>;
+
+            std::size_t num_threads = ndjson_options_.max_threads() != 0 ? ndjson_options_.max_threads() : std::thread::hardware_concurrency();
+            if (num_threads <= 1)
+            {
+                record_decoder_type record_decoder(options_, err_handler_);
+                batch_type batch;
+                while (fill_batch(batch, ec))
+                {
+                    jsoncons::detail::decode_ndjson_batch(batch, record_decoder);
+                    if (!deliver(batch, f, ec))
+                    {
+                        return;
+                    }
+                }
+                return;
+            }
+
+            const std::size_t max_in_flight = 2*num_threads;
+            const bool ordered = ndjson_options_.ordered();
+            work_queue<batch_type> queue;
+            std::deque<std::unique_ptr<batch_type>> in_flight;
+
+            worker_pool<batch_type> pool(queue);
+            for (std::size_t i = 0; i < num_threads; ++i)
+            {
+                pool.start([this,&queue]()
+                {
+                    record_decoder_type record_decoder(options_, err_handler_);
+                    for (;;)
+                    {
+                        batch_type* batch;
+                        {
+                            std::unique_lock<std::mutex> lock(queue.mutex);
+                            queue.work_available.wait(lock, [&queue]{return queue.stop || !queue.pending.empty();});
+                            if (queue.stop)
+                            {
+                                return;
+                            }
+                            batch = queue.pending.front();
+                            queue.pending.pop_front();
+                        }
+                        jsoncons::detail::decode_ndjson_batch(*batch, record_decoder);
+                        {
+                            std::lock_guard<std::mutex> lock(queue.mutex);
+                            batch->done = true;
+                        }
+                        queue.work_done.notify_one();
+                    }
+                });
+            }
+
+            bool exhausted = false;
+            for (;;)
+            {
+                while (!exhausted && in_flight.size() < max_in_flight)
+                {
+                    std::unique_ptr<batch_type> batch(new batch_type());
+                    if (!fill_batch(*batch, ec))
+                    {
+                        exhausted = true;
+                        if (ec)
+                        {
+                            return;
+                        }
+                        break;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(queue.mutex);
+                        queue.pending.push_back(batch.get());
+                    }
+                    queue.work_available.notify_one();
+                    in_flight.push_back(std::move(batch));
+                }
+                if (in_flight.empty())
+                {
+                    return;
+                }
+
+                std::unique_ptr<batch_type> batch;
+                {
+                    std::unique_lock<std::mutex> lock(queue.mutex);
+                    if (ordered)
+                    {
+                        queue.work_done.wait(lock, [&in_flight]{return in_flight.front()->done;});
+                        batch = std::move(in_flight.front());
+                        in_flight.pop_front();
+                    }
+                    else
+                    {
+                        auto it = in_flight.end();
+                        queue.work_done.wait(lock, [&in_flight,&it]
+                        {
+                            it = std::find_if(in_flight.begin(), in_flight.end(),
+                                              [](const std::unique_ptr<batch_type>& b){return b->done;});
+                            return it != in_flight.end();
+                        });
+                        batch = std::move(*it);
+                        in_flight.erase(it);
+                    }
+                }
+                if (!deliver(*batch, f, ec))
+                {
+                    return;
+                }
+            }
+        }
+
+    private:
+        // Reads complete lines into batch.text, returns false at the end of input
+        template <class Batch>
+        bool fill_batch(Batch& batch, std::error_code& ec)
+        {
+            batch.text.swap(carry_);
+            carry_.clear();
+            batch.values.clear();
+            batch.lines.clear();
+            batch.first_line = next_line_;
+
+            const std::size_t batch_length = ndjson_options_.batch_length() > 0 ? ndjson_options_.batch_length() : 1;
+            for (;;)
+            {
+                std::size_t old_size = batch.text.size();
+                batch.text.resize(old_size + batch_length);
+                std::size_t n = source_.read(&batch.text[old_size], batch_length);
+                batch.text.resize(old_size + n);
+                if (source_.is_error())
+                {
+                    ec = json_errc::source_error;
+                    line_ = next_line_;
+                    column_ = 1;
+                    return false;
+                }
+                if (begin_ && !batch.text.empty())
+                {
+                    auto result = unicons::skip_bom(batch.text.begin(), batch.text.end());
+                    if (result.ec != unicons::encoding_errc())
+                    {
+                        ec = result.ec;
+                        line_ = 1;
+                        column_ = 1;
+                        return false;
+                    }
+                    batch.text.erase(batch.text.begin(), result.it);
+                    begin_ = false;
+                }
+                if (n == 0)
+                {
+                    break;
+                }
+                const CharT* first = batch.text.data() + old_size;
+                const CharT* last = batch.text.data() + batch.text.size();
+                const CharT* eol = last;
+                while (eol != first && *(eol-1) != '\n')
+                {
+                    --eol;
+                }
+                if (eol != first)
+                {
+                    std::size_t pos = eol - batch.text.data();
+                    carry_.assign(eol, last);
+                    batch.text.resize(pos);
+                    break;
+                }
+                // A record longer than batch_length, keep reading
+            }
+            next_line_ += std::count(batch.text.begin(), batch.text.end(), '\n');
+            return !batch.text.empty();
+        }
+
+        template <class Batch, class Consumer>
+        bool deliver(Batch& batch, Consumer& f, std::error_code& ec)
+        {
+            for (std::size_t i = 0; i < batch.values.size(); ++i)
+            {
+                f(std::move(batch.values[i]), batch.lines[i]);
+            }
+            if (batch.exception)
+            {
+                std::rethrow_exception(batch.exception);
+            }
+            if (batch.ec)
+            {
+                ec = batch.ec;
+                line_ = batch.error_line;
+                column_ = batch.error_column;
+                return false;
+            }
+            return true;
+        }
+    };
+
+    using ndjson_reader = basic_ndjson_reader<char>;
+    using wndjson_reader = basic_ndjson_reader<wchar_t>;
+
+} // namespace jsoncons
+
+#endif
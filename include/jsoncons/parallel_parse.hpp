@@ -0,0 +1,715 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PARALLEL_PARSE_HPP
+#define JSONCONS_PARALLEL_PARSE_HPP
+
+#include <algorithm> // std::min, std::max
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+
+namespace jsoncons {
+
+    template <class CharT>
+    class basic_parallel_parse_options
+    {
+        std::size_t max_threads_;
+        std::size_t min_chunk_length_;
+        std::basic_string<CharT> array_location_;
+    public:
+        basic_parallel_parse_options()
+            : max_threads_(0), min_chunk_length_(1048576)
+        {
+        }
+
+        std::size_t max_threads() const
+        {
+            return max_threads_;
+        }
+
+        // 0 means std::thread::hardware_concurrency()
+        basic_parallel_parse_options& max_threads(std::size_t value)
+        {
+            max_threads_ = value;
+            return *this;
+        }
+
+        std::size_t min_chunk_length() const
+        {
+            return min_chunk_length_;
+        }
+
+        basic_parallel_parse_options& min_chunk_length(std::size_t value)
+        {
+            min_chunk_length_ = value;
+            return *this;
+        }
+
+        const std::basic_string<CharT>& array_location() const
+        {
+            return array_location_;
+        }
+
+        // A JSON Pointer to the array to parse in parallel, the empty string
+        // (the default) selects the root
+        basic_parallel_parse_options& array_location(const std::basic_string<CharT>& value)
+        {
+            array_location_ = value;
+            return *this;
+        }
+    };
+
+    using parallel_parse_options = basic_parallel_parse_options<char>;
+    using wparallel_parse_options = basic_parallel_parse_options<wchar_t>;
+
+namespace detail {
+
+    // Joins the worker threads however parse_array_parallel leaves. If
+    // starting a thread throws, the workers already running are told to stop
+    // and joined, rather than destroyed joinable, which would terminate.
+    class worker_threads
+    {
+        std::atomic<bool>& stop_;
+        std::vector<std::thread> threads_;
+    public:
+        explicit worker_threads(std::atomic<bool>& stop)
+            : stop_(stop)
+        {
+        }
+
+        worker_threads(const worker_threads&) = delete;
+        worker_threads& operator=(const worker_threads&) = delete;
+
+        ~worker_threads() noexcept
+        {
+            if (!threads_.empty())
+            {
+                stop_ = true;
+                join();
+            }
+        }
+
+        template <class F>
+        void start(F f)
+        {
+            threads_.emplace_back(f);
+        }
+
+        void join()
+        {
+            for (auto& t : threads_)
+            {
+                t.join();
+            }
+            threads_.clear();
+        }
+    };
+
+    // structural_scanner: finds the extent of JSON values without validating
+    // them. Anything it accepts is later parsed by basic_json_parser, so a
+    // malformed input is never accepted, only reported later. Comments are
+    // skipped like whitespace, as the parser accepts them by default.
+
+    template <class CharT>
+    class structural_scanner
+    {
+        const CharT* p_;
+        const CharT* end_;
+    public:
+        structural_scanner(const CharT* first, const CharT* last)
+            : p_(first), end_(last)
+        {
+        }
+
+        const CharT* current() const
+        {
+            return p_;
+        }
+
+        bool done() const
+        {
+            return p_ == end_;
+        }
+
+        CharT peek() const
+        {
+            return *p_;
+        }
+
+        void advance()
+        {
+            ++p_;
+        }
+
+        // Whitespace only, as after the root value, where the parser does not
+        // accept comments
+        void skip_spaces()
+        {
+            while (p_ != end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r'))
+            {
+                ++p_;
+            }
+        }
+
+        void skip_whitespace()
+        {
+            while (p_ != end_)
+            {
+                switch (*p_)
+                {
+                    case ' ': case '\t': case '\n': case '\r':
+                        ++p_;
+                        break;
+                    case '/':
+                        if (!skip_comment())
+                        {
+                            return;
+                        }
+                        break;
+                    default:
+                        return;
+                }
+            }
+        }
+
+        // Precondition: *p_ == '/'. Moves past a /*...*/ or //... comment, 
+        // or stays put if there is no complete comment here.
+        bool skip_comment()
+        {
+            const CharT* p = p_ + 1;
+            if (p == end_)
+            {
+                return false;
+            }
+            if (*p == '*')
+            {
+                for (++p; p != end_ && p + 1 != end_; ++p)
+                {
+                    if (*p == '*' && *(p + 1) == '/')
+                    {
+                        p_ = p + 2;
+                        return true;
+                    }
+                }
+                return false;
+            }
+            if (*p == '/')
+            {
+                while (p != end_ && *p != '\n')
+                {
+                    ++p;
+                }
+                p_ = p;
+                return true;
+            }
+            return false;
+        }
+
+        // Precondition: *p_ == '"'. Moves past the closing quote.
+        bool skip_string()
+        {
+            ++p_;
+            while (p_ != end_)
+            {
+                p_ = jsoncons::detail::find_string_special(p_, end_);
+                if (p_ == end_)
+                {
+                    return false;
+                }
+                if (*p_ == '\"')
+                {
+                    ++p_;
+                    return true;
+                }
+                if (*p_ == '\\')
+                {
+                    if (++p_ == end_)
+                    {
+                        return false;
+                    }
+                }
+                ++p_;
+            }
+            return false;
+        }
+
+        bool skip_value()
+        {
+            if (p_ == end_)
+            {
+                return false;
+            }
+            switch (*p_)
+            {
+                case '\"':
+                    return skip_string();
+                case '[':
+                case '{':
+                {
+                    std::size_t depth = 0;
+                    while (p_ != end_)
+                    {
+                        switch (*p_)
+                        {
+                            case '\"':
+                                if (!skip_string())
+                                {
+                                    return false;
+                                }
+                                continue;
+                            case '/':
+                                if (!skip_comment())
+                                {
+                                    return false;
+                                }
+                                continue;
+                            case '[':
+                            case '{':
+                                ++depth;
+                                break;
+                            case ']':
+                            case '}':
+                                if (--depth == 0)
+                                {
+                                    ++p_;
+                                    return true;
+                                }
+                                break;
+                            default:
+                                break;
+                        }
+                        ++p_;
+                    }
+                    return false;
+                }
+                case ',': case ']': case '}': case ':': case '/':
+                    return false;
+                default:
+                {
+                    const CharT* first = p_;
+                    while (p_ != end_ && !(*p_ == ',' || *p_ == ']' || *p_ == '}' || *p_ == '/' || *p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r'))
+                    {
+                        ++p_;
+                    }
+                    return p_ != first;
+                }
+            }
+        }
+    };
+
+    // Splits a JSON Pointer into unescaped reference tokens
+    template <class CharT>
+    bool split_json_pointer(const std::basic_string<CharT>& location, std::vector<std::basic_string<CharT>>& tokens)
+    {
+        if (location.empty())
+        {
+            return true;
+        }
+        if (location[0] != '/')
+        {
+            return false;
+        }
+        std::basic_string<CharT> token;
+        for (std::size_t i = 1; i < location.size(); ++i)
+        {
+            CharT c = location[i];
+            if (c == '/')
+            {
+                tokens.push_back(token);
+                token.clear();
+            }
+            else if (c == '~')
+            {
+                if (++i == location.size())
+                {
+                    return false;
+                }
+                if (location[i] == '0')
+                {
+                    token.push_back('~');
+                }
+                else if (location[i] == '1')
+                {
+                    token.push_back('/');
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                token.push_back(c);
+            }
+        }
+        tokens.push_back(token);
+        return true;
+    }
+
+    // Positions scanner at the value the tokens refer to
+    template <class Json>
+    bool scan_to_location(structural_scanner<typename Json::char_type>& scanner,
+                          const std::vector<std::basic_string<typename Json::char_type>>& tokens)
+    {
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+
+        for (const auto& token : tokens)
+        {
+            scanner.skip_whitespace();
+            if (scanner.done())
+            {
+                return false;
+            }
+            if (scanner.peek() == '{')
+            {
+                scanner.advance();
+                bool found = false;
+                while (!found)
+                {
+                    scanner.skip_whitespace();
+                    if (scanner.done() || scanner.peek() != '\"')
+                    {
+                        return false;
+                    }
+                    const char_type* key_first = scanner.current();
+                    if (!scanner.skip_string())
+                    {
+                        return false;
+                    }
+                    string_view_type key(key_first + 1, (scanner.current() - key_first) - 2);
+                    if (std::find(key.begin(), key.end(), '\\') != key.end())
+                    {
+                        found = Json::parse(string_view_type(key_first, scanner.current() - key_first)).as_string_view() == string_view_type(token);
+                    }
+                    else
+                    {
+                        found = key == string_view_type(token);
+                    }
+                    scanner.skip_whitespace();
+                    if (scanner.done() || scanner.peek() != ':')
+                    {
+                        return false;
+                    }
+                    scanner.advance();
+                    scanner.skip_whitespace();
+                    if (!found)
+                    {
+                        if (!scanner.skip_value())
+                        {
+                            return false;
+                        }
+                        scanner.skip_whitespace();
+                        if (scanner.done() || scanner.peek() != ',')
+                        {
+                            return false;
+                        }
+                        scanner.advance();
+                    }
+                }
+            }
+            else if (scanner.peek() == '[')
+            {
+                scanner.advance();
+                auto result = jsoncons::detail::to_integer_decimal<std::size_t>(token.data(), token.size());
+                if (!result)
+                {
+                    return false;
+                }
+                for (std::size_t i = 0; i < result.value(); ++i)
+                {
+                    scanner.skip_whitespace();
+                    if (!scanner.skip_value())
+                    {
+                        return false;
+                    }
+                    scanner.skip_whitespace();
+                    if (scanner.done() || scanner.peek() != ',')
+                    {
+                        return false;
+                    }
+                    scanner.advance();
+                }
+                scanner.skip_whitespace();
+            }
+            else
+            {
+                return false;
+            }
+        }
+        scanner.skip_whitespace();
+        return !scanner.done();
+    }
+
+    // Parses the array elements in [first,last), which are separated by commas
+    template <class Json>
+    bool parse_array_elements(const typename Json::char_type* first, const typename Json::char_type* last,
+                              const basic_json_decode_options<typename Json::char_type>& options,
+                              Json& result)
+    {
+        using char_type = typename Json::char_type;
+
+        static const char_type begin_array[] = {'['};
+        static const char_type end_array[] = {']'};
+
+        json_decoder<Json> decoder;
+        basic_json_parser<char_type> parser(options);
+        std::error_code ec;
+
+        parser.update(begin_array, 1);
+        parser.parse_some(decoder, ec);
+        if (ec) return false;
+        parser.update(first, last - first);
+        parser.parse_some(decoder, ec);
+        if (ec) return false;
+        parser.update(end_array, 1);
+        parser.parse_some(decoder, ec);
+        if (ec) return false;
+        parser.finish_parse(decoder, ec);
+        if (ec || !decoder.is_valid())
+        {
+            return false;
+        }
+        result = decoder.get_result();
+        return true;
+    }
+
+    template <class Json>
+    Json parse_serial(const typename Json::string_view_type& s,
+                      const basic_json_decode_options<typename Json::char_type>& options)
+    {
+        return Json::parse(s, options);
+    }
+
+    // Parses the array in [first,last), first pointing at '[', in parallel.
+    // Returns false if the array could not be split or an element failed to
+    // parse, leaving error reporting to a serial parse.
+    template <class Json>
+    bool parse_array_parallel(const typename Json::char_type* first, const typename Json::char_type* last,
+                              const typename Json::char_type*& array_end,
+                              const basic_parallel_parse_options<typename Json::char_type>& popts,
+                              const basic_json_decode_options<typename Json::char_type>& options,
+                              Json& result)
+    {
+        using char_type = typename Json::char_type;
+
+        std::size_t num_threads = popts.max_threads() != 0 ? popts.max_threads() : std::thread::hardware_concurrency();
+        num_threads = (std::max)(num_threads, std::size_t(1));
+
+        // Phase 1: split the elements into chunks of roughly equal length,
+        // several per thread so that threads finishing early can take more
+        std::size_t target_length = (std::max)(popts.min_chunk_length(), static_cast<std::size_t>(last - first) / (4*num_threads));
+        std::vector<std::pair<const char_type*,const char_type*>> chunks;
+
+        structural_scanner<char_type> scanner(first + 1, last);
+        scanner.skip_whitespace();
+        if (scanner.done())
+        {
+            return false;
+        }
+        if (scanner.peek() != ']')
+        {
+            const char_type* chunk_first = scanner.current();
+            while (true)
+            {
+                scanner.skip_whitespace();
+                if (!scanner.skip_value())
+                {
+                    return false;
+                }
+                const char_type* element_end = scanner.current();
+                scanner.skip_whitespace();
+                if (scanner.done())
+                {
+                    return false;
+                }
+                if (scanner.peek() == ']')
+                {
+                    chunks.emplace_back(chunk_first, element_end);
+                    break;
+                }
+                if (scanner.peek() != ',')
+                {
+                    return false;
+                }
+                if (static_cast<std::size_t>(element_end - chunk_first) >= target_length)
+                {
+                    chunks.emplace_back(chunk_first, element_end);
+                    scanner.advance();
+                    chunk_first = scanner.current();
+                }
+                else
+                {
+                    scanner.advance();
+                }
+            }
+        }
+        scanner.advance();
+        array_end = scanner.current();
+
+        // Phase 2: parse the chunks concurrently
+        std::vector<Json> parts(chunks.size());
+        std::atomic<std::size_t> next_chunk(0);
+        std::atomic<bool> failed(false);
+
+        auto work = [&]()
+        {
+            for (;;)
+            {
+                std::size_t i = next_chunk.fetch_add(1);
+                if (i >= chunks.size() || failed.load())
+                {
+                    break;
+                }
+                JSONCONS_TRY
+                {
+                    if (!parse_array_elements(chunks[i].first, chunks[i].second, options, parts[i]))
+                    {
+                        failed = true;
+                    }
+                }
+                JSONCONS_CATCH(...)
+                {
+                    failed = true;
+                }
+            }
+        };
+
+        std::size_t num_workers = (std::min)(num_threads, chunks.size());
+        {
+            worker_threads workers(failed);
+            for (std::size_t i = 1; i < num_workers; ++i)
+            {
+                workers.start(work);
+            }
+            work();
+            workers.join();
+        }
+        if (failed)
+        {
+            return false;
+        }
+
+        // Stitch the parts together in document order
+        std::size_t count = 0;
+        for (const auto& part : parts)
+        {
+            count += part.size();
+        }
+        result = Json(json_array_arg);
+        result.reserve(count);
+        for (auto& part : parts)
+        {
+            for (auto& item : part.array_range())
+            {
+                result.push_back(std::move(item));
+            }
+        }
+        return true;
+    }
+
+} // namespace detail
+
+    // parse_parallel: parses s as Json::parse(s, options) does, except that
+    // the elements of a large array, at the root or at a JSON Pointer
+    // location, are parsed concurrently on several threads. A structural scan
+    // first locates the element boundaries, then each thread parses chunks of
+    // elements into its own array, and the arrays are joined in document order.
+    // Errors are reported as by Json::parse. Each worker decodes with a default
+    // constructed allocator_type, not with an allocator supplied by the caller,
+    // so a stateful allocator must be default constructible and, if its default
+    // instances share state, safe to use from several threads at once.
+
+    template <class Json>
+    Json parse_parallel(const typename Json::string_view_type& s,
+                        const basic_parallel_parse_options<typename Json::char_type>& popts = basic_parallel_parse_options<typename Json::char_type>(),
+                        const basic_json_decode_options<typename Json::char_type>& options = basic_json_decode_options<typename Json::char_type>())
+    {
+        using char_type = typename Json::char_type;
+        using string_view_type = typename Json::string_view_type;
+
+        if (s.size() < 2*popts.min_chunk_length() || popts.max_threads() == 1)
+        {
+            return detail::parse_serial<Json>(s, options);
+        }
+
+        auto bom = unicons::skip_bom(s.begin(), s.end());
+        if (bom.ec != unicons::encoding_errc())
+        {
+            return detail::parse_serial<Json>(s, options);
+        }
+        const char_type* first = s.data() + (bom.it - s.begin());
+        const char_type* last = s.data() + s.size();
+
+        std::vector<std::basic_string<char_type>> tokens;
+        if (!detail::split_json_pointer(popts.array_location(), tokens))
+        {
+            return detail::parse_serial<Json>(s, options);
+        }
+
+        detail::structural_scanner<char_type> scanner(first, last);
+        if (!detail::scan_to_location<Json>(scanner, tokens) || scanner.peek() != '[')
+        {
+            return detail::parse_serial<Json>(s, options);
+        }
+        const char_type* array_first = scanner.current();
+        const char_type* array_last = nullptr;
+
+        Json array;
+        if (!detail::parse_array_parallel<Json>(array_first, last, array_last, popts, options, array))
+        {
+            return detail::parse_serial<Json>(s, options);
+        }
+
+        if (tokens.empty())
+        {
+            detail::structural_scanner<char_type> rest(array_last, last);
+            rest.skip_spaces();
+            if (!rest.done())
+            {
+                return detail::parse_serial<Json>(s, options);
+            }
+            return array;
+        }
+
+        // Parse the rest of the document with an empty array in place of the
+        // parallel parsed one, then put the array in its place
+        std::basic_string<char_type> rest(first, array_first);
+        rest.push_back('[');
+        rest.push_back(']');
+        rest.append(array_last, last);
+        Json result = Json::parse(string_view_type(rest), options);
+
+        Json* target = &result;
+        for (const auto& token : tokens)
+        {
+            if (target->is_object())
+            {
+                target = &target->at(token);
+            }
+            else
+            {
+                target = &target->at(jsoncons::detail::to_integer_decimal<std::size_t>(token.data(), token.size()).value());
+            }
+        }
+        *target = std::move(array);
+        return result;
+    }
+
+} // namespace jsoncons
+
+#endif
@@ -15,6 +15,8 @@
 #include <exception>
 #include <memory> // std::addressof
 #include <cstring> // std::memcpy
+#include <algorithm> // std::max
+#include <iterator> // std::back_inserter
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/detail/more_type_traits.hpp>
 
@@ -80,11 +82,48 @@ namespace jsoncons {
             else
             {
                 stream_ptr_->write(begin_buffer_, buffer_length());
-                stream_ptr_->write(s,length);
                 p_ = begin_buffer_;
+                if (length < buffer_.size())
+                {
+                    std::memcpy(p_, s, length*sizeof(CharT));
+                    p_ += length;
+                }
+                else
+                {
+                    stream_ptr_->write(s,length);
+                }
             }
         }
 
+        // Makes room for at least n more elements in the buffer
+        void reserve(std::size_t n)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < n)
+            {
+                stream_ptr_->write(begin_buffer_, buffer_length());
+                if (buffer_.size() < n)
+                {
+                    buffer_.resize(n);
+                    begin_buffer_ = buffer_.data();
+                    end_buffer_ = begin_buffer_ + buffer_.size();
+                }
+                p_ = begin_buffer_;
+            }
+        }
+
+        // Returns a window of n writable elements, made part of the output
+        // by a following call to commit
+        CharT* write_ptr(std::size_t n)
+        {
+            reserve(n);
+            return p_;
+        }
+
+        void commit(std::size_t n)
+        {
+            p_ += n;
+        }
+
         void push_back(CharT ch)
         {
             if (p_ < end_buffer_)
@@ -170,11 +209,48 @@ namespace jsoncons {
             else
             {
                 stream_ptr_->write((char*)begin_buffer_, buffer_length());
-                stream_ptr_->write((const char*)s,length);
+                p_ = begin_buffer_;
+                if (length < buffer_.size())
+                {
+                    std::memcpy(p_, s, length*sizeof(uint8_t));
+                    p_ += length;
+                }
+                else
+                {
+                    stream_ptr_->write((const char*)s,length);
+                }
+            }
+        }
+
+        // Makes room for at least n more elements in the buffer
+        void reserve(std::size_t n)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < n)
+            {
+                stream_ptr_->write((char*)begin_buffer_, buffer_length());
+                if (buffer_.size() < n)
+                {
+                    buffer_.resize(n);
+                    begin_buffer_ = buffer_.data();
+                    end_buffer_ = begin_buffer_ + buffer_.size();
+                }
                 p_ = begin_buffer_;
             }
         }
 
+        // Returns a window of n writable elements, made part of the output
+        // by a following call to commit
+        uint8_t* write_ptr(std::size_t n)
+        {
+            reserve(n);
+            return p_;
+        }
+
+        void commit(std::size_t n)
+        {
+            p_ += n;
+        }
+
         void push_back(uint8_t ch)
         {
             if (p_ < end_buffer_)
@@ -206,6 +282,7 @@ namespace jsoncons {
         using container_type = StringT;
     private:
         container_type* buf_ptr;
+        std::size_t window_offset_;
 
         // Noncopyable
         string_sink(const string_sink&) = delete;
@@ -213,13 +290,13 @@ namespace jsoncons {
         string_sink& operator=(string_sink&& val) = delete;
     public:
         string_sink(string_sink&& val) noexcept
-            : buf_ptr(nullptr)
+            : buf_ptr(nullptr), window_offset_(val.window_offset_)
         {
             std::swap(buf_ptr,val.buf_ptr);
         }
 
         string_sink(container_type& buf)
-            : buf_ptr(std::addressof(buf))
+            : buf_ptr(std::addressof(buf)), window_offset_(0)
         {
         }
 
@@ -236,6 +313,29 @@ namespace jsoncons {
         {
             buf_ptr->push_back(ch);
         }
+
+        // Grows capacity geometrically, so repeated small requests stay amortized O(1)
+        void reserve(std::size_t n)
+        {
+            std::size_t needed = buf_ptr->size() + n;
+            if (buf_ptr->capacity() < needed)
+            {
+                buf_ptr->reserve((std::max)(needed, 2*buf_ptr->capacity()));
+            }
+        }
+
+        value_type* write_ptr(std::size_t n)
+        {
+            reserve(n);
+            window_offset_ = buf_ptr->size();
+            buf_ptr->resize(window_offset_ + n);
+            return &(*buf_ptr)[window_offset_];
+        }
+
+        void commit(std::size_t n)
+        {
+            buf_ptr->resize(window_offset_ + n);
+        }
     };
 
     // bytes_sink
@@ -253,6 +353,7 @@ namespace jsoncons {
         using value_type = typename Container::value_type;
     private:
         container_type* buf_ptr;
+        std::size_t window_offset_;
 
         // Noncopyable
         bytes_sink(const bytes_sink&) = delete;
@@ -261,7 +362,7 @@ namespace jsoncons {
         bytes_sink(bytes_sink&&) = default;
 
         bytes_sink(container_type& buf)
-            : buf_ptr(std::addressof(buf))
+            : buf_ptr(std::addressof(buf)), window_offset_(0)
         {
         }
 
@@ -275,8 +376,150 @@ namespace jsoncons {
         {
             buf_ptr->push_back(static_cast<value_type>(ch));
         }
+
+        // append, reserve, write_ptr and commit are only available for
+        // contiguous containers such as std::vector
+
+        template <class C = Container>
+        typename std::enable_if<jsoncons::detail::is_resizable_contiguous_container<C>::value>::type
+        append(const value_type* s, std::size_t length)
+        {
+            buf_ptr->insert(buf_ptr->end(), s, s+length);
+        }
+
+        template <class C = Container>
+        typename std::enable_if<jsoncons::detail::is_resizable_contiguous_container<C>::value>::type
+        reserve(std::size_t n)
+        {
+            std::size_t needed = buf_ptr->size() + n;
+            if (buf_ptr->capacity() < needed)
+            {
+                buf_ptr->reserve((std::max)(needed, 2*buf_ptr->capacity()));
+            }
+        }
+
+        template <class C = Container>
+        typename std::enable_if<jsoncons::detail::is_resizable_contiguous_container<C>::value,value_type*>::type
+        write_ptr(std::size_t n)
+        {
+            reserve(n);
+            window_offset_ = buf_ptr->size();
+            buf_ptr->resize(window_offset_ + n);
+            return &(*buf_ptr)[window_offset_]; // data() is const for std::string before C++17
+        }
+
+        template <class C = Container>
+        typename std::enable_if<jsoncons::detail::is_resizable_contiguous_container<C>::value>::type
+        commit(std::size_t n)
+        {
+            buf_ptr->resize(window_offset_ + n);
+        }
     };
 
+namespace detail {
+
+    template <class Sink>
+    using
+    sink_reserve_t = decltype(std::declval<Sink&>().reserve(std::size_t()));
+
+    template <class Sink>
+    using
+    sink_write_ptr_t = decltype(std::declval<Sink&>().write_ptr(std::size_t()));
+
+    // has_sink_reserve, has_write_ptr
+
+    template <class Sink>
+    using
+    has_sink_reserve = is_detected<sink_reserve_t, Sink>;
+
+    template <class Sink>
+    using
+    has_write_ptr = is_detected<sink_write_ptr_t, Sink>;
+
+    // sink_reserve: a capacity hint, ignored by sinks that don't support it
+
+    template <class Sink>
+    typename std::enable_if<has_sink_reserve<Sink>::value>::type
+    sink_reserve(Sink& sink, std::size_t n)
+    {
+        sink.reserve(n);
+    }
+
+    template <class Sink>
+    typename std::enable_if<!has_sink_reserve<Sink>::value>::type
+    sink_reserve(Sink&, std::size_t)
+    {
+    }
+
+    // sink_native_to_big: writes a one byte marker followed by val in big endian
+    // byte order, through a single write_ptr/commit window where the sink has one
+
+    template <class T, class Sink>
+    typename std::enable_if<has_write_ptr<Sink>::value>::type
+    sink_native_to_big(Sink& sink, uint8_t marker, T val)
+    {
+        auto p = sink.write_ptr(1 + sizeof(T));
+        *p = static_cast<typename Sink::value_type>(marker);
+        native_to_big(val, p + 1);
+        sink.commit(1 + sizeof(T));
+    }
+
+    template <class T, class Sink>
+    typename std::enable_if<!has_write_ptr<Sink>::value>::type
+    sink_native_to_big(Sink& sink, uint8_t marker, T val)
+    {
+        sink.push_back(marker);
+        native_to_big(val, std::back_inserter(sink));
+    }
+
+    // sink_append: appends a run of characters in one call where the sink
+    // supports it, otherwise one at a time
+
+    template <class Sink, class CharT>
+    typename std::enable_if<has_append<Sink,CharT>::value>::type
+    sink_append(Sink& sink, const CharT* s, std::size_t length)
+    {
+        sink.append(s, length);
+    }
+
+    template <class Sink, class CharT>
+    typename std::enable_if<!has_append<Sink,CharT>::value>::type
+    sink_append(Sink& sink, const CharT* s, std::size_t length)
+    {
+        for (const CharT* end = s + length; s != end; ++s)
+        {
+            sink.push_back(*s);
+        }
+    }
+
+    template <class Sink>
+    using
+    sink_append_ref_t = decltype(std::declval<Sink&>().append_ref(std::declval<const uint8_t*>(), std::size_t()));
+
+    template <class Sink>
+    using
+    has_append_ref = is_detected<sink_append_ref_t, Sink>;
+
+    // sink_append_ref: for payloads owned by the caller of the encoder. Sinks
+    // with append_ref, such as gather_sink, may keep a pointer to them until
+    // their next flush instead of copying them.
+
+    template <class Sink>
+    typename std::enable_if<has_append_ref<Sink>::value>::type
+    sink_append_ref(Sink& sink, const uint8_t* s, std::size_t length)
+    {
+        sink.append_ref(s, length);
+    }
+
+    template <class Sink>
+    typename std::enable_if<!has_append_ref<Sink>::value>::type
+    sink_append_ref(Sink& sink, const uint8_t* s, std::size_t length)
+    {
+        sink_append(sink, s, length);
+    }
+
+} // namespace detail
+
 } // namespace jsoncons
 
 #endif
@@ -15,6 +15,8 @@
 #include <cstring> // std::memcpy
 #include <exception>
 #include <type_traits> // std::enable_if
+#include <limits> // std::numeric_limits
+#include <algorithm> // std::min
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/byte_string.hpp> // jsoncons::byte_traits
 #include <jsoncons/detail/more_type_traits.hpp>
@@ -345,6 +347,14 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        span<const value_type> read_span(std::size_t length)
+        {
+            std::size_t len = (std::min)(static_cast<std::size_t>(end_ - current_), length);
+            span<const value_type> s(current_, len);
+            current_ += len;
+            return s;
+        }
     };
 
     // iterator source
@@ -659,6 +669,14 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        span<const value_type> read_span(std::size_t length)
+        {
+            std::size_t len = (std::min)(static_cast<std::size_t>(end_ - current_), length);
+            span<const value_type> s(current_, len);
+            current_ += len;
+            return s;
+        }
     };
 
     // binary_iterator source
@@ -737,12 +755,47 @@ namespace jsoncons {
         }
     };
 
+    // is_contiguous_source: sources over memory that stays valid for their
+    // lifetime, which hand out views of it with read_span instead of copying
+
+    template <class Source>
+    using source_read_span_t = decltype(std::declval<Source>().read_span(std::size_t()));
+
+    template <class Source>
+    using is_contiguous_source = jsoncons::detail::is_detected<source_read_span_t, Source>;
+
     template <class Source>
     struct source_reader
     {
         using value_type = typename Source::value_type;
         static constexpr std::size_t max_buffer_length = 16384;
 
+        // read_chunk: the next chunk of input. Contiguous sources return a
+        // view of all their remaining input, other sources read up to length
+        // characters into buffer. An empty chunk means the source is exhausted.
+
+        template <class Container>
+        static span<const value_type> read_chunk(Source& source, Container& buffer, std::size_t length)
+        {
+            return read_chunk(source, buffer, length, std::integral_constant<bool,is_contiguous_source<Source>::value>());
+        }
+
+        template <class Container>
+        static span<const value_type> read_chunk(Source& source, Container&, std::size_t, std::true_type)
+        {
+            return source.read_span((std::numeric_limits<std::size_t>::max)());
+        }
+
+        template <class Container>
+        static span<const value_type> read_chunk(Source& source, Container& buffer, std::size_t length, std::false_type)
+        {
+            buffer.clear();
+            buffer.resize(length);
+            std::size_t count = source.read(buffer.data(), length);
+            buffer.resize(count);
+            return span<const value_type>(buffer.data(), buffer.size());
+        }
+
         template <class Container>
         static
         typename std::enable_if<std::is_convertible<value_type,typename Container::value_type>::value &&
@@ -48,6 +48,15 @@
 #include <iterator>
 #include <type_traits>
 #include <system_error>
+#include <cstdint>
+#include <cstring> // std::memcpy
+
+#if !defined(JSONCONS_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UNICONS_HAS_SSE2
+#include <emmintrin.h>
+#endif
+#endif
 
 namespace jsoncons { namespace unicons {
 
@@ -882,6 +891,54 @@ convert(InputIt first, InputIt last,
     return convert_result<InputIt>{first,result} ;
 }
 
+// skip_ascii
+
+/*
+ * Returns an iterator to the first byte in [first,last) with the high bit set, or last.
+ * Over contiguous input the bytes are checked 16 (SSE2) or 8 at a time.
+ */
+template <class InputIt>
+typename std::enable_if<!std::is_pointer<InputIt>::value,InputIt>::type 
+skip_ascii(InputIt first, InputIt last) UNICONS_NOEXCEPT
+{
+    while (first != last && (static_cast<uint8_t>(*first) & 0x80) == 0)
+    {
+        ++first;
+    }
+    return first;
+}
+
+template <class InputIt>
+typename std::enable_if<std::is_pointer<InputIt>::value,InputIt>::type 
+skip_ascii(InputIt first, InputIt last) UNICONS_NOEXCEPT
+{
+#if defined(UNICONS_HAS_SSE2)
+    while (last - first >= 16)
+    {
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first))) != 0)
+        {
+            break;
+        }
+        first += 16;
+    }
+#endif
+    while (last - first >= 8)
+    {
+        uint64_t x;
+        std::memcpy(&x, first, sizeof(x));
+        if ((x & 0x8080808080808080ull) != 0)
+        {
+            break;
+        }
+        first += 8;
+    }
+    while (first != last && (static_cast<uint8_t>(*first) & 0x80) == 0)
+    {
+        ++first;
+    }
+    return first;
+}
+
 // validate
 
 template <class InputIt>
@@ -892,6 +949,11 @@ validate(InputIt first, InputIt last) UNICONS_NOEXCEPT
     conv_errc  result = conv_errc();
     while (first != last) 
     {
+        first = skip_ascii(first, last);
+        if (first == last)
+        {
+            break;
+        }
         std::size_t length = static_cast<std::size_t>(trailing_bytes_for_utf8[static_cast<uint8_t>(*first)]) + 1;
         if (length > (std::size_t)(last - first))
         {
@@ -23,6 +23,15 @@
 
 namespace jsoncons { namespace bson {
 
+// collect_lengths_arg_t
+
+struct collect_lengths_arg_t
+{
+    explicit collect_lengths_arg_t() = default; 
+};
+
+constexpr collect_lengths_arg_t collect_lengths_arg = collect_lengths_arg_t();
+
 template<class Sink=jsoncons::binary_stream_sink,class Allocator=std::allocator<char>>
 class basic_bson_encoder final : public basic_json_visitor<char>
 {
@@ -30,6 +39,11 @@ class basic_bson_encoder final : public basic_json_visitor<char>
     static constexpr int64_t nanos_in_milli = 1000000;
     static constexpr int64_t nanos_in_second = 1000000000;
     static constexpr int64_t millis_in_second = 1000;
+
+    // buffered: the document is built in buffer_ and its lengths back-patched before it is written out
+    // collect: nothing is written, the lengths of documents and arrays are recorded
+    // streaming: lengths recorded by a collect pass are written up front, values go straight to the sink
+    enum class length_mode {buffered, collect, streaming};
 public:
     using allocator_type = Allocator;
     using char_type = char;
@@ -41,11 +55,11 @@ private:
     {
         jsoncons::bson::detail::bson_container_type type_;
         std::size_t offset_;
-        std::size_t name_offset_;
+        std::size_t length_index_;
         std::size_t index_;
 
-        stack_item(jsoncons::bson::detail::bson_container_type type, std::size_t offset) noexcept
-           : type_(type), offset_(offset), name_offset_(0), index_(0)
+        stack_item(jsoncons::bson::detail::bson_container_type type, std::size_t offset, std::size_t length_index) noexcept
+           : type_(type), offset_(offset), length_index_(length_index), index_(0)
         {
         }
 
@@ -54,14 +68,9 @@ private:
             return offset_;
         }
 
-        std::size_t member_offset() const
-        {
-            return name_offset_;
-        }
-
-        void member_offset(std::size_t offset) 
+        std::size_t length_index() const
         {
-            name_offset_ = offset;
+            return length_index_;
         }
 
         std::size_t next_index()
@@ -73,8 +82,6 @@ private:
         {
             return type_ == jsoncons::bson::detail::bson_container_type::document;
         }
-
-
     };
 
     sink_type sink_;
@@ -83,7 +90,13 @@ private:
 
     std::vector<stack_item> stack_;
     std::vector<uint8_t> buffer_;
+    std::string key_;
     int nesting_depth_;
+    length_mode mode_;
+    std::vector<uint32_t> lengths_;
+    std::vector<uint32_t>* collected_lengths_;
+    std::size_t next_length_;
+    std::size_t position_;
 
     // Noncopyable and nonmoveable
     basic_bson_encoder(const basic_bson_encoder&) = delete;
@@ -103,7 +116,48 @@ public:
        : sink_(std::forward<Sink>(sink)),
          options_(options),
          alloc_(alloc), 
-         nesting_depth_(0)
+         nesting_depth_(0),
+         mode_(length_mode::buffered),
+         collected_lengths_(nullptr),
+         next_length_(0),
+         position_(0)
+    {
+    }
+
+    // Writes straight to the sink, taking the length of each document and array
+    // from container_lengths, in the order they begin. An empty container_lengths
+    // means the lengths aren't known, and the document is buffered.
+    basic_bson_encoder(Sink&& sink, 
+                       std::vector<uint32_t> container_lengths,
+                       const bson_encode_options& options = bson_encode_options(), 
+                       const Allocator& alloc = Allocator())
+       : sink_(std::forward<Sink>(sink)),
+         options_(options),
+         alloc_(alloc), 
+         nesting_depth_(0),
+         mode_(container_lengths.empty() ? length_mode::buffered : length_mode::streaming),
+         lengths_(std::move(container_lengths)),
+         collected_lengths_(nullptr),
+         next_length_(0),
+         position_(0)
+    {
+    }
+
+    // Measuring pass: writes nothing to the sink, and appends the length of each
+    // document and array to container_lengths, in the order they begin
+    basic_bson_encoder(collect_lengths_arg_t,
+                       Sink&& sink, 
+                       std::vector<uint32_t>& container_lengths,
+                       const bson_encode_options& options = bson_encode_options(), 
+                       const Allocator& alloc = Allocator())
+       : sink_(std::forward<Sink>(sink)),
+         options_(options),
+         alloc_(alloc), 
+         nesting_depth_(0),
+         mode_(length_mode::collect),
+         collected_lengths_(std::addressof(container_lengths)),
+         next_length_(0),
+         position_(0)
     {
     }
 
@@ -127,7 +181,7 @@ private:
             ec = bson_errc::max_nesting_depth_exceeded;
             return false;
         } 
-        if (buffer_.size() > 0)
+        if (position_ > 0)
         {
             if (stack_.empty())
             {
@@ -137,31 +191,14 @@ private:
             before_value(jsoncons::bson::detail::bson_format::document_cd);
         }
 
-        stack_.emplace_back(jsoncons::bson::detail::bson_container_type::document, buffer_.size());
-        buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
-
-        return true;
+        return begin_container(jsoncons::bson::detail::bson_container_type::document, ec);
     }
 
-    bool visit_end_object(const ser_context&, std::error_code&) override
+    bool visit_end_object(const ser_context&, std::error_code& ec) override
     {
         JSONCONS_ASSERT(!stack_.empty());
         --nesting_depth_;
-
-        buffer_.push_back(0x00);
-
-        std::size_t length = buffer_.size() - stack_.back().offset();
-        jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+stack_.back().offset());
-
-        stack_.pop_back();
-        if (stack_.empty())
-        {
-            for (auto c : buffer_)
-            {
-                sink_.push_back(c);
-            }
-        }
-        return true;
+        return end_container(ec);
     }
 
     bool visit_begin_array(semantic_tag, const ser_context&, std::error_code& ec) override
@@ -171,7 +208,7 @@ private:
             ec = bson_errc::max_nesting_depth_exceeded;
             return false;
         } 
-        if (buffer_.size() > 0)
+        if (position_ > 0)
         {
             if (stack_.empty())
             {
@@ -180,41 +217,20 @@ private:
             }
             before_value(jsoncons::bson::detail::bson_format::array_cd);
         }
-        stack_.emplace_back(jsoncons::bson::detail::bson_container_type::array, buffer_.size());
-        buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
-        return true;
+        return begin_container(jsoncons::bson::detail::bson_container_type::array, ec);
     }
 
-    bool visit_end_array(const ser_context&, std::error_code&) override
+    bool visit_end_array(const ser_context&, std::error_code& ec) override
     {
         JSONCONS_ASSERT(!stack_.empty());
         --nesting_depth_;
-
-        buffer_.push_back(0x00);
-
-        std::size_t length = buffer_.size() - stack_.back().offset();
-        jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+stack_.back().offset());
-
-        stack_.pop_back();
-        if (stack_.empty())
-        {
-            for (auto c : buffer_)
-            {
-                sink_.push_back(c);
-            }
-        }
-        return true;
+        return end_container(ec);
     }
 
     bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
     {
-        stack_.back().member_offset(buffer_.size());
-        buffer_.push_back(0x00); // reserve space for code
-        for (auto c : name)
-        {
-            buffer_.push_back(c);
-        }
-        buffer_.push_back(0x00);
+        // The element's type code precedes its name, so the name waits for the value
+        key_.assign(name.data(), name.size());
         return true;
     }
 
@@ -239,11 +255,11 @@ private:
         before_value(jsoncons::bson::detail::bson_format::bool_cd);
         if (val)
         {
-            buffer_.push_back(0x01);
+            put(0x01);
         }
         else
         {
-            buffer_.push_back(0x00);
+            put(0x00);
         }
 
         return true;
@@ -256,11 +272,6 @@ private:
             ec = bson_errc::expected_bson_document;
             return false;
         }
-        before_value(jsoncons::bson::detail::bson_format::string_cd);
-
-        std::size_t offset = buffer_.size();
-        buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
-        std::size_t string_offset = buffer_.size();
 
         auto sink = unicons::validate(sv.begin(), sv.end());
         if (sink.ec != unicons::conv_errc())
@@ -268,13 +279,11 @@ private:
             ec = bson_errc::invalid_utf8_text_string;
             return false;
         }
-        for (auto c : sv)
-        {
-            buffer_.push_back(c);
-        }
-        buffer_.push_back(0x00);
-        std::size_t length = buffer_.size() - string_offset;
-        jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+offset);
+
+        before_value(jsoncons::bson::detail::bson_format::string_cd);
+        put_little(static_cast<uint32_t>(sv.size() + 1));
+        put_payload(reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
+        put(0x00);
 
         return true;
     }
@@ -291,18 +300,9 @@ private:
         }
         before_value(jsoncons::bson::detail::bson_format::binary_cd);
 
-        std::size_t offset = buffer_.size();
-        buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
-        std::size_t string_offset = buffer_.size();
-
-        buffer_.push_back(0x80); // default subtype
-
-        for (auto c : b)
-        {
-            buffer_.push_back(c);
-        }
-        std::size_t length = buffer_.size() - string_offset - 1;
-        jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+offset);
+        put_little(static_cast<uint32_t>(b.size()));
+        put(0x80); // default subtype
+        put_payload(b.data(), b.size());
 
         return true;
     }
@@ -319,18 +319,9 @@ private:
         }
         before_value(jsoncons::bson::detail::bson_format::binary_cd);
 
-        std::size_t offset = buffer_.size();
-        buffer_.insert(buffer_.end(), sizeof(int32_t), 0);
-        std::size_t string_offset = buffer_.size();
-
-        buffer_.push_back(static_cast<uint8_t>(ext_tag)); // default subtype
-
-        for (auto c : b)
-        {
-            buffer_.push_back(c);
-        }
-        std::size_t length = buffer_.size() - string_offset - 1;
-        jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+offset);
+        put_little(static_cast<uint32_t>(b.size()));
+        put(static_cast<uint8_t>(ext_tag)); // default subtype
+        put_payload(b.data(), b.size());
 
         return true;
     }
@@ -362,11 +353,11 @@ private:
                     return false;
                 }
                 before_value(jsoncons::bson::detail::bson_format::datetime_cd);
-                jsoncons::detail::native_to_little(val*millis_in_second,std::back_inserter(buffer_));
+                put_little(val*millis_in_second);
                 return true;
             case semantic_tag::epoch_milli:
                 before_value(jsoncons::bson::detail::bson_format::datetime_cd);
-                jsoncons::detail::native_to_little(val,std::back_inserter(buffer_));
+                put_little(val);
                 return true;
             case semantic_tag::epoch_nano:
                 before_value(jsoncons::bson::detail::bson_format::datetime_cd);
@@ -374,19 +365,19 @@ private:
                 {
                     val /= nanos_in_milli;
                 }
-                jsoncons::detail::native_to_little(static_cast<int64_t>(val),std::back_inserter(buffer_));
+                put_little(static_cast<int64_t>(val));
                 return true;
             default:
             {
                 if (val >= (std::numeric_limits<int32_t>::lowest)() && val <= (std::numeric_limits<int32_t>::max)())
                 {
                     before_value(jsoncons::bson::detail::bson_format::int32_cd);
-                    jsoncons::detail::native_to_little(static_cast<uint32_t>(val),std::back_inserter(buffer_));
+                    put_little(static_cast<uint32_t>(val));
                 }
                 else 
                 {
                     before_value(jsoncons::bson::detail::bson_format::int64_cd);
-                    jsoncons::detail::native_to_little(static_cast<int64_t>(val),std::back_inserter(buffer_));
+                    put_little(static_cast<int64_t>(val));
                 }
                 return true;
             }
@@ -414,11 +405,11 @@ private:
                     return false;
                 }
                 before_value(jsoncons::bson::detail::bson_format::datetime_cd);
-                jsoncons::detail::native_to_little(static_cast<int64_t>(val*millis_in_second),std::back_inserter(buffer_));
+                put_little(static_cast<int64_t>(val*millis_in_second));
                 return true;
             case semantic_tag::epoch_milli:
                 before_value(jsoncons::bson::detail::bson_format::datetime_cd);
-                jsoncons::detail::native_to_little(static_cast<int64_t>(val),std::back_inserter(buffer_));
+                put_little(static_cast<int64_t>(val));
                 return true;
             case semantic_tag::epoch_nano:
                 before_value(jsoncons::bson::detail::bson_format::datetime_cd);
@@ -426,7 +417,7 @@ private:
                 {
                     val /= nanos_in_second;
                 }
-                jsoncons::detail::native_to_little(static_cast<int64_t>(val),std::back_inserter(buffer_));
+                put_little(static_cast<int64_t>(val));
                 return true;
             default:
             {
@@ -434,13 +425,13 @@ private:
                 if (val <= (std::numeric_limits<int32_t>::max)())
                 {
                     before_value(jsoncons::bson::detail::bson_format::int32_cd);
-                    jsoncons::detail::native_to_little(static_cast<uint32_t>(val),std::back_inserter(buffer_));
+                    put_little(static_cast<uint32_t>(val));
                     more = true;
                 }
                 else if (val <= (uint64_t)(std::numeric_limits<int64_t>::max)())
                 {
                     before_value(jsoncons::bson::detail::bson_format::int64_cd);
-                    jsoncons::detail::native_to_little(static_cast<uint64_t>(val),std::back_inserter(buffer_));
+                    put_little(static_cast<uint64_t>(val));
                     more = true;
                 }
                 else
@@ -464,24 +455,139 @@ private:
             return false;
         }
         before_value(jsoncons::bson::detail::bson_format::double_cd);
-        jsoncons::detail::native_to_little(val,std::back_inserter(buffer_));
+        put_little(val);
         return true;
     }
 
     void before_value(uint8_t code) 
     {
         JSONCONS_ASSERT(!stack_.empty());
+        put(code);
         if (stack_.back().is_object())
         {
-            buffer_[stack_.back().member_offset()] = code;
+            put_payload(reinterpret_cast<const uint8_t*>(key_.data()), key_.size(), false);
         }
         else
         {
-            buffer_.push_back(code);
             std::string name = std::to_string(stack_.back().next_index());
-            buffer_.insert(buffer_.end(), name.begin(), name.end());
-            buffer_.push_back(0x00);
+            put_payload(reinterpret_cast<const uint8_t*>(name.data()), name.size(), false);
+        }
+        put(0x00);
+    }
+
+    bool begin_container(jsoncons::bson::detail::bson_container_type type, std::error_code& ec)
+    {
+        switch (mode_)
+        {
+            case length_mode::buffered:
+                stack_.emplace_back(type, position_, 0);
+                put_little(static_cast<uint32_t>(0)); // back-patched at the end
+                break;
+            case length_mode::collect:
+                stack_.emplace_back(type, position_, collected_lengths_->size());
+                collected_lengths_->push_back(0);
+                position_ += sizeof(int32_t);
+                break;
+            case length_mode::streaming:
+                if (next_length_ >= lengths_.size())
+                {
+                    ec = bson_errc::container_length_mismatch;
+                    return false;
+                }
+                stack_.emplace_back(type, position_, next_length_);
+                put_little(lengths_[next_length_++]);
+                break;
+        }
+        return true;
+    }
+
+    bool end_container(std::error_code& ec)
+    {
+        put(0x00);
+
+        std::size_t length = position_ - stack_.back().offset();
+        switch (mode_)
+        {
+            case length_mode::buffered:
+                jsoncons::detail::native_to_little(static_cast<uint32_t>(length), buffer_.begin()+stack_.back().offset());
+                break;
+            case length_mode::collect:
+                (*collected_lengths_)[stack_.back().length_index()] = static_cast<uint32_t>(length);
+                break;
+            case length_mode::streaming:
+                if (lengths_[stack_.back().length_index()] != length)
+                {
+                    ec = bson_errc::container_length_mismatch;
+                    return false;
+                }
+                break;
+        }
+
+        stack_.pop_back();
+        if (stack_.empty() && mode_ == length_mode::buffered)
+        {
+            jsoncons::detail::sink_append(sink_, buffer_.data(), buffer_.size());
+        }
+        return true;
+    }
+
+    void put(uint8_t c)
+    {
+        switch (mode_)
+        {
+            case length_mode::buffered:
+                buffer_.push_back(c);
+                break;
+            case length_mode::streaming:
+                sink_.push_back(c);
+                break;
+            default:
+                break;
+        }
+        ++position_;
+    }
+
+    // Strings and byte strings. Payloads passed to the visit functions may be
+    // referenced in place by sinks with append_ref, element names live in
+    // key_ or a temporary and must be copied
+    void put_payload(const uint8_t* data, std::size_t length, bool is_caller_owned = true)
+    {
+        switch (mode_)
+        {
+            case length_mode::buffered:
+                buffer_.insert(buffer_.end(), data, data + length);
+                break;
+            case length_mode::streaming:
+                if (is_caller_owned)
+                {
+                    jsoncons::detail::sink_append_ref(sink_, data, length);
+                }
+                else
+                {
+                    jsoncons::detail::sink_append(sink_, data, length);
+                }
+                break;
+            default:
+                break;
+        }
+        position_ += length;
+    }
+
+    template <class T>
+    void put_little(T val)
+    {
+        switch (mode_)
+        {
+            case length_mode::buffered:
+                jsoncons::detail::native_to_little(val, std::back_inserter(buffer_));
+                break;
+            case length_mode::streaming:
+                jsoncons::detail::native_to_little(val, std::back_inserter(sink_));
+                break;
+            default:
+                break;
         }
+        position_ += sizeof(T);
     }
 };
 
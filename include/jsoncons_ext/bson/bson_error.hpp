@@ -25,7 +25,8 @@ enum class bson_errc
     datetime_too_small,
     datetime_too_large,
     expected_bson_document,
-    unknown_type
+    unknown_type,
+    container_length_mismatch
 };
 
 class bson_error_category_impl
@@ -62,6 +63,8 @@ public:
                 return "datetime too small";
             case bson_errc::expected_bson_document:
                 return "Expected BSON document";
+            case bson_errc::container_length_mismatch:
+                return "Document or array length differs from the one given";
             default:
                 return "Unknown BSON parser error";
         }
@@ -53,22 +53,36 @@ public:
 class bson_encode_options : public virtual bson_options_common
 {
     friend class bson_options;
+    bool precompute_lengths_;
 public:
     bson_encode_options()
+        : precompute_lengths_(false)
     {
     }
+
+    bool precompute_lengths() const 
+    {
+        return precompute_lengths_;
+    }
 };
 
 class bson_options final : public bson_decode_options, public bson_encode_options
 {
 public:
     using bson_options_common::max_nesting_depth;
+    using bson_encode_options::precompute_lengths;
 
     bson_options& max_nesting_depth(int value)
     {
         this->max_nesting_depth_ = value;
         return *this;
     }
+
+    bson_options& precompute_lengths(bool value)
+    {
+        this->precompute_lengths_ = value;
+        return *this;
+    }
 };
 
 }}
@@ -20,6 +20,56 @@
 namespace jsoncons { 
 namespace bson {
 
+namespace detail {
+
+    template<class T>
+    typename std::enable_if<is_basic_json<T>::value,void>::type 
+    visit_bson_value(const T& j, basic_json_visitor<char>& visitor)
+    {
+        using char_type = typename T::char_type;
+        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(visitor);
+        j.dump(adaptor);
+    }
+
+    template<class T>
+    typename std::enable_if<!is_basic_json<T>::value,void>::type 
+    visit_bson_value(const T& val, basic_json_visitor<char>& visitor)
+    {
+        std::error_code ec;
+        encode_traits<T,char>::encode(val, visitor, json(), ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
+} // namespace detail
+
+    // bson_container_lengths: a first pass over val that records the length of each
+    // of its documents and arrays, in the order they begin. Given to a basic_bson_encoder, 
+    // they let it write the document straight to its sink instead of buffering it.
+
+    template<class T>
+    std::vector<uint32_t> bson_container_lengths(const T& val, 
+                                                 const bson_encode_options& options = bson_encode_options())
+    {
+        std::vector<uint32_t> lengths;
+        std::vector<uint8_t> unused;
+        basic_bson_encoder<jsoncons::bytes_sink<std::vector<uint8_t>>> encoder(collect_lengths_arg, unused, lengths, options);
+        detail::visit_bson_value(val, encoder);
+        return lengths;
+    }
+
+namespace detail {
+
+    template<class T>
+    std::vector<uint32_t> precomputed_lengths(const T& val, const bson_encode_options& options)
+    {
+        return options.precompute_lengths() ? bson_container_lengths(val, options) : std::vector<uint32_t>();
+    }
+
+} // namespace detail
+
     template<class T, class Container>
     typename std::enable_if<is_basic_json<T>::value &&
                             jsoncons::detail::is_back_insertable_byte_container<Container>::value,void>::type 
@@ -28,7 +78,7 @@ namespace bson {
                 const bson_encode_options& options = bson_encode_options())
     {
         using char_type = typename T::char_type;
-        basic_bson_encoder<jsoncons::bytes_sink<Container>> encoder(v, options);
+        basic_bson_encoder<jsoncons::bytes_sink<Container>> encoder(v, detail::precomputed_lengths(j, options), options);
         auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
         j.dump(adaptor);
     }
@@ -40,7 +90,7 @@ namespace bson {
                 Container& v, 
                 const bson_encode_options& options = bson_encode_options())
     {
-        basic_bson_encoder<jsoncons::bytes_sink<Container>> encoder(v, options);
+        basic_bson_encoder<jsoncons::bytes_sink<Container>> encoder(v, detail::precomputed_lengths(val, options), options);
         std::error_code ec;
         encode_traits<T,char>::encode(val, encoder, json(), ec);
         if (ec)
@@ -56,7 +106,7 @@ namespace bson {
                 const bson_encode_options& options = bson_encode_options())
     {
         using char_type = typename T::char_type;
-        bson_stream_encoder encoder(os, options);
+        bson_stream_encoder encoder(os, detail::precomputed_lengths(j, options), options);
         auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
         j.dump(adaptor);
     }
@@ -67,7 +117,7 @@ namespace bson {
                 std::ostream& os, 
                 const bson_encode_options& options = bson_encode_options())
     {
-        bson_stream_encoder encoder(os, options);
+        bson_stream_encoder encoder(os, detail::precomputed_lengths(val, options), options);
         std::error_code ec;
         encode_traits<T,char>::encode(val, encoder, json(), ec);
         if (ec)
@@ -87,7 +137,7 @@ namespace bson {
                 const bson_encode_options& options = bson_encode_options())
     {
         using char_type = typename T::char_type;
-        basic_bson_encoder<jsoncons::bytes_sink<Container>,TempAllocator> encoder(v, options, temp_alloc);
+        basic_bson_encoder<jsoncons::bytes_sink<Container>,TempAllocator> encoder(v, detail::precomputed_lengths(j, options), options, temp_alloc);
         auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
         j.dump(adaptor);
     }
@@ -100,7 +150,7 @@ namespace bson {
                 Container& v, 
                 const bson_encode_options& options = bson_encode_options())
     {
-        basic_bson_encoder<jsoncons::bytes_sink<Container>,TempAllocator> encoder(v, options, temp_alloc);
+        basic_bson_encoder<jsoncons::bytes_sink<Container>,TempAllocator> encoder(v, detail::precomputed_lengths(val, options), options, temp_alloc);
         std::error_code ec;
         encode_traits<T,char>::encode(val, encoder, json(), ec);
         if (ec)
@@ -117,7 +167,7 @@ namespace bson {
                 const bson_encode_options& options = bson_encode_options())
     {
         using char_type = typename T::char_type;
-        basic_bson_encoder<jsoncons::binary_stream_sink,TempAllocator> encoder(os, options, temp_alloc);
+        basic_bson_encoder<jsoncons::binary_stream_sink,TempAllocator> encoder(os, detail::precomputed_lengths(j, options), options, temp_alloc);
         auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
         j.dump(adaptor);
     }
@@ -129,7 +179,7 @@ namespace bson {
                 std::ostream& os, 
                 const bson_encode_options& options = bson_encode_options())
     {
-        basic_bson_encoder<jsoncons::binary_stream_sink,TempAllocator> encoder(os, options, temp_alloc);
+        basic_bson_encoder<jsoncons::binary_stream_sink,TempAllocator> encoder(os, detail::precomputed_lengths(val, options), options, temp_alloc);
         std::error_code ec;
         encode_traits<T,char>::encode(val, encoder, json(), ec);
         if (ec)
@@ -16,6 +16,8 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/hash.hpp>
+#include <jsoncons/detail/hashed_index.hpp>
 
 // 0x00..0x17 (0..23)
 #define JSONCONS_CBOR_0x00_0x17 \
@@ -82,6 +84,68 @@ size_t min_length_for_stringref(uint64_t index)
     return n;
 }
 
+// stringref_dictionary: the text and byte strings an encoder has numbered for
+// stringref, in the order they were numbered. Their bytes are copied once into
+// an append-only arena, entries refer to them by offset, and a hashed_index over
+// the entries finds them. Text and byte strings with the same bytes are distinct.
+
+template <class Allocator>
+class stringref_dictionary
+{
+public:
+    static constexpr std::size_t npos = (std::numeric_limits<std::size_t>::max)();
+private:
+    struct entry
+    {
+        std::size_t offset;
+        std::size_t length;
+        bool is_text;
+    };
+
+    using byte_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint8_t>;
+    using entry_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<entry>;
+
+    std::vector<uint8_t,byte_allocator_type> arena_;
+    std::vector<entry,entry_allocator_type> entries_;
+    jsoncons::detail::hashed_index<Allocator> index_;
+public:
+    explicit stringref_dictionary(const Allocator& alloc = Allocator())
+        : arena_(alloc), entries_(alloc), index_(alloc)
+    {
+    }
+
+    // The number the next string added will get
+    std::size_t size() const
+    {
+        return entries_.size();
+    }
+
+    // Returns the number of an equal string added before, or adds this one
+    // with the next number and returns npos
+    std::size_t find_or_insert(const uint8_t* data, std::size_t length, bool is_text)
+    {
+        // Different seeds keep text and byte strings with the same bytes from colliding
+        std::size_t hash = jsoncons::detail::hash_bytes(data, length, is_text ? 0 : 0x5bd1e995);
+        std::size_t pos = index_.find(hash, [&](std::size_t i) -> bool
+        {
+            const entry& e = entries_[i];
+            return e.length == length && e.is_text == is_text &&
+                   (length == 0 || std::memcmp(arena_.data() + e.offset, data, length) == 0);
+        });
+        if (pos != npos)
+        {
+            return pos;
+        }
+        entries_.push_back(entry{arena_.size(), length, is_text});
+        arena_.insert(arena_.end(), data, data + length);
+        index_.insert(hash, entries_.size() - 1);
+        return npos;
+    }
+};
+
+template <class Allocator>
+constexpr std::size_t stringref_dictionary<Allocator>::npos;
+
 }}}
 
 #endif
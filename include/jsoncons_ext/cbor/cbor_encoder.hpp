@@ -81,8 +81,6 @@ private:
 
     };
 
-    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const string_type,size_t>> string_size_allocator_type;
-    typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::pair<const byte_string_type,size_t>> byte_string_size_allocator_type;
     typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<stack_item> stack_item_allocator_type;
 
     Sink sink_;
@@ -90,9 +88,7 @@ private:
     allocator_type alloc_;
 
     std::vector<stack_item,stack_item_allocator_type> stack_;
-    std::map<string_type,size_t,std::less<string_type>,string_size_allocator_type> stringref_map_;
-    std::map<byte_string_type,size_t,std::less<byte_string_type>,byte_string_size_allocator_type> bytestringref_map_;
-    std::size_t next_stringref_ = 0;
+    jsoncons::cbor::detail::stringref_dictionary<allocator_type> stringrefs_;
     int nesting_depth_;
 
     // Noncopyable and nonmoveable
@@ -111,10 +107,7 @@ public:
          options_(options), 
          alloc_(alloc),
          stack_(alloc),
-#if !defined(JSONCONS_NO_MAP_TAKING_ALLOCATOR) 
-         stringref_map_(alloc),
-         bytestringref_map_(alloc),
-#endif 
+         stringrefs_(alloc),
          nesting_depth_(0)        
     {
         if (options.pack_strings())
@@ -171,31 +164,19 @@ private:
         } 
         else if (length <= 0xff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0xb8), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xb8, static_cast<uint8_t>(length));
         } 
         else if (length <= 0xffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0xb9), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xb9, static_cast<uint16_t>(length));
         } 
         else if (length <= 0xffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0xba), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xba, static_cast<uint32_t>(length));
         } 
         else if (length <= 0xffffffffffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0xbb), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint64_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xbb, static_cast<uint64_t>(length));
         }
 
         return true;
@@ -257,31 +238,19 @@ private:
         } 
         else if (length <= 0xff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x98), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x98, static_cast<uint8_t>(length));
         } 
         else if (length <= 0xffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x99), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x99, static_cast<uint16_t>(length));
         } 
         else if (length <= 0xffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x9a), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x9a, static_cast<uint32_t>(length));
         } 
         else if (length <= 0xffffffffffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x9b), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint64_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x9b, static_cast<uint64_t>(length));
         }
         return true;
     }
@@ -344,19 +313,17 @@ private:
             JSONCONS_THROW(ser_error(cbor_errc::invalid_utf8_text_string));
         }
 
-        if (options_.pack_strings() && sv.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
+        if (options_.pack_strings() && sv.size() >= jsoncons::cbor::detail::min_length_for_stringref(stringrefs_.size()))
         {
-            string_type s(sv.data(), sv.size(), alloc_);
-            auto it = stringref_map_.find(s);
-            if (it == stringref_map_.end())
+            std::size_t index = stringrefs_.find_or_insert(reinterpret_cast<const uint8_t*>(sv.data()), sv.size(), true);
+            if (index == stringrefs_.npos)
             {
-                stringref_map_.emplace(std::make_pair(std::move(s), next_stringref_++));
                 write_utf8_string(sv);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value(it->second);
+                write_uint64_value(index);
             }
         }
         else
@@ -377,37 +344,22 @@ private:
         }
         else if (length <= 0xff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x78), 
-                                            std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(length), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x78, static_cast<uint8_t>(length));
         }
         else if (length <= 0xffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x79), 
-                                            std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(length), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x79, static_cast<uint16_t>(length));
         }
         else if (length <= 0xffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x7a), 
-                                            std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(length), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x7a, static_cast<uint32_t>(length));
         }
         else if (length <= 0xffffffffffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x7b), 
-                                            std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint64_t>(length), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x7b, static_cast<uint64_t>(length));
         }
 
-        for (auto c : sv)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::sink_append_ref(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
     }
 
     void write_bignum(bigint& n)
@@ -440,37 +392,22 @@ private:
         }
         else if (length <= 0xff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x58), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x58, static_cast<uint8_t>(length));
         }
         else if (length <= 0xffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x59), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x59, static_cast<uint16_t>(length));
         }
         else if (length <= 0xffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x5a), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x5a, static_cast<uint32_t>(length));
         }
         else if (length <= 0xffffffffffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x5b), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint64_t>(length), 
-                                  std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x5b, static_cast<uint64_t>(length));
         }
 
-        for (auto c : data)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::sink_append(sink_, data.data(), data.size());
     }
 
     bool write_decimal_value(const string_view_type& sv, const ser_context& context, std::error_code& ec)
@@ -891,19 +828,17 @@ private:
             default:
                 break;
         }
-        if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
+        if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(stringrefs_.size()))
         {
-            byte_string_type bs(b.data(), b.size(), alloc_);
-            auto it = bytestringref_map_.find(bs);
-            if (it == bytestringref_map_.end())
+            std::size_t index = stringrefs_.find_or_insert(b.data(), b.size(), false);
+            if (index == stringrefs_.npos)
             {
-                bytestringref_map_.emplace(std::make_pair(bs, next_stringref_++));
-                write_byte_string_value(bs);
+                write_byte_string_value(b);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value(it->second);
+                write_uint64_value(index);
             }
         }
         else
@@ -920,20 +855,18 @@ private:
                            const ser_context&,
                            std::error_code&) override
     {
-        if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(next_stringref_))
+        if (options_.pack_strings() && b.size() >= jsoncons::cbor::detail::min_length_for_stringref(stringrefs_.size()))
         {
-            byte_string_type bs(b.data(), b.size(), alloc_);
-            auto it = bytestringref_map_.find(bs);
-            if (it == bytestringref_map_.end())
+            std::size_t index = stringrefs_.find_or_insert(b.data(), b.size(), false);
+            if (index == stringrefs_.npos)
             {
-                bytestringref_map_.emplace(std::make_pair(bs, next_stringref_++));
                 write_tag(ext_tag);
-                write_byte_string_value(bs);
+                write_byte_string_value(b);
             }
             else
             {
                 write_tag(25);
-                write_uint64_value(it->second);
+                write_uint64_value(index);
             }
         }
         else
@@ -946,7 +879,9 @@ private:
         return true;
     }
 
-    void write_byte_string_value(const byte_string_view& b) 
+    // Payloads passed to the visit functions may be referenced by sinks with
+    // append_ref, buffers the encoder builds itself must be copied
+    void write_byte_string_value(const byte_string_view& b, bool is_caller_owned = true) 
     {
         if (b.size() <= 0x17)
         {
@@ -956,36 +891,28 @@ private:
         }
         else if (b.size() <= 0xff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x58), 
-                                            std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(b.size()), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x58, static_cast<uint8_t>(b.size()));
         }
         else if (b.size() <= 0xffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x59), 
-                                            std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(b.size()), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x59, static_cast<uint16_t>(b.size()));
         }
         else if (b.size() <= 0xffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x5a), 
-                                            std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(b.size()), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x5a, static_cast<uint32_t>(b.size()));
         }
         else // if (b.size() <= 0xffffffffffffffff)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0x5b), 
-                                            std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(static_cast<uint64_t>(b.size()), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x5b, static_cast<uint64_t>(b.size()));
         }
 
-        for (auto c : b)
+        if (is_caller_owned)
+        {
+            jsoncons::detail::sink_append_ref(sink_, b.data(), b.size());
+        }
+        else
         {
-            sink_.push_back(c);
+            jsoncons::detail::sink_append(sink_, b.data(), b.size());
         }
     }
 
@@ -1020,15 +947,11 @@ private:
         float valf = (float)val;
         if ((double)valf == val)
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0xfa), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(valf, std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xfa, valf);
         }
         else
         {
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(0xfb), 
-                                  std::back_inserter(sink_));
-            jsoncons::detail::native_to_big(val, std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xfb, val);
         }
 
         // write double
@@ -1062,31 +985,19 @@ private:
             } 
             else if (value <= (std::numeric_limits<uint8_t>::max)())
             {
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(0x18), 
-                                  std::back_inserter(sink_));
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(value), 
-                                  std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0x18, static_cast<uint8_t>(value));
             } 
             else if (value <= (std::numeric_limits<uint16_t>::max)())
             {
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(0x19), 
-                                  std::back_inserter(sink_));
-                jsoncons::detail::native_to_big(static_cast<uint16_t>(value), 
-                                  std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0x19, static_cast<uint16_t>(value));
             } 
             else if (value <= (std::numeric_limits<uint32_t>::max)())
             {
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(0x1a), 
-                                  std::back_inserter(sink_));
-                jsoncons::detail::native_to_big(static_cast<uint32_t>(value), 
-                                  std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0x1a, static_cast<uint32_t>(value));
             } 
             else if (value <= (std::numeric_limits<int64_t>::max)())
             {
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(0x1b), 
-                                  std::back_inserter(sink_));
-                jsoncons::detail::native_to_big(static_cast<int64_t>(value), 
-                                  std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0x1b, static_cast<int64_t>(value));
             }
         } else
         {
@@ -1098,31 +1009,19 @@ private:
             } 
             else if (posnum <= (std::numeric_limits<uint8_t>::max)())
             {
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(0x38), 
-                                  std::back_inserter(sink_));
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(posnum), 
-                                  std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0x38, static_cast<uint8_t>(posnum));
             } 
             else if (posnum <= (std::numeric_limits<uint16_t>::max)())
             {
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(0x39), 
-                                  std::back_inserter(sink_));
-                jsoncons::detail::native_to_big(static_cast<uint16_t>(posnum), 
-                                  std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0x39, static_cast<uint16_t>(posnum));
             } 
             else if (posnum <= (std::numeric_limits<uint32_t>::max)())
             {
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(0x3a), 
-                                  std::back_inserter(sink_));
-                jsoncons::detail::native_to_big(static_cast<uint32_t>(posnum), 
-                                  std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0x3a, static_cast<uint32_t>(posnum));
             } 
             else if (posnum <= (std::numeric_limits<int64_t>::max)())
             {
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(0x3b), 
-                                  std::back_inserter(sink_));
-                jsoncons::detail::native_to_big(static_cast<int64_t>(posnum), 
-                                  std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0x3b, static_cast<int64_t>(posnum));
             }
         }
         end_value();
@@ -1164,21 +1063,15 @@ private:
         } 
         else if (value <=(std::numeric_limits<uint16_t>::max)())
         {
-            sink_.push_back(0xd9);
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(value), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xd9, static_cast<uint16_t>(value));
         }
         else if (value <=(std::numeric_limits<uint32_t>::max)())
         {
-            sink_.push_back(0xda);
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(value), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xda, static_cast<uint32_t>(value));
         }
         else 
         {
-            sink_.push_back(0xdb);
-            jsoncons::detail::native_to_big(static_cast<uint64_t>(value), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0xdb, static_cast<uint64_t>(value));
         }
     }
 
@@ -1195,21 +1088,15 @@ private:
         } 
         else if (value <=(std::numeric_limits<uint16_t>::max)())
         {
-            sink_.push_back(static_cast<uint8_t>(0x19));
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(value), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x19, static_cast<uint16_t>(value));
         } 
         else if (value <=(std::numeric_limits<uint32_t>::max)())
         {
-            sink_.push_back(static_cast<uint8_t>(0x1a));
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(value), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x1a, static_cast<uint32_t>(value));
         } 
         else if (value <=(std::numeric_limits<uint64_t>::max)())
         {
-            sink_.push_back(static_cast<uint8_t>(0x1b));
-            jsoncons::detail::native_to_big(static_cast<uint64_t>(value), 
-                                            std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 0x1b, static_cast<uint64_t>(value));
         }
     }
 
@@ -1274,7 +1161,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1304,7 +1191,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(uint32_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(uint32_t));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1334,7 +1221,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(uint64_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(uint64_t));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1362,7 +1249,7 @@ private:
             write_tag(0x48);
             std::vector<uint8_t> v(data.size()*sizeof(int8_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(int8_t));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1392,7 +1279,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(int16_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(int16_t));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1422,7 +1309,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(int32_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(int32_t));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1452,7 +1339,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(int64_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(int64_t));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1482,7 +1369,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1512,7 +1399,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(float));
             memcpy(v.data(), data.data(), data.size()*sizeof(float));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
@@ -1542,7 +1429,7 @@ private:
                                   tag);
             std::vector<uint8_t> v(data.size()*sizeof(double));
             memcpy(v.data(), data.data(), data.size()*sizeof(double));
-            write_byte_string_value(byte_string_view(v));
+            write_byte_string_value(byte_string_view(v), false);
             return true;
         }
         else
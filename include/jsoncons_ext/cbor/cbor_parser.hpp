@@ -443,7 +443,7 @@ private:
                 {
                     return;
                 }
-                auto result = unicons::validate(text_buffer_.begin(),text_buffer_.end());
+                auto result = unicons::validate(text_buffer_.data(),text_buffer_.data()+text_buffer_.size());
                 if (result.ec != unicons::conv_errc())
                 {
                     ec = cbor_errc::invalid_utf8_text_string;
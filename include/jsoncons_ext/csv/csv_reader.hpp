@@ -235,29 +235,26 @@ private:
     }
     void read_buffer(std::error_code& ec)
     {
-        buffer_.clear();
-        buffer_.resize(buffer_length_);
-        std::size_t count = source_.read(buffer_.data(), buffer_length_);
-        buffer_.resize(static_cast<std::size_t>(count));
-        if (buffer_.size() == 0)
+        auto chunk = source_reader<Src>::read_chunk(source_, buffer_, buffer_length_);
+        if (chunk.size() == 0)
         {
             eof_ = true;
         }
         else if (begin_)
         {
-            auto result = unicons::skip_bom(buffer_.begin(), buffer_.end());
+            auto result = unicons::skip_bom(chunk.begin(), chunk.end());
             if (result.ec != unicons::encoding_errc())
             {
                 ec = result.ec;
                 return;
             }
-            std::size_t offset = result.it - buffer_.begin();
-            parser_.update(buffer_.data()+offset,buffer_.size()-offset);
+            std::size_t offset = result.it - chunk.begin();
+            parser_.update(chunk.data()+offset,chunk.size()-offset);
             begin_ = false;
         }
         else
         {
-            parser_.update(buffer_.data(),buffer_.size());
+            parser_.update(chunk.data(),chunk.size());
         }
     }
 
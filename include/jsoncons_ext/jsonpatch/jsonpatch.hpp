@@ -104,11 +104,9 @@ namespace detail {
 
         Json result = typename Json::array();
 
-        if (source == target)
-        {
-            return result;
-        }
-
+        // Arrays and objects are not compared up front, equal ones produce
+        // no operations below, and comparing at every level of the recursion
+        // would make the diff quadratic in the depth of the documents
         if (source.is_array() && target.is_array())
         {
             std::size_t common = (std::min)(source.size(),target.size());
@@ -183,7 +181,7 @@ namespace detail {
                 }
             }
         }
-        else
+        else if (source != target)
         {
             Json val(json_object_arg);
             val.insert_or_assign(op_literal<char_type>(), replace_literal<char_type>());
@@ -15,6 +15,8 @@
 #include <utility> // std::move
 #include <algorithm> // std::copy
 #include <iterator> // std::back_inserter
+#include <jsoncons/sink.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
 #include <jsoncons_ext/jsonpath/json_query.hpp>
 
 namespace jsoncons { namespace jsonpath {
@@ -24,10 +26,21 @@ namespace jsoncons { namespace jsonpath {
                               Sink& sink)
     {
         std::size_t count = 0;
-        const CharT* begin = s;
         const CharT* end = s + length;
-        for (const CharT* it = begin; it != end; ++it)
+        for (const CharT* it = s; it != end; ++it)
         {
+            const CharT* run_end = jsoncons::detail::find_escape_char(it, end, static_cast<CharT>('\''), false, false);
+            if (run_end != it)
+            {
+                jsoncons::detail::sink_append(sink, it, static_cast<std::size_t>(run_end - it));
+                count += static_cast<std::size_t>(run_end - it);
+                it = run_end;
+                if (it == end)
+                {
+                    break;
+                }
+            }
+
             CharT c = *it;
             switch (c)
             {
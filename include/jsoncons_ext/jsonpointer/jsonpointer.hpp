@@ -18,6 +18,7 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons_ext/jsonpointer/jsonpointer_error.hpp>
 #include <jsoncons/detail/write_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
 
 namespace jsoncons { namespace jsonpointer {
 
@@ -179,8 +180,20 @@ enum class pointer_state
     std::basic_string<CharT> escape_string(const std::basic_string<CharT>& s)
     {
         std::basic_string<CharT> result;
-        for (auto c : s)
+        result.reserve(s.length());
+        const CharT* end = s.data() + s.length();
+        for (const CharT* it = s.data(); it != end; ++it)
         {
+            // Stops at '~' and '/', and also at control characters, which are copied unchanged
+            const CharT* run_end = jsoncons::detail::find_escape_char(it, end, static_cast<CharT>('~'), true, false);
+            result.append(it, run_end);
+            it = run_end;
+            if (it == end)
+            {
+                break;
+            }
+
+            CharT c = *it;
             switch (c)
             {
                 case '~':
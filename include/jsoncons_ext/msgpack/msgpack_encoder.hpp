@@ -131,16 +131,12 @@ namespace msgpack {
             else if (length <= 65535)
             {
                 // map 16
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::map16_cd);
-                jsoncons::detail::native_to_big(static_cast<uint16_t>(length), 
-                                      std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::map16_cd, static_cast<uint16_t>(length));
             }
             else if (length <= 4294967295)
             {
                 // map 32
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::map32_cd);
-                jsoncons::detail::native_to_big(static_cast<uint32_t>(length),
-                                      std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::map32_cd, static_cast<uint32_t>(length));
             }
 
             return true;
@@ -189,14 +185,12 @@ namespace msgpack {
             else if (length <= (std::numeric_limits<uint16_t>::max)())
             {
                 // array 16
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::array16_cd);
-                jsoncons::detail::native_to_big(static_cast<uint16_t>(length),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::array16_cd, static_cast<uint16_t>(length));
             }
             else if (length <= (std::numeric_limits<uint32_t>::max)())
             {
                 // array 32
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::array32_cd);
-                jsoncons::detail::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::array32_cd, static_cast<uint32_t>(length));
             }
             return true;
         }
@@ -246,15 +240,13 @@ namespace msgpack {
                 {
                     // timestamp 32
                     sink_.push_back(jsoncons::msgpack::detail::msgpack_format::fixext4_cd);
-                    sink_.push_back(0xff);
-                    jsoncons::detail::native_to_big(static_cast<uint32_t>(data64), std::back_inserter(sink_));
+                    jsoncons::detail::sink_native_to_big(sink_, 0xff, static_cast<uint32_t>(data64));
                 }
                 else 
                 {
                     // timestamp 64
                     sink_.push_back(jsoncons::msgpack::detail::msgpack_format::fixext8_cd);
-                    sink_.push_back(0xff);
-                    jsoncons::detail::native_to_big(static_cast<uint64_t>(data64), std::back_inserter(sink_));
+                    jsoncons::detail::sink_native_to_big(sink_, 0xff, static_cast<uint64_t>(data64));
                 }
             }
             else 
@@ -262,8 +254,7 @@ namespace msgpack {
                 // timestamp 96
                 sink_.push_back(jsoncons::msgpack::detail::msgpack_format::ext8_cd);
                 sink_.push_back(0x0c); // 12
-                sink_.push_back(0xff);
-                jsoncons::detail::native_to_big(static_cast<uint32_t>(nanoseconds), std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, 0xff, static_cast<uint32_t>(nanoseconds));
                 jsoncons::detail::native_to_big(static_cast<uint64_t>(seconds), std::back_inserter(sink_));
             }
         }
@@ -361,20 +352,15 @@ namespace msgpack {
             else if (length <= (std::numeric_limits<uint16_t>::max)())
             {
                 // str 16 stores a byte array whose length is upto (2^16)-1 bytes
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::str16_cd);
-                jsoncons::detail::native_to_big(static_cast<uint16_t>(length), std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::str16_cd, static_cast<uint16_t>(length));
             }
             else if (length <= (std::numeric_limits<uint32_t>::max)())
             {
                 // str 32 stores a byte array whose length is upto (2^32)-1 bytes
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::str32_cd);
-                jsoncons::detail::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::str32_cd, static_cast<uint32_t>(length));
             }
 
-            for (auto c : sv)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::sink_append_ref(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
         }
 
         bool visit_byte_string(const byte_string_view& b, 
@@ -393,20 +379,15 @@ namespace msgpack {
             else if (length <= (std::numeric_limits<uint16_t>::max)())
             {
                 // bin 16 stores a byte array whose length is upto (2^16)-1 bytes
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::bin16_cd);
-                jsoncons::detail::native_to_big(static_cast<uint16_t>(length), std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::bin16_cd, static_cast<uint16_t>(length));
             }
             else if (length <= (std::numeric_limits<uint32_t>::max)())
             {
                 // bin 32 stores a byte array whose length is upto (2^32)-1 bytes
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::bin32_cd);
-                jsoncons::detail::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::bin32_cd, static_cast<uint32_t>(length));
             }
 
-            for (auto c : b)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::sink_append_ref(sink_, b.data(), b.size());
 
             end_value();
             return true;
@@ -449,23 +430,18 @@ namespace msgpack {
                     }
                     else if (length <= (std::numeric_limits<uint16_t>::max)())
                     {
-                        sink_.push_back(jsoncons::msgpack::detail::msgpack_format::ext16_cd);
-                        jsoncons::detail::native_to_big(static_cast<uint16_t>(length), std::back_inserter(sink_));
+                        jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::ext16_cd, static_cast<uint16_t>(length));
                         sink_.push_back(static_cast<uint8_t>(ext_tag));
                     }
                     else if (length <= (std::numeric_limits<uint32_t>::max)())
                     {
-                        sink_.push_back(jsoncons::msgpack::detail::msgpack_format::ext32_cd);
-                        jsoncons::detail::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
+                        jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::ext32_cd, static_cast<uint32_t>(length));
                         sink_.push_back(static_cast<uint8_t>(ext_tag));
                     }
                     break;
             }
 
-            for (auto c : b)
-            {
-                sink_.push_back(c);
-            }
+            jsoncons::detail::sink_append_ref(sink_, b.data(), b.size());
 
             end_value();
             return true;
@@ -480,14 +456,12 @@ namespace msgpack {
             if ((double)valf == val)
             {
                 // float 32
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::float32_cd);
-                jsoncons::detail::native_to_big(valf,std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::float32_cd, valf);
             }
             else
             {
                 // float 64
-                sink_.push_back(jsoncons::msgpack::detail::msgpack_format::float64_cd);
-                jsoncons::detail::native_to_big(val,std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::float64_cd, val);
             }
 
             // write double
@@ -562,20 +536,17 @@ namespace msgpack {
                         else if (val <= (std::numeric_limits<uint16_t>::max)())
                         {
                             // uint 16 stores a 16-bit big-endian unsigned integer
-                            sink_.push_back(jsoncons::msgpack::detail::msgpack_format::uint16_cd);
-                            jsoncons::detail::native_to_big(static_cast<uint16_t>(val),std::back_inserter(sink_));
+                            jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::uint16_cd, static_cast<uint16_t>(val));
                         }
                         else if (val <= (std::numeric_limits<uint32_t>::max)())
                         {
                             // uint 32 stores a 32-bit big-endian unsigned integer
-                            sink_.push_back(jsoncons::msgpack::detail::msgpack_format::uint32_cd);
-                            jsoncons::detail::native_to_big(static_cast<uint32_t>(val),std::back_inserter(sink_));
+                            jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::uint32_cd, static_cast<uint32_t>(val));
                         }
                         else if (val <= (std::numeric_limits<int64_t>::max)())
                         {
                             // int 64 stores a 64-bit big-endian signed integer
-                            sink_.push_back(jsoncons::msgpack::detail::msgpack_format::uint64_cd);
-                            jsoncons::detail::native_to_big(static_cast<uint64_t>(val),std::back_inserter(sink_));
+                            jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::uint64_cd, static_cast<uint64_t>(val));
                         }
                     }
                     else
@@ -588,26 +559,22 @@ namespace msgpack {
                         else if (val >= (std::numeric_limits<int8_t>::lowest)())
                         {
                             // int 8 stores a 8-bit signed integer
-                            sink_.push_back(jsoncons::msgpack::detail::msgpack_format::int8_cd);
-                            jsoncons::detail::native_to_big(static_cast<int8_t>(val),std::back_inserter(sink_));
+                            jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::int8_cd, static_cast<int8_t>(val));
                         }
                         else if (val >= (std::numeric_limits<int16_t>::lowest)())
                         {
                             // int 16 stores a 16-bit big-endian signed integer
-                            sink_.push_back(jsoncons::msgpack::detail::msgpack_format::int16_cd);
-                            jsoncons::detail::native_to_big(static_cast<int16_t>(val),std::back_inserter(sink_));
+                            jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::int16_cd, static_cast<int16_t>(val));
                         }
                         else if (val >= (std::numeric_limits<int32_t>::lowest)())
                         {
                             // int 32 stores a 32-bit big-endian signed integer
-                            sink_.push_back(jsoncons::msgpack::detail::msgpack_format::int32_cd);
-                            jsoncons::detail::native_to_big(static_cast<int32_t>(val),std::back_inserter(sink_));
+                            jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::int32_cd, static_cast<int32_t>(val));
                         }
                         else if (val >= (std::numeric_limits<int64_t>::lowest)())
                         {
                             // int 64 stores a 64-bit big-endian signed integer
-                            sink_.push_back(jsoncons::msgpack::detail::msgpack_format::int64_cd);
-                            jsoncons::detail::native_to_big(static_cast<int64_t>(val),std::back_inserter(sink_));
+                            jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::int64_cd, static_cast<int64_t>(val));
                         }
                     }
                 }
@@ -681,20 +648,17 @@ namespace msgpack {
                     else if (val <= (std::numeric_limits<uint16_t>::max)())
                     {
                         // uint 16 stores a 16-bit big-endian unsigned integer
-                        sink_.push_back(jsoncons::msgpack::detail::msgpack_format::uint16_cd);
-                        jsoncons::detail::native_to_big(static_cast<uint16_t>(val),std::back_inserter(sink_));
+                        jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::uint16_cd, static_cast<uint16_t>(val));
                     }
                     else if (val <= (std::numeric_limits<uint32_t>::max)())
                     {
                         // uint 32 stores a 32-bit big-endian unsigned integer
-                        sink_.push_back(jsoncons::msgpack::detail::msgpack_format::uint32_cd);
-                        jsoncons::detail::native_to_big(static_cast<uint32_t>(val),std::back_inserter(sink_));
+                        jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::uint32_cd, static_cast<uint32_t>(val));
                     }
                     else if (val <= (std::numeric_limits<uint64_t>::max)())
                     {
                         // uint 64 stores a 64-bit big-endian unsigned integer
-                        sink_.push_back(jsoncons::msgpack::detail::msgpack_format::uint64_cd);
-                        jsoncons::detail::native_to_big(static_cast<uint64_t>(val),std::back_inserter(sink_));
+                        jsoncons::detail::sink_native_to_big(sink_, jsoncons::msgpack::detail::msgpack_format::uint64_cd, static_cast<uint64_t>(val));
                     }
                     break;
                 }
@@ -0,0 +1,65 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PACKED_DECODE_PACKED_HPP
+#define JSONCONS_PACKED_DECODE_PACKED_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <iterator> // std::istreambuf_iterator
+#include <type_traits> // std::enable_if
+#include <istream> // std::basic_istream
+#include <jsoncons/json.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons_ext/packed/packed_view.hpp>
+
+namespace jsoncons { 
+namespace packed {
+
+    template<class T, class Source>
+    typename std::enable_if<is_basic_json<T>::value &&
+                            jsoncons::detail::is_byte_sequence<Source>::value,T>::type 
+    decode_packed(const Source& v, 
+                  const packed_decode_options& options = packed_decode_options())
+    {
+        packed_view view(v);
+        jsoncons::json_decoder<T> decoder;
+        auto adaptor = make_json_visitor_adaptor<json_visitor>(decoder);
+        std::error_code ec;
+        view.root().dump(adaptor, options, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+        if (!decoder.is_valid())
+        {
+            JSONCONS_THROW(ser_error(convert_errc::conversion_failed));
+        }
+        return decoder.get_result();
+    }
+
+    template<class T, class Source>
+    typename std::enable_if<!is_basic_json<T>::value &&
+                            jsoncons::detail::is_byte_sequence<Source>::value,T>::type 
+    decode_packed(const Source& v, 
+                  const packed_decode_options& options = packed_decode_options())
+    {
+        return decode_packed<json>(v, options).template as<T>();
+    }
+
+    template<class T>
+    T decode_packed(std::istream& is, 
+                    const packed_decode_options& options = packed_decode_options())
+    {
+        std::vector<uint8_t> v{std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+        return decode_packed<T>(v, options);
+    }
+
+} // packed
+} // jsoncons
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PACKED_ENCODE_PACKED_HPP
+#define JSONCONS_PACKED_ENCODE_PACKED_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <type_traits> // std::enable_if
+#include <ostream> // std::basic_ostream
+#include <jsoncons/json.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons_ext/packed/packed_encoder.hpp>
+
+namespace jsoncons { 
+namespace packed {
+
+    template<class T, class Container>
+    typename std::enable_if<is_basic_json<T>::value &&
+                            jsoncons::detail::is_back_insertable_byte_container<Container>::value,void>::type 
+    encode_packed(const T& j, 
+                  Container& v, 
+                  const packed_encode_options& options = packed_encode_options())
+    {
+        using char_type = typename T::char_type;
+        basic_packed_encoder<jsoncons::bytes_sink<Container>> encoder(v, options);
+        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
+        j.dump(adaptor);
+    }
+
+    template<class T, class Container>
+    typename std::enable_if<!is_basic_json<T>::value &&
+                            jsoncons::detail::is_back_insertable_byte_container<Container>::value,void>::type 
+    encode_packed(const T& val, 
+                  Container& v, 
+                  const packed_encode_options& options = packed_encode_options())
+    {
+        basic_packed_encoder<jsoncons::bytes_sink<Container>> encoder(v, options);
+        std::error_code ec;
+        encode_traits<T,char>::encode(val, encoder, json(), ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
+    template<class T>
+    typename std::enable_if<is_basic_json<T>::value,void>::type 
+    encode_packed(const T& j, 
+                  std::ostream& os, 
+                  const packed_encode_options& options = packed_encode_options())
+    {
+        using char_type = typename T::char_type;
+        packed_stream_encoder encoder(os, options);
+        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char_type>>(encoder);
+        j.dump(adaptor);
+    }
+
+    template<class T>
+    typename std::enable_if<!is_basic_json<T>::value,void>::type 
+    encode_packed(const T& val, 
+                  std::ostream& os, 
+                  const packed_encode_options& options = packed_encode_options())
+    {
+        packed_stream_encoder encoder(os, options);
+        std::error_code ec;
+        encode_traits<T,char>::encode(val, encoder, json(), ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
+} // packed
+} // jsoncons
+
+#endif
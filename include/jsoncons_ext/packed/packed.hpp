@@ -0,0 +1,22 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PACKED_PACKED_HPP
+#define JSONCONS_PACKED_PACKED_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <type_traits> // std::enable_if
+#include <istream> // std::basic_istream
+#include <jsoncons/json.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons_ext/packed/packed_encoder.hpp>
+#include <jsoncons_ext/packed/packed_view.hpp>
+#include <jsoncons_ext/packed/encode_packed.hpp>
+#include <jsoncons_ext/packed/decode_packed.hpp>
+
+#endif
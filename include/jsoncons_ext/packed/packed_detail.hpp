@@ -0,0 +1,72 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PACKED_PACKED_DETAIL_HPP
+#define JSONCONS_PACKED_PACKED_DETAIL_HPP
+
+#include <cstdint>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons { namespace packed { namespace detail {
+
+// A packed document is
+//
+//     header   "JCPK" version 0 0 0
+//     values   each value is written after its elements, so every
+//              reference points backwards
+//     trailer  uint32 offset of the root value, "KPCJ"
+//
+// All integers are little endian. A value starts with a type byte, if
+// the type byte has the tag_flag bit set it is followed by a semantic_tag
+// byte. Then
+//
+//     null, false, true           nothing
+//     int8 ... uint64, float32,
+//     float64, half               the number
+//     string                      uint32 length, UTF-8 bytes
+//     byte_string                 uint32 length, bytes
+//     byte_string_ext             uint64 ext tag, uint32 length, bytes
+//     array                       uint32 count, count uint32 offsets
+//     object                      uint32 count, count pairs of uint32 key
+//                                 offset and uint32 value offset, sorted by key
+//
+// A key is a uint32 length followed by UTF-8 bytes, and each distinct key
+// is written once.
+
+namespace packed_format
+{
+    const uint8_t null_type = 0x00;
+    const uint8_t false_type = 0x01;
+    const uint8_t true_type = 0x02;
+    const uint8_t int8_type = 0x03;
+    const uint8_t int16_type = 0x04;
+    const uint8_t int32_type = 0x05;
+    const uint8_t int64_type = 0x06;
+    const uint8_t uint8_type = 0x07;
+    const uint8_t uint16_type = 0x08;
+    const uint8_t uint32_type = 0x09;
+    const uint8_t uint64_type = 0x0a;
+    const uint8_t half_type = 0x0b;
+    const uint8_t float32_type = 0x0c;
+    const uint8_t float64_type = 0x0d;
+    const uint8_t string_type = 0x0e;
+    const uint8_t byte_string_type = 0x0f;
+    const uint8_t byte_string_ext_type = 0x10;
+    const uint8_t array_type = 0x11;
+    const uint8_t object_type = 0x12;
+
+    const uint8_t tag_flag = 0x80;
+    const uint8_t type_mask = 0x7f;
+
+    const uint8_t header[8] = {'J','C','P','K',1,0,0,0};
+    const uint8_t trailer_magic[4] = {'K','P','C','J'};
+    const std::size_t header_length = 8;
+    const std::size_t trailer_length = 8;
+}
+ 
+}}}
+
+#endif
@@ -0,0 +1,455 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PACKED_PACKED_ENCODER_HPP
+#define JSONCONS_PACKED_PACKED_ENCODER_HPP
+
+#include <string>
+#include <vector>
+#include <cmath> // std::isinf, std::fabs
+#include <limits> // std::numeric_limits
+#include <memory>
+#include <algorithm> // std::stable_sort, std::unique
+#include <unordered_map>
+#include <utility> // std::move
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/sink.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons_ext/packed/packed_detail.hpp>
+#include <jsoncons_ext/packed/packed_error.hpp>
+#include <jsoncons_ext/packed/packed_options.hpp>
+
+namespace jsoncons { namespace packed {
+
+template<class Sink=jsoncons::binary_stream_sink,class Allocator=std::allocator<char>>
+class basic_packed_encoder final : public basic_json_visitor<char>
+{
+public:
+    using allocator_type = Allocator;
+    using typename basic_json_visitor<char>::string_view_type;
+    using sink_type = Sink;
+
+private:
+    struct stack_item
+    {
+        bool is_object_;
+        semantic_tag tag_;
+        std::size_t first_;
+
+        stack_item(bool is_object, semantic_tag tag, std::size_t first) noexcept
+           : is_object_(is_object), tag_(tag), first_(first)
+        {
+        }
+
+        bool is_object() const
+        {
+            return is_object_;
+        }
+    };
+
+    struct member_item
+    {
+        const std::string* key_;
+        uint32_t key_offset_;
+        uint32_t value_offset_;
+
+        member_item(const std::string* key, uint32_t key_offset) noexcept
+           : key_(key), key_offset_(key_offset), value_offset_(0)
+        {
+        }
+    };
+
+    Sink sink_;
+    const packed_encode_options options_;
+    allocator_type alloc_;
+
+    // Elements and members of all open containers, each container's start at stack_item::first_
+    std::vector<stack_item> stack_;
+    std::vector<uint32_t> elements_;
+    std::vector<member_item> members_;
+
+    // Offsets of the keys written so far, each distinct key is written once
+    std::unordered_map<std::string,uint32_t> keys_;
+    std::string key_buffer_;
+
+    std::size_t position_;
+    int nesting_depth_;
+
+    // Noncopyable and nonmoveable
+    basic_packed_encoder(const basic_packed_encoder&) = delete;
+    basic_packed_encoder& operator=(const basic_packed_encoder&) = delete;
+public:
+    basic_packed_encoder(Sink&& sink,
+                         const Allocator& alloc = Allocator())
+       : basic_packed_encoder(std::forward<Sink>(sink), packed_encode_options(), alloc)
+    {
+    }
+
+    explicit basic_packed_encoder(Sink&& sink,
+                                  const packed_encode_options& options,
+                                  const Allocator& alloc = Allocator())
+       : sink_(std::forward<Sink>(sink)),
+         options_(options),
+         alloc_(alloc),
+         position_(0),
+         nesting_depth_(0)
+    {
+    }
+
+    ~basic_packed_encoder() noexcept
+    {
+        JSONCONS_TRY
+        {
+            sink_.flush();
+        }
+        JSONCONS_CATCH(...)
+        {
+        }
+    }
+
+    void reset()
+    {
+        stack_.clear();
+        elements_.clear();
+        members_.clear();
+        keys_.clear();
+        position_ = 0;
+        nesting_depth_ = 0;
+    }
+
+private:
+    // Implementing methods
+
+    void visit_flush() override
+    {
+        sink_.flush();
+    }
+
+    bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code& ec) override
+    {
+        if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
+        {
+            ec = packed_errc::max_nesting_depth_exceeded;
+            return false;
+        }
+        stack_.emplace_back(true, tag, members_.size());
+        return true;
+    }
+
+    bool visit_begin_object(std::size_t length, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+    {
+        members_.reserve(members_.size() + length);
+        return visit_begin_object(tag, context, ec);
+    }
+
+    bool visit_end_object(const ser_context&, std::error_code& ec) override
+    {
+        JSONCONS_ASSERT(!stack_.empty() && stack_.back().is_object());
+        --nesting_depth_;
+
+        auto first = members_.begin() + stack_.back().first_;
+        std::stable_sort(first, members_.end(),
+                         [](const member_item& a, const member_item& b) {return *a.key_ < *b.key_;});
+        auto last = std::unique(first, members_.end(),
+                                [](const member_item& a, const member_item& b) {return a.key_ == b.key_;});
+
+        std::size_t offset = begin_value(jsoncons::packed::detail::packed_format::object_type, stack_.back().tag_);
+        put_uint32(static_cast<uint32_t>(last - first));
+        for (auto it = first; it != last; ++it)
+        {
+            put_uint32(it->key_offset_);
+            put_uint32(it->value_offset_);
+        }
+        members_.erase(first, members_.end());
+        stack_.pop_back();
+        return end_value(offset, ec);
+    }
+
+    bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code& ec) override
+    {
+        if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
+        {
+            ec = packed_errc::max_nesting_depth_exceeded;
+            return false;
+        }
+        stack_.emplace_back(false, tag, elements_.size());
+        return true;
+    }
+
+    bool visit_begin_array(std::size_t length, semantic_tag tag, const ser_context& context, std::error_code& ec) override
+    {
+        elements_.reserve(elements_.size() + length);
+        return visit_begin_array(tag, context, ec);
+    }
+
+    bool visit_end_array(const ser_context&, std::error_code& ec) override
+    {
+        JSONCONS_ASSERT(!stack_.empty() && !stack_.back().is_object());
+        --nesting_depth_;
+
+        auto first = elements_.begin() + stack_.back().first_;
+        std::size_t offset = begin_value(jsoncons::packed::detail::packed_format::array_type, stack_.back().tag_);
+        put_uint32(static_cast<uint32_t>(elements_.end() - first));
+        for (auto it = first; it != elements_.end(); ++it)
+        {
+            put_uint32(*it);
+        }
+        elements_.erase(first, elements_.end());
+        stack_.pop_back();
+        return end_value(offset, ec);
+    }
+
+    bool visit_key(const string_view_type& name, const ser_context&, std::error_code& ec) override
+    {
+        JSONCONS_ASSERT(!stack_.empty() && stack_.back().is_object());
+
+        key_buffer_.assign(name.data(), name.length());
+        auto it = keys_.find(key_buffer_);
+        if (it == keys_.end())
+        {
+            auto result = unicons::validate(name.begin(), name.end());
+            if (result.ec != unicons::conv_errc())
+            {
+                ec = packed_errc::invalid_utf8_text_string;
+                return false;
+            }
+            put_header();
+            it = keys_.emplace(key_buffer_, static_cast<uint32_t>(position_)).first;
+            put_uint32(static_cast<uint32_t>(name.length()));
+            put_bytes(reinterpret_cast<const uint8_t*>(name.data()), name.length());
+            if (JSONCONS_UNLIKELY(position_ > (std::numeric_limits<uint32_t>::max)()))
+            {
+                ec = packed_errc::document_too_large;
+                return false;
+            }
+        }
+        members_.emplace_back(std::addressof(it->first), it->second);
+        return true;
+    }
+
+    bool visit_null(semantic_tag tag, const ser_context&, std::error_code& ec) override
+    {
+        std::size_t offset = begin_value(jsoncons::packed::detail::packed_format::null_type, tag);
+        return end_value(offset, ec);
+    }
+
+    bool visit_bool(bool val, semantic_tag tag, const ser_context&, std::error_code& ec) override
+    {
+        std::size_t offset = begin_value(val ? jsoncons::packed::detail::packed_format::true_type
+                                             : jsoncons::packed::detail::packed_format::false_type, tag);
+        return end_value(offset, ec);
+    }
+
+    bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code& ec) override
+    {
+        auto result = unicons::validate(sv.begin(), sv.end());
+        if (result.ec != unicons::conv_errc())
+        {
+            ec = packed_errc::invalid_utf8_text_string;
+            return false;
+        }
+
+        std::size_t offset = begin_value(jsoncons::packed::detail::packed_format::string_type, tag);
+        put_uint32(static_cast<uint32_t>(sv.length()));
+        put_bytes(reinterpret_cast<const uint8_t*>(sv.data()), sv.length());
+        return end_value(offset, ec);
+    }
+
+    bool visit_byte_string(const byte_string_view& b,
+                           semantic_tag tag,
+                           const ser_context&,
+                           std::error_code& ec) override
+    {
+        std::size_t offset = begin_value(jsoncons::packed::detail::packed_format::byte_string_type, tag);
+        put_uint32(static_cast<uint32_t>(b.size()));
+        put_bytes(b.data(), b.size());
+        return end_value(offset, ec);
+    }
+
+    bool visit_byte_string(const byte_string_view& b,
+                           uint64_t ext_tag,
+                           const ser_context&,
+                           std::error_code& ec) override
+    {
+        std::size_t offset = begin_value(jsoncons::packed::detail::packed_format::byte_string_ext_type, semantic_tag::none);
+        jsoncons::detail::native_to_little(ext_tag, std::back_inserter(sink_));
+        position_ += sizeof(uint64_t);
+        put_uint32(static_cast<uint32_t>(b.size()));
+        put_bytes(b.data(), b.size());
+        return end_value(offset, ec);
+    }
+
+    bool visit_half(uint16_t val,
+                    semantic_tag tag,
+                    const ser_context&,
+                    std::error_code& ec) override
+    {
+        std::size_t offset = begin_value(jsoncons::packed::detail::packed_format::half_type, tag);
+        put_number(val);
+        return end_value(offset, ec);
+    }
+
+    bool visit_double(double val,
+                      semantic_tag tag,
+                      const ser_context&,
+                      std::error_code& ec) override
+    {
+        std::size_t offset;
+        // Converting a finite double outside the range of float is undefined
+        bool in_float_range = std::isinf(val) || !(std::fabs(val) > (std::numeric_limits<float>::max)());
+        float valf = in_float_range ? static_cast<float>(val) : 0.0f;
+        if (in_float_range && static_cast<double>(valf) == val)
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::float32_type, tag);
+            put_number(valf);
+        }
+        else
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::float64_type, tag);
+            put_number(val);
+        }
+        return end_value(offset, ec);
+    }
+
+    bool visit_int64(int64_t val,
+                     semantic_tag tag,
+                     const ser_context&,
+                     std::error_code& ec) override
+    {
+        std::size_t offset;
+        if (val >= (std::numeric_limits<int8_t>::lowest)() && val <= (std::numeric_limits<int8_t>::max)())
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::int8_type, tag);
+            put_number(static_cast<int8_t>(val));
+        }
+        else if (val >= (std::numeric_limits<int16_t>::lowest)() && val <= (std::numeric_limits<int16_t>::max)())
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::int16_type, tag);
+            put_number(static_cast<int16_t>(val));
+        }
+        else if (val >= (std::numeric_limits<int32_t>::lowest)() && val <= (std::numeric_limits<int32_t>::max)())
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::int32_type, tag);
+            put_number(static_cast<int32_t>(val));
+        }
+        else
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::int64_type, tag);
+            put_number(val);
+        }
+        return end_value(offset, ec);
+    }
+
+    bool visit_uint64(uint64_t val,
+                      semantic_tag tag,
+                      const ser_context&,
+                      std::error_code& ec) override
+    {
+        std::size_t offset;
+        if (val <= (std::numeric_limits<uint8_t>::max)())
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::uint8_type, tag);
+            put_number(static_cast<uint8_t>(val));
+        }
+        else if (val <= (std::numeric_limits<uint16_t>::max)())
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::uint16_type, tag);
+            put_number(static_cast<uint16_t>(val));
+        }
+        else if (val <= (std::numeric_limits<uint32_t>::max)())
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::uint32_type, tag);
+            put_number(static_cast<uint32_t>(val));
+        }
+        else
+        {
+            offset = begin_value(jsoncons::packed::detail::packed_format::uint64_type, tag);
+            put_number(val);
+        }
+        return end_value(offset, ec);
+    }
+
+    void put_header()
+    {
+        if (position_ == 0)
+        {
+            put_bytes(jsoncons::packed::detail::packed_format::header,
+                      jsoncons::packed::detail::packed_format::header_length);
+        }
+    }
+
+    std::size_t begin_value(uint8_t type, semantic_tag tag)
+    {
+        put_header();
+        std::size_t offset = position_;
+        if (tag == semantic_tag::none)
+        {
+            sink_.push_back(type);
+            ++position_;
+        }
+        else
+        {
+            sink_.push_back(type | jsoncons::packed::detail::packed_format::tag_flag);
+            sink_.push_back(static_cast<uint8_t>(tag));
+            position_ += 2;
+        }
+        return offset;
+    }
+
+    bool end_value(std::size_t offset, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(position_ > (std::numeric_limits<uint32_t>::max)()))
+        {
+            ec = packed_errc::document_too_large;
+            return false;
+        }
+        if (stack_.empty())
+        {
+            put_uint32(static_cast<uint32_t>(offset));
+            put_bytes(jsoncons::packed::detail::packed_format::trailer_magic, 4);
+        }
+        else if (stack_.back().is_object())
+        {
+            JSONCONS_ASSERT(members_.size() > stack_.back().first_);
+            members_.back().value_offset_ = static_cast<uint32_t>(offset);
+        }
+        else
+        {
+            elements_.push_back(static_cast<uint32_t>(offset));
+        }
+        return true;
+    }
+
+    template <class T>
+    void put_number(T val)
+    {
+        jsoncons::detail::native_to_little(val, std::back_inserter(sink_));
+        position_ += sizeof(T);
+    }
+
+    void put_uint32(uint32_t val)
+    {
+        put_number(val);
+    }
+
+    void put_bytes(const uint8_t* p, std::size_t length)
+    {
+        for (const uint8_t* end = p + length; p != end; ++p)
+        {
+            sink_.push_back(*p);
+        }
+        position_ += length;
+    }
+};
+
+using packed_stream_encoder = basic_packed_encoder<jsoncons::binary_stream_sink>;
+using packed_bytes_encoder = basic_packed_encoder<jsoncons::bytes_sink<std::vector<uint8_t>>>;
+
+}}
+
+#endif
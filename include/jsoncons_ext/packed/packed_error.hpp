@@ -0,0 +1,84 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PACKED_PACKED_ERROR_HPP
+#define JSONCONS_PACKED_PACKED_ERROR_HPP
+
+#include <system_error>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons { namespace packed {
+
+enum class packed_errc
+{
+    success = 0,
+    invalid_header = 1,
+    invalid_offset,
+    unknown_type,
+    unexpected_eof,
+    document_too_large,
+    invalid_utf8_text_string,
+    max_nesting_depth_exceeded,
+    expansion_limit_exceeded
+};
+
+class packed_error_category_impl
+   : public std::error_category
+{
+public:
+    const char* name() const noexcept override
+    {
+        return "jsoncons/packed";
+    }
+    std::string message(int ev) const override
+    {
+        switch (static_cast<packed_errc>(ev))
+        {
+            case packed_errc::invalid_header:
+                return "Not a packed JSON document";
+            case packed_errc::invalid_offset:
+                return "Reference to a value is out of range";
+            case packed_errc::unknown_type:
+                return "Unknown type";
+            case packed_errc::unexpected_eof:
+                return "Unexpected end of data";
+            case packed_errc::document_too_large:
+                return "Packed document exceeds 4GB";
+            case packed_errc::invalid_utf8_text_string:
+                return "Illegal UTF-8 encoding in text string";
+            case packed_errc::max_nesting_depth_exceeded:
+                return "Data item nesting exceeds limit in options";
+            case packed_errc::expansion_limit_exceeded:
+                return "Shared values expand beyond the size of the document";
+            default:
+                return "Unknown packed JSON error";
+        }
+    }
+};
+
+inline
+const std::error_category& packed_error_category()
+{
+  static packed_error_category_impl instance;
+  return instance;
+}
+
+inline 
+std::error_code make_error_code(packed_errc e)
+{
+    return std::error_code(static_cast<int>(e),packed_error_category());
+}
+
+}}
+
+namespace std {
+    template<>
+    struct is_error_code_enum<jsoncons::packed::packed_errc> : public true_type
+    {
+    };
+}
+
+#endif
@@ -0,0 +1,88 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PACKED_PACKED_OPTIONS_HPP
+#define JSONCONS_PACKED_PACKED_OPTIONS_HPP
+
+#include <cstddef>
+#include <string>
+#include <limits> // std::numeric_limits
+#include <jsoncons/json_exception.hpp>
+
+namespace jsoncons { namespace packed {
+
+class packed_options;
+
+class packed_options_common
+{
+    friend class packed_options;
+
+    int max_nesting_depth_;
+protected:
+    virtual ~packed_options_common() = default;
+
+    packed_options_common()
+        : max_nesting_depth_(1024)
+    {
+    }
+
+    packed_options_common(const packed_options_common&) = default;
+    packed_options_common& operator=(const packed_options_common&) = default;
+    packed_options_common(packed_options_common&&) = default;
+    packed_options_common& operator=(packed_options_common&&) = default;
+public:
+    int max_nesting_depth() const 
+    {
+        return max_nesting_depth_;
+    }
+};
+
+class packed_decode_options : public virtual packed_options_common
+{
+    friend class packed_options;
+    std::size_t max_expansion_ratio_;
+public:
+    packed_decode_options()
+        : max_expansion_ratio_(16)
+    {
+    }
+
+    std::size_t max_expansion_ratio() const 
+    {
+        return max_expansion_ratio_;
+    }
+};
+
+class packed_encode_options : public virtual packed_options_common
+{
+    friend class packed_options;
+public:
+    packed_encode_options()
+    {
+    }
+};
+
+class packed_options final : public packed_decode_options, public packed_encode_options
+{
+public:
+    using packed_options_common::max_nesting_depth;
+    using packed_decode_options::max_expansion_ratio;
+
+    packed_options& max_nesting_depth(int value)
+    {
+        this->max_nesting_depth_ = value;
+        return *this;
+    }
+
+    packed_options& max_expansion_ratio(std::size_t value)
+    {
+        this->max_expansion_ratio_ = value;
+        return *this;
+    }
+};
+
+}}
+#endif
@@ -0,0 +1,903 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PACKED_PACKED_VIEW_HPP
+#define JSONCONS_PACKED_PACKED_VIEW_HPP
+
+#include <cmath> // std::trunc, std::ldexp
+#include <cstring> // std::memcmp
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits> // std::enable_if
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_type.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer_error.hpp>
+#include <jsoncons_ext/packed/packed_detail.hpp>
+#include <jsoncons_ext/packed/packed_error.hpp>
+#include <jsoncons_ext/packed/packed_options.hpp>
+
+namespace jsoncons { namespace packed {
+
+class packed_view;
+
+// A handle to a value in a packed document. Arrays are indexed in constant
+// time, object members are found with a binary search over the sorted keys,
+// and strings are returned as views into the document's bytes.
+//
+// The document may come from an untrusted file, so every read is checked
+// against the bounds of the document, and every reference must point
+// backwards from the value that holds it, which rules out cycles. References
+// may still be shared, which the encoder never does except for keys, so dump
+// charges each value it visits one byte plus its string or byte string
+// length, and fails once the total exceeds the document's length. This keeps
+// a crafted file from expanding exponentially.
+
+class packed_array_iterator;
+class packed_object_iterator;
+
+class packed_value
+{
+    friend class packed_view;
+    friend class packed_object_iterator;
+
+    const uint8_t* data_;
+    std::size_t length_; // end of the values, the trailer is excluded
+    std::size_t offset_;
+
+    packed_value(const uint8_t* data, std::size_t length, std::size_t offset)
+        : data_(data), length_(length), offset_(offset)
+    {
+    }
+public:
+    using string_view_type = jsoncons::string_view;
+
+    packed_value(const packed_value&) = default;
+    packed_value& operator=(const packed_value&) = default;
+
+    json_type type() const
+    {
+        switch (type_code())
+        {
+            case jsoncons::packed::detail::packed_format::null_type:
+                return json_type::null_value;
+            case jsoncons::packed::detail::packed_format::false_type:
+            case jsoncons::packed::detail::packed_format::true_type:
+                return json_type::bool_value;
+            case jsoncons::packed::detail::packed_format::int8_type:
+            case jsoncons::packed::detail::packed_format::int16_type:
+            case jsoncons::packed::detail::packed_format::int32_type:
+            case jsoncons::packed::detail::packed_format::int64_type:
+                return json_type::int64_value;
+            case jsoncons::packed::detail::packed_format::uint8_type:
+            case jsoncons::packed::detail::packed_format::uint16_type:
+            case jsoncons::packed::detail::packed_format::uint32_type:
+            case jsoncons::packed::detail::packed_format::uint64_type:
+                return json_type::uint64_value;
+            case jsoncons::packed::detail::packed_format::half_type:
+                return json_type::half_value;
+            case jsoncons::packed::detail::packed_format::float32_type:
+            case jsoncons::packed::detail::packed_format::float64_type:
+                return json_type::double_value;
+            case jsoncons::packed::detail::packed_format::string_type:
+                return json_type::string_value;
+            case jsoncons::packed::detail::packed_format::byte_string_type:
+            case jsoncons::packed::detail::packed_format::byte_string_ext_type:
+                return json_type::byte_string_value;
+            case jsoncons::packed::detail::packed_format::array_type:
+                return json_type::array_value;
+            case jsoncons::packed::detail::packed_format::object_type:
+                return json_type::object_value;
+            default:
+                JSONCONS_THROW(ser_error(packed_errc::unknown_type, offset_));
+        }
+    }
+
+    semantic_tag tag() const
+    {
+        return (data_[offset_] & jsoncons::packed::detail::packed_format::tag_flag)
+            ? static_cast<semantic_tag>(read<uint8_t>(offset_ + 1))
+            : semantic_tag::none;
+    }
+
+    bool is_null() const
+    {
+        return type() == json_type::null_value;
+    }
+
+    bool is_bool() const
+    {
+        return type() == json_type::bool_value;
+    }
+
+    bool is_int64() const
+    {
+        return type() == json_type::int64_value;
+    }
+
+    bool is_uint64() const
+    {
+        return type() == json_type::uint64_value;
+    }
+
+    bool is_double() const
+    {
+        return type() == json_type::double_value;
+    }
+
+    bool is_number() const
+    {
+        json_type t = type();
+        return t == json_type::int64_value || t == json_type::uint64_value ||
+               t == json_type::half_value || t == json_type::double_value;
+    }
+
+    bool is_string() const
+    {
+        return type() == json_type::string_value;
+    }
+
+    bool is_byte_string() const
+    {
+        return type() == json_type::byte_string_value;
+    }
+
+    bool is_array() const
+    {
+        return type_code() == jsoncons::packed::detail::packed_format::array_type;
+    }
+
+    bool is_object() const
+    {
+        return type_code() == jsoncons::packed::detail::packed_format::object_type;
+    }
+
+    // Number of elements in an array or members in an object, 0 otherwise
+    std::size_t size() const
+    {
+        return (is_array() || is_object()) ? read<uint32_t>(payload()) : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    packed_value at(std::size_t i) const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+        }
+        std::size_t count = container_size(sizeof(uint32_t));
+        if (i >= count)
+        {
+            JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+        }
+        return child(read<uint32_t>(payload() + sizeof(uint32_t) + i*sizeof(uint32_t)));
+    }
+
+    packed_value operator[](std::size_t i) const
+    {
+        return at(i);
+    }
+
+    packed_value at(const string_view_type& key) const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW(not_an_object(key.data(),key.length()));
+        }
+        std::size_t count = container_size(2*sizeof(uint32_t));
+        std::size_t i = lower_bound(key, count);
+        if (i == count || member_key(i) != key)
+        {
+            JSONCONS_THROW(key_not_found(key.data(),key.length()));
+        }
+        return member_value(i);
+    }
+
+    packed_value operator[](const string_view_type& key) const
+    {
+        return at(key);
+    }
+
+    bool contains(const string_view_type& key) const
+    {
+        if (!is_object())
+        {
+            return false;
+        }
+        std::size_t count = container_size(2*sizeof(uint32_t));
+        std::size_t i = lower_bound(key, count);
+        return i != count && member_key(i) == key;
+    }
+
+    packed_object_iterator find(const string_view_type& key) const;
+
+    // Resolves a JSON Pointer (RFC 6901) relative to this value
+    packed_value at_pointer(const string_view_type& location) const
+    {
+        packed_value current = *this;
+        std::string buffer;
+        std::size_t pos = 0;
+        while (pos < location.length())
+        {
+            if (location[pos] != '/')
+            {
+                JSONCONS_THROW(jsonpointer::jsonpointer_error(jsonpointer::jsonpointer_errc::expected_slash));
+            }
+            ++pos;
+            buffer.clear();
+            for (; pos < location.length() && location[pos] != '/'; ++pos)
+            {
+                if (location[pos] == '~')
+                {
+                    if (++pos == location.length() || (location[pos] != '0' && location[pos] != '1'))
+                    {
+                        JSONCONS_THROW(jsonpointer::jsonpointer_error(jsonpointer::jsonpointer_errc::expected_0_or_1));
+                    }
+                    buffer.push_back(location[pos] == '0' ? '~' : '/');
+                }
+                else
+                {
+                    buffer.push_back(location[pos]);
+                }
+            }
+
+            if (current.is_object())
+            {
+                string_view_type key(buffer.data(), buffer.length());
+                std::size_t count = current.container_size(2*sizeof(uint32_t));
+                std::size_t i = current.lower_bound(key, count);
+                if (i == count || current.member_key(i) != key)
+                {
+                    JSONCONS_THROW(jsonpointer::jsonpointer_error(jsonpointer::jsonpointer_errc::name_not_found));
+                }
+                current = current.member_value(i);
+            }
+            else if (current.is_array())
+            {
+                std::size_t index = 0;
+                bool valid = !buffer.empty() && (buffer.length() == 1 || buffer[0] != '0');
+                for (auto it = buffer.begin(); valid && it != buffer.end(); ++it)
+                {
+                    valid = *it >= '0' && *it <= '9' && index <= ((std::numeric_limits<std::size_t>::max)() - 9) / 10;
+                    index = index*10 + static_cast<std::size_t>(*it - '0');
+                }
+                if (!valid)
+                {
+                    JSONCONS_THROW(jsonpointer::jsonpointer_error(jsonpointer::jsonpointer_errc::invalid_index));
+                }
+                if (index >= current.size())
+                {
+                    JSONCONS_THROW(jsonpointer::jsonpointer_error(jsonpointer::jsonpointer_errc::index_exceeds_array_size));
+                }
+                current = current.at(index);
+            }
+            else
+            {
+                JSONCONS_THROW(jsonpointer::jsonpointer_error(jsonpointer::jsonpointer_errc::expected_object_or_array));
+            }
+        }
+        return current;
+    }
+
+    range<packed_array_iterator,packed_array_iterator> array_range() const;
+
+    range<packed_object_iterator,packed_object_iterator> object_range() const;
+
+    // A view of a string value, into the document's bytes
+    string_view_type as_string_view() const
+    {
+        if (type_code() != jsoncons::packed::detail::packed_format::string_type)
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+        }
+        return string_at(payload());
+    }
+
+    byte_string_view as_byte_string_view() const
+    {
+        std::size_t pos = payload();
+        switch (type_code())
+        {
+            case jsoncons::packed::detail::packed_format::byte_string_ext_type:
+                pos += sizeof(uint64_t);
+                JSONCONS_FALLTHROUGH;
+            case jsoncons::packed::detail::packed_format::byte_string_type:
+            {
+                std::size_t length = read<uint32_t>(pos);
+                check(pos + sizeof(uint32_t), length);
+                return byte_string_view(data_ + pos + sizeof(uint32_t), length);
+            }
+            default:
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
+        }
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,bool>::value,T>::type
+    as() const
+    {
+        switch (type_code())
+        {
+            case jsoncons::packed::detail::packed_format::true_type:
+                return true;
+            case jsoncons::packed::detail::packed_format::false_type:
+                return false;
+            default:
+                return as<json>().template as<T>();
+        }
+    }
+
+    template <class T>
+    typename std::enable_if<jsoncons::detail::is_integer<T>::value && !std::is_same<T,bool>::value,T>::type
+    as() const
+    {
+        switch (type())
+        {
+            case json_type::int64_value:
+                return static_cast<T>(int64_value());
+            case json_type::uint64_value:
+                return static_cast<T>(uint64_value());
+            case json_type::double_value:
+            {
+                // Converting a double whose integral part T cannot represent is undefined
+                double val = std::trunc(double_value());
+                const double upper = std::ldexp(1.0, jsoncons::detail::integer_limits<T>::digits);
+                const double lower = jsoncons::detail::integer_limits<T>::is_signed ? -upper : 0.0;
+                if (!(val >= lower && val < upper))
+                {
+                    JSONCONS_THROW(json_runtime_error<std::out_of_range>("Double out of range of integer type"));
+                }
+                return static_cast<T>(val);
+            }
+            default:
+                return as<json>().template as<T>();
+        }
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_floating_point<T>::value,T>::type
+    as() const
+    {
+        switch (type())
+        {
+            case json_type::int64_value:
+                return static_cast<T>(int64_value());
+            case json_type::uint64_value:
+                return static_cast<T>(uint64_value());
+            case json_type::double_value:
+            {
+                // Converting a finite double outside the range of T is undefined, 
+                // saturate to infinity as the floating point conversion would
+                double val = double_value();
+                if (std::fabs(val) > (std::numeric_limits<T>::max)() && !std::isinf(val))
+                {
+                    return val > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
+                }
+                return static_cast<T>(val);
+            }
+            default:
+                return as<json>().template as<T>();
+        }
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,string_view_type>::value,T>::type
+    as() const
+    {
+        return as_string_view();
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_same<T,std::string>::value,T>::type
+    as() const
+    {
+        if (type_code() == jsoncons::packed::detail::packed_format::string_type)
+        {
+            string_view_type sv = string_at(payload());
+            return T(sv.data(), sv.length());
+        }
+        return as<json>().template as<T>();
+    }
+
+    template <class T>
+    typename std::enable_if<is_basic_json<T>::value,T>::type
+    as() const
+    {
+        json_decoder<T> decoder;
+        auto adaptor = make_json_visitor_adaptor<basic_json_visitor<char>>(decoder);
+        dump(adaptor);
+        return decoder.get_result();
+    }
+
+    template <class T>
+    typename std::enable_if<!is_basic_json<T>::value && !std::is_same<T,bool>::value &&
+                            !jsoncons::detail::is_integer<T>::value && !std::is_floating_point<T>::value &&
+                            !std::is_same<T,string_view_type>::value &&
+                            !std::is_same<T,std::string>::value,T>::type
+    as() const
+    {
+        return as<json>().template as<T>();
+    }
+
+    void dump(basic_json_visitor<char>& visitor) const
+    {
+        std::error_code ec;
+        dump(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec, offset_));
+        }
+    }
+
+    void dump(basic_json_visitor<char>& visitor, std::error_code& ec) const
+    {
+        dump(visitor, packed_decode_options(), ec);
+        if (!ec)
+        {
+            visitor.flush();
+        }
+    }
+
+    void dump(basic_json_visitor<char>& visitor, const packed_decode_options& options, std::error_code& ec) const
+    {
+        // Keys are shared by the encoder, so a valid document may visit more 
+        // bytes than it holds, but only a bounded multiple of them
+        std::size_t ratio = options.max_expansion_ratio();
+        std::size_t budget = ratio != 0 && length_ > (std::numeric_limits<std::size_t>::max)() / ratio 
+            ? (std::numeric_limits<std::size_t>::max)() : length_ * ratio;
+        dump_value(visitor, options.max_nesting_depth(), budget, ec);
+    }
+
+private:
+    uint8_t type_code() const
+    {
+        return data_[offset_] & jsoncons::packed::detail::packed_format::type_mask;
+    }
+
+    std::size_t payload() const
+    {
+        return (data_[offset_] & jsoncons::packed::detail::packed_format::tag_flag) ? offset_ + 2 : offset_ + 1;
+    }
+
+    void check(std::size_t pos, std::size_t length) const
+    {
+        if (JSONCONS_UNLIKELY(pos > length_ || length > length_ - pos))
+        {
+            JSONCONS_THROW(ser_error(packed_errc::unexpected_eof, pos));
+        }
+    }
+
+    template <class T>
+    T read(std::size_t pos) const
+    {
+        check(pos, sizeof(T));
+        return jsoncons::detail::little_to_native<T>(data_ + pos, sizeof(T));
+    }
+
+    // Number of entries in this container, checked against the bytes that remain
+    std::size_t container_size(std::size_t entry_length) const
+    {
+        std::size_t count = read<uint32_t>(payload());
+        check(payload() + sizeof(uint32_t), count*entry_length);
+        return count;
+    }
+
+    packed_value child(std::size_t offset) const
+    {
+        if (JSONCONS_UNLIKELY(offset < jsoncons::packed::detail::packed_format::header_length || offset >= offset_))
+        {
+            JSONCONS_THROW(ser_error(packed_errc::invalid_offset, offset_));
+        }
+        return packed_value(data_, length_, offset);
+    }
+
+    string_view_type string_at(std::size_t pos) const
+    {
+        std::size_t length = read<uint32_t>(pos);
+        check(pos + sizeof(uint32_t), length);
+        return string_view_type(reinterpret_cast<const char*>(data_ + pos + sizeof(uint32_t)), length);
+    }
+
+    string_view_type member_key(std::size_t i) const
+    {
+        std::size_t offset = read<uint32_t>(payload() + sizeof(uint32_t) + i*2*sizeof(uint32_t));
+        if (JSONCONS_UNLIKELY(offset < jsoncons::packed::detail::packed_format::header_length || offset >= offset_))
+        {
+            JSONCONS_THROW(ser_error(packed_errc::invalid_offset, offset_));
+        }
+        return string_at(offset);
+    }
+
+    packed_value member_value(std::size_t i) const
+    {
+        return child(read<uint32_t>(payload() + sizeof(uint32_t) + i*2*sizeof(uint32_t) + sizeof(uint32_t)));
+    }
+
+    std::size_t lower_bound(const string_view_type& key, std::size_t count) const
+    {
+        std::size_t first = 0;
+        while (count > 0)
+        {
+            std::size_t step = count / 2;
+            if (member_key(first + step) < key)
+            {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+        return first;
+    }
+
+    int64_t int64_value() const
+    {
+        switch (type_code())
+        {
+            case jsoncons::packed::detail::packed_format::int8_type:
+                return read<int8_t>(payload());
+            case jsoncons::packed::detail::packed_format::int16_type:
+                return read<int16_t>(payload());
+            case jsoncons::packed::detail::packed_format::int32_type:
+                return read<int32_t>(payload());
+            default:
+                return read<int64_t>(payload());
+        }
+    }
+
+    uint64_t uint64_value() const
+    {
+        switch (type_code())
+        {
+            case jsoncons::packed::detail::packed_format::uint8_type:
+                return read<uint8_t>(payload());
+            case jsoncons::packed::detail::packed_format::uint16_type:
+                return read<uint16_t>(payload());
+            case jsoncons::packed::detail::packed_format::uint32_type:
+                return read<uint32_t>(payload());
+            default:
+                return read<uint64_t>(payload());
+        }
+    }
+
+    double double_value() const
+    {
+        return type_code() == jsoncons::packed::detail::packed_format::float32_type
+            ? static_cast<double>(read<float>(payload()))
+            : read<double>(payload());
+    }
+
+    // Takes length bytes from the expansion budget
+    static bool charge(std::size_t& budget, std::size_t length, std::error_code& ec)
+    {
+        if (JSONCONS_UNLIKELY(length > budget))
+        {
+            ec = packed_errc::expansion_limit_exceeded;
+            return false;
+        }
+        budget -= length;
+        return true;
+    }
+
+    bool dump_value(basic_json_visitor<char>& visitor, int depth, std::size_t& budget, std::error_code& ec) const
+    {
+        static const ser_context context{};
+
+        if (!charge(budget, 1, ec))
+        {
+            return false;
+        }
+        semantic_tag tg = tag();
+        switch (type())
+        {
+            case json_type::null_value:
+                return visitor.null_value(tg, context, ec);
+            case json_type::bool_value:
+                return visitor.bool_value(type_code() == jsoncons::packed::detail::packed_format::true_type, tg, context, ec);
+            case json_type::int64_value:
+                return visitor.int64_value(int64_value(), tg, context, ec);
+            case json_type::uint64_value:
+                return visitor.uint64_value(uint64_value(), tg, context, ec);
+            case json_type::half_value:
+                return visitor.half_value(read<uint16_t>(payload()), tg, context, ec);
+            case json_type::double_value:
+                return visitor.double_value(double_value(), tg, context, ec);
+            case json_type::string_value:
+            {
+                string_view_type sv = string_at(payload());
+                return charge(budget, sv.size(), ec) && visitor.string_value(sv, tg, context, ec);
+            }
+            case json_type::byte_string_value:
+            {
+                byte_string_view bytes = as_byte_string_view();
+                if (!charge(budget, bytes.size(), ec))
+                {
+                    return false;
+                }
+                if (type_code() == jsoncons::packed::detail::packed_format::byte_string_ext_type)
+                {
+                    return visitor.byte_string_value(bytes, read<uint64_t>(payload()), context, ec);
+                }
+                return visitor.byte_string_value(bytes, tg, context, ec);
+            }
+            case json_type::array_value:
+            {
+                if (JSONCONS_UNLIKELY(depth <= 0))
+                {
+                    ec = packed_errc::max_nesting_depth_exceeded;
+                    return false;
+                }
+                std::size_t count = container_size(sizeof(uint32_t));
+                bool more = visitor.begin_array(count, tg, context, ec);
+                for (std::size_t i = 0; more && i < count; ++i)
+                {
+                    more = at(i).dump_value(visitor, depth - 1, budget, ec);
+                }
+                return more && visitor.end_array(context, ec);
+            }
+            case json_type::object_value:
+            {
+                if (JSONCONS_UNLIKELY(depth <= 0))
+                {
+                    ec = packed_errc::max_nesting_depth_exceeded;
+                    return false;
+                }
+                std::size_t count = container_size(2*sizeof(uint32_t));
+                bool more = visitor.begin_object(count, tg, context, ec);
+                for (std::size_t i = 0; more && i < count; ++i)
+                {
+                    string_view_type key = member_key(i);
+                    more = charge(budget, key.size(), ec) &&
+                           visitor.key(key, context, ec) &&
+                           member_value(i).dump_value(visitor, depth - 1, budget, ec);
+                }
+                return more && visitor.end_object(context, ec);
+            }
+            default:
+                ec = packed_errc::unknown_type;
+                return false;
+        }
+    }
+};
+
+class packed_array_iterator
+{
+    packed_value parent_;
+    std::size_t index_;
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = packed_value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const packed_value*;
+    using reference = packed_value;
+
+    packed_array_iterator(const packed_value& parent, std::size_t index)
+        : parent_(parent), index_(index)
+    {
+    }
+
+    packed_value operator*() const
+    {
+        return parent_.at(index_);
+    }
+
+    packed_array_iterator& operator++()
+    {
+        ++index_;
+        return *this;
+    }
+
+    packed_array_iterator operator++(int)
+    {
+        packed_array_iterator temp(*this);
+        ++index_;
+        return temp;
+    }
+
+    friend bool operator==(const packed_array_iterator& a, const packed_array_iterator& b)
+    {
+        return a.index_ == b.index_;
+    }
+
+    friend bool operator!=(const packed_array_iterator& a, const packed_array_iterator& b)
+    {
+        return !(a == b);
+    }
+};
+
+class packed_member
+{
+    friend class packed_object_iterator;
+
+    jsoncons::string_view key_;
+    packed_value value_;
+
+    packed_member(const jsoncons::string_view& key, const packed_value& value)
+        : key_(key), value_(value)
+    {
+    }
+public:
+    jsoncons::string_view key() const
+    {
+        return key_;
+    }
+
+    packed_value value() const
+    {
+        return value_;
+    }
+};
+
+class packed_object_iterator
+{
+    friend class packed_value;
+
+    packed_value parent_;
+    std::size_t index_;
+
+    packed_object_iterator(const packed_value& parent, std::size_t index)
+        : parent_(parent), index_(index)
+    {
+    }
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = packed_member;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const packed_member*;
+    using reference = packed_member;
+
+    class proxy
+    {
+        friend class packed_object_iterator;
+
+        packed_member member_;
+
+        proxy(const packed_member& member)
+            : member_(member)
+        {
+        }
+    public:
+        const packed_member* operator->() const
+        {
+            return std::addressof(member_);
+        }
+    };
+
+    packed_member operator*() const
+    {
+        return packed_member(parent_.member_key(index_), parent_.member_value(index_));
+    }
+
+    proxy operator->() const
+    {
+        return proxy(**this);
+    }
+
+    packed_object_iterator& operator++()
+    {
+        ++index_;
+        return *this;
+    }
+
+    packed_object_iterator operator++(int)
+    {
+        packed_object_iterator temp(*this);
+        ++index_;
+        return temp;
+    }
+
+    friend bool operator==(const packed_object_iterator& a, const packed_object_iterator& b)
+    {
+        return a.index_ == b.index_;
+    }
+
+    friend bool operator!=(const packed_object_iterator& a, const packed_object_iterator& b)
+    {
+        return !(a == b);
+    }
+};
+
+inline
+packed_object_iterator packed_value::find(const string_view_type& key) const
+{
+    if (!is_object())
+    {
+        JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+    }
+    std::size_t count = container_size(2*sizeof(uint32_t));
+    std::size_t i = lower_bound(key, count);
+    return (i != count && member_key(i) == key) ? packed_object_iterator(*this, i) : packed_object_iterator(*this, count);
+}
+
+inline
+range<packed_array_iterator,packed_array_iterator> packed_value::array_range() const
+{
+    if (!is_array())
+    {
+        JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+    }
+    return range<packed_array_iterator,packed_array_iterator>(packed_array_iterator(*this, 0), 
+                                                              packed_array_iterator(*this, container_size(sizeof(uint32_t))));
+}
+
+inline
+range<packed_object_iterator,packed_object_iterator> packed_value::object_range() const
+{
+    if (!is_object())
+    {
+        JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+    }
+    return range<packed_object_iterator,packed_object_iterator>(packed_object_iterator(*this, 0), 
+                                                                packed_object_iterator(*this, container_size(2*sizeof(uint32_t))));
+}
+
+// A read only view of a packed document held in memory, for example
+// in a std::vector<uint8_t> or a binary_mmap_source. The bytes must
+// outlive the view and the values obtained from it.
+
+class packed_view
+{
+    const uint8_t* data_;
+    std::size_t length_;
+    std::size_t root_;
+public:
+    packed_view(const uint8_t* data, std::size_t length)
+        : data_(data), length_(length), root_(0)
+    {
+        const std::size_t header_length = jsoncons::packed::detail::packed_format::header_length;
+        const std::size_t trailer_length = jsoncons::packed::detail::packed_format::trailer_length;
+
+        if (length < header_length + 1 + trailer_length ||
+            std::memcmp(data, jsoncons::packed::detail::packed_format::header, header_length) != 0 ||
+            std::memcmp(data + length - 4, jsoncons::packed::detail::packed_format::trailer_magic, 4) != 0)
+        {
+            JSONCONS_THROW(ser_error(packed_errc::invalid_header));
+        }
+        root_ = jsoncons::detail::little_to_native<uint32_t>(data + length - trailer_length, sizeof(uint32_t));
+        if (root_ < header_length || root_ >= length - trailer_length)
+        {
+            JSONCONS_THROW(ser_error(packed_errc::invalid_offset));
+        }
+    }
+
+    template <class Source>
+    explicit packed_view(const Source& source,
+                         typename std::enable_if<jsoncons::detail::is_byte_sequence<Source>::value,int>::type = 0)
+        : packed_view(reinterpret_cast<const uint8_t*>(source.data()), source.size())
+    {
+    }
+
+    packed_value root() const
+    {
+        return packed_value(data_, length_ - jsoncons::packed::detail::packed_format::trailer_length, root_);
+    }
+
+    const uint8_t* data() const
+    {
+        return data_;
+    }
+
+    std::size_t size() const
+    {
+        return length_;
+    }
+};
+
+}}
+
+#endif
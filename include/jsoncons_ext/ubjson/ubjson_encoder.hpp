@@ -236,10 +236,7 @@ private:
 
         put_length(name.length());
 
-        for (auto c : name)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::sink_append(sink_, reinterpret_cast<const uint8_t*>(name.data()), name.size());
         return true;
     }
 
@@ -277,10 +274,7 @@ private:
 
         put_length(sv.length());
 
-        for (auto c : sv)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::sink_append_ref(sink_, reinterpret_cast<const uint8_t*>(sv.data()), sv.size());
 
         end_value();
         return true;
@@ -290,23 +284,19 @@ private:
     {
         if (length <= (std::numeric_limits<uint8_t>::max)())
         {
-            sink_.push_back('U');
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(length), std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 'U', static_cast<uint8_t>(length));
         }
         else if (length <= (std::size_t)(std::numeric_limits<int16_t>::max)())
         {
-            sink_.push_back('I');
-            jsoncons::detail::native_to_big(static_cast<uint16_t>(length), std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 'I', static_cast<uint16_t>(length));
         }
         else if (length <= (uint32_t)(std::numeric_limits<int32_t>::max)())
         {
-            sink_.push_back('l');
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 'l', static_cast<uint32_t>(length));
         }
         else if (length <= (uint64_t)(std::numeric_limits<int64_t>::max)())
         {
-            sink_.push_back('L');
-            jsoncons::detail::native_to_big(static_cast<uint32_t>(length),std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, 'L', static_cast<uint32_t>(length));
         }
     }
 
@@ -318,14 +308,10 @@ private:
 
         const size_t length = b.size();
         sink_.push_back(jsoncons::ubjson::detail::ubjson_format::start_array_marker);
-        jsoncons::detail::native_to_big(static_cast<uint8_t>(jsoncons::ubjson::detail::ubjson_format::type_marker), std::back_inserter(sink_));
-        jsoncons::detail::native_to_big(static_cast<uint8_t>(jsoncons::ubjson::detail::ubjson_format::uint8_type), std::back_inserter(sink_));
+        jsoncons::detail::sink_native_to_big(sink_, static_cast<uint8_t>(jsoncons::ubjson::detail::ubjson_format::type_marker), static_cast<uint8_t>(jsoncons::ubjson::detail::ubjson_format::uint8_type));
         put_length(length);
 
-        for (auto c : b)
-        {
-            sink_.push_back(c);
-        }
+        jsoncons::detail::sink_append_ref(sink_, b.data(), b.size());
 
         end_value();
         return true;
@@ -340,14 +326,12 @@ private:
         if ((double)valf == val)
         {
             // float 32
-            sink_.push_back(static_cast<uint8_t>(jsoncons::ubjson::detail::ubjson_format::float32_type));
-            jsoncons::detail::native_to_big(valf,std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, static_cast<uint8_t>(jsoncons::ubjson::detail::ubjson_format::float32_type), valf);
         }
         else
         {
             // float 64
-            sink_.push_back(static_cast<uint8_t>(jsoncons::ubjson::detail::ubjson_format::float64_type));
-            jsoncons::detail::native_to_big(val,std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, static_cast<uint8_t>(jsoncons::ubjson::detail::ubjson_format::float64_type), val);
         }
 
         // write double
@@ -366,26 +350,22 @@ private:
             if (val <= (std::numeric_limits<uint8_t>::max)())
             {
                 // uint 8 stores a 8-bit unsigned integer
-                sink_.push_back(jsoncons::ubjson::detail::ubjson_format::uint8_type);
-                jsoncons::detail::native_to_big(static_cast<uint8_t>(val),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::uint8_type, static_cast<uint8_t>(val));
             }
             else if (val <= (std::numeric_limits<int16_t>::max)())
             {
                 // uint 16 stores a 16-bit big-endian unsigned integer
-                sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int16_type);
-                jsoncons::detail::native_to_big(static_cast<int16_t>(val),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int16_type, static_cast<int16_t>(val));
             }
             else if (val <= (std::numeric_limits<int32_t>::max)())
             {
                 // uint 32 stores a 32-bit big-endian unsigned integer
-                sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int32_type);
-                jsoncons::detail::native_to_big(static_cast<int32_t>(val),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int32_type, static_cast<int32_t>(val));
             }
             else if (val <= (std::numeric_limits<int64_t>::max)())
             {
                 // int 64 stores a 64-bit big-endian signed integer
-                sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int64_type);
-                jsoncons::detail::native_to_big(static_cast<int64_t>(val),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int64_type, static_cast<int64_t>(val));
             }
             else
             {
@@ -397,26 +377,22 @@ private:
             if (val >= (std::numeric_limits<int8_t>::lowest)())
             {
                 // int 8 stores a 8-bit signed integer
-                sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int8_type);
-                jsoncons::detail::native_to_big(static_cast<int8_t>(val),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int8_type, static_cast<int8_t>(val));
             }
             else if (val >= (std::numeric_limits<int16_t>::lowest)())
             {
                 // int 16 stores a 16-bit big-endian signed integer
-                sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int16_type);
-                jsoncons::detail::native_to_big(static_cast<int16_t>(val),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int16_type, static_cast<int16_t>(val));
             }
             else if (val >= (std::numeric_limits<int32_t>::lowest)())
             {
                 // int 32 stores a 32-bit big-endian signed integer
-                sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int32_type);
-                jsoncons::detail::native_to_big(static_cast<int32_t>(val),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int32_type, static_cast<int32_t>(val));
             }
             else if (val >= (std::numeric_limits<int64_t>::lowest)())
             {
                 // int 64 stores a 64-bit big-endian signed integer
-                sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int64_type);
-                jsoncons::detail::native_to_big(static_cast<int64_t>(val),std::back_inserter(sink_));
+                jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int64_type, static_cast<int64_t>(val));
             }
         }
         end_value();
@@ -430,23 +406,19 @@ private:
     {
         if (val <= (std::numeric_limits<uint8_t>::max)())
         {
-            sink_.push_back(jsoncons::ubjson::detail::ubjson_format::uint8_type);
-            jsoncons::detail::native_to_big(static_cast<uint8_t>(val),std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::uint8_type, static_cast<uint8_t>(val));
         }
         else if (val <= (std::numeric_limits<int16_t>::max)())
         {
-            sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int16_type);
-            jsoncons::detail::native_to_big(static_cast<int16_t>(val),std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int16_type, static_cast<int16_t>(val));
         }
         else if (val <= (std::numeric_limits<int32_t>::max)())
         {
-            sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int32_type);
-            jsoncons::detail::native_to_big(static_cast<int32_t>(val),std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int32_type, static_cast<int32_t>(val));
         }
         else if (val <= (uint64_t)(std::numeric_limits<int64_t>::max)())
         {
-            sink_.push_back(jsoncons::ubjson::detail::ubjson_format::int64_type);
-            jsoncons::detail::native_to_big(static_cast<int64_t>(val),std::back_inserter(sink_));
+            jsoncons::detail::sink_native_to_big(sink_, jsoncons::ubjson::detail::ubjson_format::int64_type, static_cast<int64_t>(val));
         }
         end_value();
         return true;
@@ -2,6 +2,7 @@
 // Distributed under Boost license
 
 #include <jsoncons/json.hpp>
+#include <jsoncons/gather_sink.hpp>
 #include <jsoncons_ext/bson/bson.hpp>
 #include <sstream>
 #include <vector>
@@ -251,3 +252,116 @@ TEST_CASE("serialize object to bson")
     }
 } 
 
+
+TEST_CASE("bson encode with precomputed lengths")
+{
+    ojson j = ojson::parse(R"(
+    {
+        "name" : "collection",
+        "count" : 3000000000,
+        "small" : -7,
+        "ratio" : 0.25,
+        "flag" : true,
+        "nothing" : null,
+        "items" : [ {"a" : [1, 2, [3]]}, {}, [], "text" ],
+        "nested" : {"deeper" : {"deepest" : ["x", "y"]}}
+    }
+    )");
+    j["blob"] = ojson(byte_string_arg, std::vector<uint8_t>(300, 0x11));
+    j["time"] = ojson(1431027667, semantic_tag::epoch_second);
+
+    std::vector<uint8_t> expected;
+    bson::encode_bson(j, expected);
+
+    SECTION("container lengths")
+    {
+        std::vector<uint32_t> lengths = bson::bson_container_lengths(j);
+        // root, items, items[0], items[0].a, items[0].a[2], items[1], items[2], nested, deeper, deepest
+        REQUIRE(lengths.size() == 10);
+        CHECK(lengths[0] == expected.size());
+    }
+
+    SECTION("encode_bson to bytes")
+    {
+        std::vector<uint8_t> v;
+        bson::encode_bson(j, v, bson::bson_options().precompute_lengths(true));
+        CHECK(v == expected);
+    }
+
+    SECTION("encode_bson to stream")
+    {
+        std::ostringstream os;
+        bson::encode_bson(j, os, bson::bson_options().precompute_lengths(true));
+        std::string s = os.str();
+        CHECK(std::vector<uint8_t>(s.begin(), s.end()) == expected);
+    }
+
+    SECTION("encode_traits value")
+    {
+        std::map<std::string, std::vector<int>> m = {{"a", {1,2,3}}, {"b", {}}};
+        std::vector<uint8_t> v1;
+        bson::encode_bson(m, v1);
+        std::vector<uint8_t> v2;
+        bson::encode_bson(m, v2, bson::bson_options().precompute_lengths(true));
+        CHECK(v1 == v2);
+        CHECK((bson::decode_bson<std::map<std::string, std::vector<int>>>(v2) == m));
+    }
+
+    SECTION("lengths of a different value")
+    {
+        ojson other = j;
+        other["name"] = "a longer name";
+        std::vector<uint8_t> v;
+        bson::bson_bytes_encoder encoder(v, bson::bson_container_lengths(j));
+        REQUIRE_THROWS(other.dump(encoder));
+    }
+}
+
+TEST_CASE("bson streaming encoder writes before the document ends")
+{
+    std::string text(1000, 'a');
+    json j;
+    j["text"] = text;
+
+    std::vector<uint32_t> lengths = bson::bson_container_lengths(j);
+
+    std::ostringstream os;
+    bson::bson_stream_encoder encoder(jsoncons::binary_stream_sink(os, 64), lengths);
+    std::error_code ec;
+    encoder.begin_object(semantic_tag::none, ser_context(), ec);
+    encoder.key("text", ser_context(), ec);
+    encoder.string_value(text, semantic_tag::none, ser_context(), ec);
+    REQUIRE_FALSE(ec);
+    CHECK(os.str().size() >= text.size());
+    encoder.end_object(ser_context(), ec);
+    encoder.flush();
+    REQUIRE_FALSE(ec);
+
+    std::string s = os.str();
+    CHECK(bson::decode_bson<json>(std::vector<uint8_t>(s.begin(), s.end())) == j);
+}
+
+TEST_CASE("bson streaming encoder with gather_sink")
+{
+    // Long element names are held by the encoder and must be copied, long
+    // string values may be referenced
+    ojson j(json_object_arg);
+    j[std::string(5000, 'k')] = std::string(5000, 'v');
+    j[std::string(6000, 'n')] = ojson(json_array_arg, {std::string(4096, 'w'), 1});
+
+    std::vector<uint8_t> expected;
+    bson::encode_bson(j, expected);
+
+    std::vector<uint8_t> bytes;
+    {
+        bson::basic_bson_encoder<gather_sink> encoder(gather_sink([&bytes](const gather_segment* segments, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    bytes.insert(bytes.end(), segments[i].data, segments[i].data + segments[i].size);
+                }
+            }), bson::bson_container_lengths(j));
+        j.dump(encoder);
+    }
+    CHECK(bytes == expected);
+}
@@ -415,6 +415,59 @@ TEST_CASE("encode stringref")
     CHECK(j2 == j);
 }
 
+TEST_CASE("encode stringref with many distinct strings")
+{
+    cbor::cbor_options options;
+    options.pack_strings(true);
+
+    SECTION("references past the 1 and 2 byte index thresholds")
+    {
+        ojson j(json_array_arg);
+        for (int pass = 0; pass < 3; ++pass)
+        {
+            for (int i = 0; i < 600; ++i)
+            {
+                j.push_back("string value number " + std::to_string(i));
+            }
+        }
+        std::vector<uint8_t> buf;
+        cbor::encode_cbor(j, buf, options);
+
+        std::vector<uint8_t> unpacked;
+        cbor::encode_cbor(j, unpacked);
+        CHECK(buf.size() < unpacked.size());
+
+        ojson j2 = cbor::decode_cbor<ojson>(buf);
+        CHECK(j2 == j);
+    }
+
+    SECTION("text and byte strings with the same content")
+    {
+        std::vector<uint8_t> bytes = {'a','b','c','d','e','f','g','h'};
+
+        std::vector<uint8_t> buf;
+        cbor::cbor_bytes_encoder encoder(buf, options);
+        encoder.begin_array(4);
+        encoder.string_value("abcdefgh");
+        encoder.byte_string_value(bytes);
+        encoder.string_value("abcdefgh");
+        encoder.byte_string_value(bytes);
+        encoder.end_array();
+        encoder.flush();
+
+        json j = cbor::decode_cbor<json>(buf);
+        REQUIRE(j.size() == 4);
+        CHECK(j[0].is_string());
+        CHECK(j[0].as<std::string>() == "abcdefgh");
+        CHECK(j[1].is_byte_string());
+        CHECK(j[1].as<byte_string>() == byte_string(bytes.data(), bytes.size()));
+        CHECK(j[2].is_string());
+        CHECK(j[2].as<std::string>() == "abcdefgh");
+        CHECK(j[3].is_byte_string());
+        CHECK(j[3].as<byte_string>() == byte_string(bytes.data(), bytes.size()));
+    }
+}
+
 TEST_CASE("cbor encode with semantic_tags")
 {
     SECTION("string")
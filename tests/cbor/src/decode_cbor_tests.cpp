@@ -62,6 +62,49 @@ namespace
         }
     };
 
+    struct allocation_stats
+    {
+        static std::size_t count;
+        static std::size_t max_bytes;
+    };
+    std::size_t allocation_stats::count = 0;
+    std::size_t allocation_stats::max_bytes = 0;
+
+    template <class T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() = default;
+
+        template <class U>
+        counting_allocator(const counting_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            ++allocation_stats::count;
+            allocation_stats::max_bytes = (std::max)(allocation_stats::max_bytes, n*sizeof(T));
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept
+        {
+            return true;
+        }
+
+        friend bool operator!=(const counting_allocator&, const counting_allocator&) noexcept
+        {
+            return false;
+        }
+    };
+
 } // namespace
 
 TEST_CASE("cbor_view_test")
@@ -781,3 +824,41 @@ TEST_CASE("encode decode cbor source")
     }
 }
 
+TEST_CASE("decode_cbor length hints")
+{
+    using decoder_type = json_decoder<json,counting_allocator<char>>;
+
+    SECTION("definite length array")
+    {
+        json j(json_array_arg);
+        for (int i = 0; i < 5000; ++i)
+        {
+            j.push_back(i);
+        }
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(j, data);
+
+        decoder_type decoder;
+        allocation_stats::count = 0;
+        cbor::cbor_bytes_reader reader(data, decoder);
+        reader.read();
+        CHECK(decoder.get_result() == j);
+        // The temporary stack is reserved once for all 5000 elements
+        CHECK(allocation_stats::count == 1);
+    }
+
+    SECTION("hostile length")
+    {
+        // An array that claims 2^32 elements and holds one
+        std::vector<uint8_t> data = {0x9b,0x00,0x00,0x00,0x01,0x00,0x00,0x00,0x00,0x01};
+
+        decoder_type decoder;
+        decoder.length_hint_limit(1000);
+        allocation_stats::max_bytes = 0;
+        cbor::cbor_bytes_reader reader(data, decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+        CHECK(allocation_stats::max_bytes < 2000*sizeof(json)*4);
+    }
+}
@@ -0,0 +1,388 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <jsoncons_ext/packed/packed.hpp>
+#include <catch/catch.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("packed round trip")
+{
+    json j = json::parse(R"(
+{
+    "strings" : ["", "short", "a somewhat longer string value"],
+    "numbers" : [0, 127, -128, 255, 65535, -32769, 4294967296, -9223372036854775808, 18446744073709551615, 1.5, 0.1, 1e300],
+    "literals" : [true, false, null],
+    "nested" : {"empty_array" : [], "empty_object" : {}, "more" : [[1],[{"a":1}]]}
+}
+    )");
+    j["tagged"] = json("123456789012345678901234567890", semantic_tag::bigint);
+    j["bytes"] = json(byte_string_arg, std::vector<uint8_t>{1,2,3}, semantic_tag::base64);
+    j["ext"] = json(byte_string_arg, std::vector<uint8_t>{4,5}, 42);
+
+    std::vector<uint8_t> buffer;
+    packed::encode_packed(j, buffer);
+
+    SECTION("decode")
+    {
+        json k = packed::decode_packed<json>(buffer);
+        CHECK(k == j);
+        CHECK(k["tagged"].tag() == semantic_tag::bigint);
+        CHECK(k["bytes"].tag() == semantic_tag::base64);
+        CHECK(k["ext"].ext_tag() == 42);
+        CHECK(k["numbers"][0].type() == j["numbers"][0].type());
+        CHECK(k["numbers"][2].is_int64());
+        CHECK(k["numbers"][8].is_uint64());
+    }
+
+    SECTION("ojson")
+    {
+        ojson o = packed::decode_packed<ojson>(buffer);
+        CHECK(o.to_string() == j.to_string());
+        CHECK(o["ext"].ext_tag() == 42);
+    }
+
+    SECTION("stream")
+    {
+        std::stringstream ss;
+        packed::encode_packed(j, ss);
+        CHECK(packed::decode_packed<json>(ss) == j);
+    }
+}
+
+TEST_CASE("packed_view navigation")
+{
+    json j = json::parse(R"(
+{
+    "name" : "Tom",
+    "ids" : [10, -20, 30.5],
+    "address" : {"city" : "Toronto", "a/b" : 1, "m~n" : 2},
+    "flag" : true
+}
+    )");
+
+    std::vector<uint8_t> buffer;
+    packed::encode_packed(j, buffer);
+    packed::packed_view view(buffer);
+    packed::packed_value root = view.root();
+
+    SECTION("types")
+    {
+        CHECK(root.is_object());
+        CHECK(root.size() == 4);
+        CHECK(root["ids"].is_array());
+        CHECK(root["ids"][0].is_uint64());
+        CHECK(root["ids"][1].is_int64());
+        CHECK(root["ids"][2].is_double());
+        CHECK(root["name"].is_string());
+        CHECK(root["flag"].is_bool());
+        CHECK(root["address"].type() == json_type::object_value);
+    }
+
+    SECTION("as")
+    {
+        CHECK(root["name"].as<std::string>() == "Tom");
+        CHECK(root["name"].as<string_view>() == "Tom");
+        CHECK(root["ids"][0].as<int>() == 10);
+        CHECK(root["ids"][1].as<int64_t>() == -20);
+        CHECK(root["ids"][2].as<double>() == 30.5);
+        CHECK(root["flag"].as<bool>());
+        CHECK(root["ids"].as<std::vector<double>>() == std::vector<double>{10, -20, 30.5});
+        CHECK(root["address"].as<json>() == j["address"]);
+    }
+
+    SECTION("string views point into the buffer")
+    {
+        string_view sv = root["name"].as_string_view();
+        auto p = reinterpret_cast<const uint8_t*>(sv.data());
+        CHECK(p > buffer.data());
+        CHECK(p < buffer.data() + buffer.size());
+    }
+
+    SECTION("lookup")
+    {
+        CHECK(root.contains("address"));
+        CHECK_FALSE(root.contains("zzz"));
+        CHECK_FALSE(root.contains(""));
+        CHECK(root.find("name")->key() == "name");
+        CHECK((root.find("missing") == root.object_range().end()));
+        CHECK_THROWS(root.at("missing"));
+        CHECK_THROWS(root["ids"].at(3));
+        CHECK_THROWS(root["name"].at(0));
+    }
+
+    SECTION("json pointer")
+    {
+        CHECK(root.at_pointer("").is_object());
+        CHECK(root.at_pointer("/ids/1").as<int>() == -20);
+        CHECK(root.at_pointer("/address/a~1b").as<int>() == 1);
+        CHECK(root.at_pointer("/address/m~0n").as<int>() == 2);
+        CHECK_THROWS_AS(root.at_pointer("/ids/3"), jsonpointer::jsonpointer_error);
+        CHECK_THROWS_AS(root.at_pointer("/ids/01"), jsonpointer::jsonpointer_error);
+        CHECK_THROWS_AS(root.at_pointer("/missing"), jsonpointer::jsonpointer_error);
+        CHECK_THROWS_AS(root.at_pointer("/name/x"), jsonpointer::jsonpointer_error);
+        CHECK_THROWS_AS(root.at_pointer("ids"), jsonpointer::jsonpointer_error);
+    }
+
+    SECTION("iteration")
+    {
+        std::vector<std::string> keys;
+        for (const auto& member : root.object_range())
+        {
+            keys.push_back(std::string(member.key()));
+        }
+        CHECK(keys == std::vector<std::string>{"address","flag","ids","name"});
+
+        std::vector<double> values;
+        for (auto item : root["ids"].array_range())
+        {
+            values.push_back(item.as<double>());
+        }
+        CHECK(values == std::vector<double>{10, -20, 30.5});
+    }
+}
+
+TEST_CASE("packed_encoder from a parser")
+{
+    std::string input = R"([{"identifier":1,"identifier":2},{"identifier":3}])";
+
+    std::vector<uint8_t> buffer;
+    packed::packed_bytes_encoder encoder(buffer);
+    json_reader reader(input, encoder);
+    reader.read();
+
+    packed::packed_view view(buffer);
+
+    // Duplicate keys keep the first, as with json
+    CHECK(view.root()[0]["identifier"].as<int>() == 1);
+    CHECK(view.root()[1]["identifier"].as<int>() == 3);
+
+    // Each distinct key is written once
+    std::string key = "identifier";
+    auto it = std::search(buffer.begin(), buffer.end(), key.begin(), key.end());
+    REQUIRE((it != buffer.end()));
+    CHECK((std::search(it + 1, buffer.end(), key.begin(), key.end()) == buffer.end()));
+}
+
+TEST_CASE("packed_view invalid documents")
+{
+    std::vector<uint8_t> buffer;
+    packed::encode_packed(json::parse(R"({"a":[1,2,3]})"), buffer);
+
+    SECTION("header")
+    {
+        std::vector<uint8_t> v(buffer);
+        v[0] = 'X';
+        CHECK_THROWS_AS(packed::packed_view(v), ser_error);
+        CHECK_THROWS_AS(packed::packed_view(buffer.data(), 4), ser_error);
+    }
+
+    SECTION("truncated")
+    {
+        std::vector<uint8_t> v(buffer.begin(), buffer.end() - 1);
+        CHECK_THROWS_AS(packed::packed_view(v), ser_error);
+    }
+
+    SECTION("root out of range")
+    {
+        std::vector<uint8_t> v(buffer);
+        v[v.size() - 8] = 0xff;
+        v[v.size() - 7] = 0xff;
+        CHECK_THROWS_AS(packed::packed_view(v), ser_error);
+    }
+
+    SECTION("forward reference")
+    {
+        // The root object's only value is the last element of the buffer
+        // before the root, point it at the root itself
+        std::vector<uint8_t> v(buffer);
+        std::size_t root_offset = v[v.size() - 8] | (v[v.size() - 7] << 8);
+        std::size_t value_slot = root_offset + 1 + 4 + 4;
+        v[value_slot] = v[v.size() - 8];
+        v[value_slot + 1] = v[v.size() - 7];
+        packed::packed_view corrupt(v);
+        CHECK_THROWS_AS(corrupt.root()["a"], ser_error);
+        CHECK_THROWS_AS(packed::decode_packed<json>(v), ser_error);
+    }
+}
+
+namespace {
+
+    // Removes a generated file when the test ends
+    struct scoped_file
+    {
+        std::string path;
+
+        explicit scoped_file(const std::string& p)
+            : path(p)
+        {
+        }
+        ~scoped_file()
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+} // namespace
+
+TEST_CASE("packed_view shared subtrees")
+{
+    // Each array holds two references to the one before it, so a document of
+    // a few hundred bytes expands to 2^40 values
+    std::vector<uint8_t> v(packed::detail::packed_format::header, packed::detail::packed_format::header + 8);
+    auto put_uint32 = [&v](uint32_t n)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            v.push_back(static_cast<uint8_t>(n >> (8*i)));
+        }
+    };
+
+    uint32_t previous = static_cast<uint32_t>(v.size());
+    v.push_back(packed::detail::packed_format::null_type);
+    for (int level = 0; level < 40; ++level)
+    {
+        uint32_t offset = static_cast<uint32_t>(v.size());
+        v.push_back(packed::detail::packed_format::array_type);
+        put_uint32(2);
+        put_uint32(previous);
+        put_uint32(previous);
+        previous = offset;
+    }
+    put_uint32(previous);
+    v.insert(v.end(), packed::detail::packed_format::trailer_magic, packed::detail::packed_format::trailer_magic + 4);
+
+    packed::packed_view view(v);
+    CHECK(view.root()[1][0][1].is_array());
+
+    json_decoder<json> decoder;
+    std::error_code ec;
+    view.root().dump(decoder, packed::packed_decode_options(), ec);
+    CHECK(ec == packed::packed_errc::expansion_limit_exceeded);
+    CHECK_THROWS_AS(packed::decode_packed<json>(v), ser_error);
+}
+
+TEST_CASE("packed_view shared keys")
+{
+    // Every member of the object names the same 64KB key
+    std::vector<uint8_t> v(packed::detail::packed_format::header, packed::detail::packed_format::header + 8);
+    auto put_uint32 = [&v](uint32_t n)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            v.push_back(static_cast<uint8_t>(n >> (8*i)));
+        }
+    };
+
+    uint32_t key = static_cast<uint32_t>(v.size());
+    put_uint32(65536);
+    v.insert(v.end(), 65536, 'k');
+    uint32_t value = static_cast<uint32_t>(v.size());
+    v.push_back(packed::detail::packed_format::null_type);
+    uint32_t root = static_cast<uint32_t>(v.size());
+    v.push_back(packed::detail::packed_format::object_type);
+    put_uint32(20000);
+    for (int i = 0; i < 20000; ++i)
+    {
+        put_uint32(key);
+        put_uint32(value);
+    }
+    put_uint32(root);
+    v.insert(v.end(), packed::detail::packed_format::trailer_magic, packed::detail::packed_format::trailer_magic + 4);
+
+    packed::packed_view view(v);
+    CHECK(view.root().size() == 20000);
+
+    json_decoder<json> decoder;
+    std::error_code ec;
+    view.root().dump(decoder, packed::packed_decode_options(), ec);
+    CHECK(ec == packed::packed_errc::expansion_limit_exceeded);
+}
+
+TEST_CASE("packed repeated long keys")
+{
+    // The encoder writes each distinct key once, a valid document may 
+    // visit more bytes than it holds
+    std::string key(100, 'k');
+    json j(json_array_arg);
+    for (int i = 0; i < 1000; ++i)
+    {
+        json member(json_object_arg);
+        member.try_emplace(key, i);
+        j.push_back(std::move(member));
+    }
+    std::vector<uint8_t> buffer;
+    packed::encode_packed(j, buffer);
+    REQUIRE(buffer.size() < 100*1000);
+
+    CHECK(packed::decode_packed<json>(buffer) == j);
+
+    json_decoder<json> decoder;
+    std::error_code ec;
+    packed::packed_view(buffer).root().dump(decoder, packed::packed_options().max_expansion_ratio(1), ec);
+    CHECK(ec == packed::packed_errc::expansion_limit_exceeded);
+}
+
+TEST_CASE("packed doubles to integers")
+{
+    std::vector<double> values = {1e300, -2.5, 2147483647.5, 2147483648.0, -1.0, -0.5};
+    std::vector<uint8_t> buffer;
+    packed::encode_packed(values, buffer);
+
+    packed::packed_view view(buffer);
+    REQUIRE(view.root().size() == values.size());
+    CHECK_THROWS_AS(view.root()[0].as<int>(), std::out_of_range);
+    CHECK_THROWS_AS(view.root()[0].as<int64_t>(), std::out_of_range);
+    CHECK(view.root()[1].as<int>() == -2);
+    CHECK(view.root()[2].as<int>() == 2147483647);
+    CHECK_THROWS_AS(view.root()[3].as<int32_t>(), std::out_of_range);
+    CHECK(view.root()[3].as<int64_t>() == 2147483648);
+    CHECK_THROWS_AS(view.root()[4].as<uint32_t>(), std::out_of_range);
+    CHECK(view.root()[5].as<uint32_t>() == 0);
+
+    CHECK(view.root()[0].as<float>() == std::numeric_limits<float>::infinity());
+    CHECK(view.root()[1].as<float>() == -2.5f);
+}
+
+TEST_CASE("packed doubles outside the range of float")
+{
+    std::vector<double> values = {1e300, -1e300, 3.5e38, -3.5e38, (std::numeric_limits<float>::max)(), 0.5};
+    std::vector<uint8_t> buffer;
+    packed::encode_packed(values, buffer);
+
+    packed::packed_view view(buffer);
+    REQUIRE(view.root().size() == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        CHECK(view.root()[i].as<double>() == values[i]);
+    }
+}
+
+TEST_CASE("packed mmap")
+{
+    scoped_file file("./output/packed_test.pack");
+    const std::string& path = file.path;
+    json j = json::parse(R"({"books":[{"title":"Pulp","price":22.48},{"title":"Cutter's Way","price":18.95}]})");
+    {
+        std::ofstream os(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        packed::encode_packed(j, os);
+    }
+
+    binary_mmap_source source(path);
+    REQUIRE_FALSE(source.is_error());
+    packed::packed_view view(source);
+    CHECK(view.root().at_pointer("/books/1/title").as<std::string>() == "Cutter's Way");
+    CHECK(packed::decode_packed<json>(source) == j);
+}
@@ -0,0 +1,171 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/arena_allocator.hpp>
+#include <catch/catch.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("monotonic_arena tests")
+{
+    monotonic_arena arena(64);
+
+    SECTION("alignment and growth")
+    {
+        void* p1 = arena.allocate(1, 1);
+        void* p2 = arena.allocate(8, 8);
+        void* p3 = arena.allocate(1000, 16);
+        CHECK(p1 != p2);
+        CHECK(reinterpret_cast<std::uintptr_t>(p2) % 8 == 0);
+        CHECK(reinterpret_cast<std::uintptr_t>(p3) % 16 == 0);
+        CHECK(arena.bytes_allocated() == 1009);
+        CHECK(arena.capacity() >= 1009);
+
+        arena.release();
+        CHECK(arena.bytes_allocated() == 0);
+        CHECK(arena.capacity() == 0);
+    }
+
+    SECTION("vector")
+    {
+        std::vector<int,arena_allocator<int>> v{arena_allocator<int>(arena)};
+        for (int i = 0; i < 1000; ++i)
+        {
+            v.push_back(i);
+        }
+        CHECK(v[999] == 999);
+        CHECK(arena.bytes_allocated() >= 1000*sizeof(int));
+    }
+}
+
+TEST_CASE("arena_json tests")
+{
+    std::string input = R"(
+{
+    "books" : [
+        {"title" : "A Wild Sheep Chase", "author" : "Haruki Murakami", "price" : 22.72, "tags" : ["fiction", "japan"]},
+        {"title" : "The Night Watch", "author" : "Sergei Lukyanenko", "price" : 23.58, "tags" : []},
+        {"title" : "The Comedians", "author" : "Graham Greene", "price" : 21.99, "data" : "VGhlIENvbWVkaWFucw", "n" : 18446744073709551615}
+    ]
+}
+    )";
+
+    SECTION("parse")
+    {
+        arena_json_document doc = arena_json_document::parse(input);
+        const arena_json& root = doc.root();
+
+        REQUIRE(root["books"].size() == 3);
+        CHECK(root["books"][0]["author"].as<std::string>() == "Haruki Murakami");
+        CHECK(root["books"][2]["n"].as<uint64_t>() == 18446744073709551615ull);
+        CHECK(root.get_allocator() == doc.get_allocator());
+        CHECK(root["books"][1]["title"].get_allocator() == doc.get_allocator());
+        CHECK(doc.arena().bytes_allocated() > 0);
+
+        std::string s1;
+        root.dump(s1);
+        std::string s2;
+        json::parse(input).dump(s2);
+        CHECK(s1 == s2);
+    }
+
+    SECTION("ojson parse")
+    {
+        arena_ojson_document doc = arena_ojson_document::parse(input);
+        std::string s1;
+        doc.root().dump(s1);
+        std::string s2;
+        ojson::parse(input).dump(s2);
+        CHECK(s1 == s2);
+    }
+
+    SECTION("json_decoder")
+    {
+        arena_json_document doc;
+        {
+            json_decoder<arena_json> decoder(result_allocator_arg, doc.get_allocator());
+            std::istringstream is(input);
+            json_reader reader(is, decoder);
+            reader.read();
+            doc.root() = decoder.get_result();
+        }
+        CHECK(doc.root()["books"][0]["tags"][1].as<std::string>() == "japan");
+    }
+
+    SECTION("copy out of the arena")
+    {
+        arena_json copy;
+        {
+            arena_json_document doc = arena_json_document::parse(input);
+            copy = arena_json(doc.root()["books"][0], arena_allocator<char>());
+            CHECK(copy.get_allocator() != doc.get_allocator());
+            CHECK(copy["tags"].get_allocator().arena() == nullptr);
+        }
+        CHECK(copy["title"].as<std::string>() == "A Wild Sheep Chase");
+        CHECK(copy["tags"][0].as<std::string>() == "fiction");
+    }
+
+    SECTION("copy constructed value outlives its document")
+    {
+        arena_json_document doc = arena_json_document::parse(input);
+        std::unique_ptr<arena_json> copy(new arena_json(doc.root()["books"][0]));
+        CHECK(copy->get_allocator().arena() == nullptr);
+        CHECK((*copy)["tags"].get_allocator().arena() == nullptr);
+        doc = arena_json_document();
+
+        CHECK((*copy)["author"].as<std::string>() == "Haruki Murakami");
+        CHECK((*copy)["tags"][1].as<std::string>() == "japan");
+    }
+
+    SECTION("heap values assigned into the document are freed")
+    {
+        // Leak checkers report the heap allocations if the document does not destroy them
+        arena_json_document doc = arena_json_document::parse(input);
+        arena_json value(json_array_arg, semantic_tag::none, arena_allocator<char>());
+        value.push_back(arena_json("a string too long for short string storage", arena_allocator<char>()));
+        doc.root()["heap"] = value;
+        doc.root()["books"][0]["tags"].push_back(std::move(value));
+        CHECK(doc.root()["books"][0]["tags"][2][0].as<std::string>() == "a string too long for short string storage");
+
+        doc.clear();
+        doc.root() = arena_json(json_array_arg, semantic_tag::none, arena_allocator<char>());
+        doc.root().push_back(arena_json("another string too long for short string storage", arena_allocator<char>()));
+        CHECK(doc.root().size() == 1);
+    }
+
+    SECTION("copy into the arena")
+    {
+        arena_json_document doc;
+        doc.root() = arena_json(json_object_arg, semantic_tag::none, doc.get_allocator());
+        arena_json value(json_array_arg, semantic_tag::none, arena_allocator<char>());
+        value.push_back(arena_json("a string too long for short string storage", arena_allocator<char>()));
+        doc.root().try_emplace("value", value, doc.get_allocator());
+        CHECK(doc.root()["value"].get_allocator() == doc.get_allocator());
+        CHECK(doc.root()["value"][0].as<std::string>() == "a string too long for short string storage");
+        CHECK(doc.root()["value"][0].get_allocator() == doc.get_allocator());
+    }
+
+    SECTION("move and clear")
+    {
+        arena_json_document doc = arena_json_document::parse(input);
+        arena_json_document doc2(std::move(doc));
+        CHECK(doc2.root()["books"].size() == 3);
+
+        doc2.clear();
+        CHECK(doc2.root().empty());
+        CHECK(doc2.arena().bytes_allocated() == 0);
+    }
+
+    SECTION("parse error")
+    {
+        REQUIRE_THROWS_AS(arena_json_document::parse("{\"a\":[1,2,"), ser_error);
+    }
+}
@@ -362,3 +362,26 @@ TEST_CASE("bigint operations")
     }
 }
 
+
+TEST_CASE("bigint string round trip")
+{
+    std::vector<std::string> inputs = {
+        "0",
+        "7",
+        "-42",
+        "18446744073709551615",
+        "18446744073709551616",
+        "10000000000000000000",
+        "100000000000000000000000000000000000000001",
+        "-99999999999999999999999999999999999999999",
+        "123456789012345678901234567890123456789012345678901234567890"
+    };
+    for (const auto& s : inputs)
+    {
+        bigint n = bigint::from_string(s);
+        CHECK(n.to_string() == s);
+    }
+
+    CHECK((bigint::from_string("00012345678901234567890") == bigint::from_string("12345678901234567890")));
+    REQUIRE_THROWS(bigint::from_string("1234567890123x5678901234567890"));
+}
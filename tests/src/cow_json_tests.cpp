@@ -0,0 +1,187 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::string input = R"(
+{
+    "name" : "a string too long for short string storage",
+    "servers" : [
+        {"host" : "alpha.example.com", "port" : 8080, "tags" : ["a","b"]},
+        {"host" : "beta.example.com", "port" : 8081, "tags" : ["c"]}
+    ],
+    "limits" : {"connections" : 100, "timeout" : 30}
+}
+    )";
+
+    template <class Json>
+    const Json& as_const(const Json& j)
+    {
+        return j;
+    }
+
+    std::size_t allocation_count = 0;
+
+    template <class T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() = default;
+
+        template <class U>
+        counting_allocator(const counting_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            ++allocation_count;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept
+        {
+            return true;
+        }
+
+        friend bool operator!=(const counting_allocator&, const counting_allocator&) noexcept
+        {
+            return false;
+        }
+    };
+
+} // namespace
+
+TEMPLATE_TEST_CASE("cow_json copy tests", "", cow_json, cow_ojson)
+{
+    using json_type = TestType;
+
+    json_type doc = json_type::parse(input);
+
+    SECTION("copies share storage")
+    {
+        json_type copy(doc);
+        CHECK(copy == doc);
+        CHECK(&as_const(copy).at("servers")[0] == &as_const(doc).at("servers")[0]);
+        CHECK(as_const(copy).at("name").as_string_view().data() == as_const(doc).at("name").as_string_view().data());
+
+        json_type copy2(doc, doc.get_allocator());
+        CHECK(&as_const(copy2).at("limits").at("timeout") == &as_const(doc).at("limits").at("timeout"));
+    }
+
+    SECTION("modifying a copy")
+    {
+        json_type copy(doc);
+        copy.at("limits").insert_or_assign("timeout", 60);
+        copy.at("servers")[0].at("tags").push_back("z");
+
+        CHECK(doc.at("limits").at("timeout").template as<int>() == 30);
+        CHECK(doc.at("servers")[0].at("tags").size() == 2);
+        CHECK(copy.at("limits").at("timeout").template as<int>() == 60);
+        CHECK(copy.at("servers")[0].at("tags").size() == 3);
+
+        // members that were not modified are still shared
+        CHECK(&as_const(copy).at("servers")[1].at("host") == &as_const(doc).at("servers")[1].at("host"));
+    }
+
+    SECTION("modifying the original")
+    {
+        json_type copy(doc);
+        doc.at("servers").erase(doc.at("servers").array_range().begin());
+        CHECK(doc.at("servers").size() == 1);
+        CHECK(copy.at("servers").size() == 2);
+        CHECK(copy.at("servers")[0].at("host").template as<std::string>() == "alpha.example.com");
+    }
+
+    SECTION("references taken before a copy")
+    {
+        json_type& limits = doc.at("limits");
+        json_type copy(doc);
+        limits.insert_or_assign("connections", 5);
+        CHECK(doc.at("limits").at("connections").template as<int>() == 5);
+        CHECK(copy.at("limits").at("connections").template as<int>() == 100);
+    }
+
+    SECTION("assignment")
+    {
+        json_type copy;
+        copy = doc;
+        doc = json_type();
+        CHECK(copy.at("servers").size() == 2);
+        CHECK(copy.at("name").template as<std::string>() == "a string too long for short string storage");
+    }
+
+    SECTION("copies on several threads")
+    {
+        const json_type& shared = doc;
+        std::vector<std::thread> threads;
+        std::vector<std::size_t> sizes(4);
+        for (std::size_t i = 0; i < sizes.size(); ++i)
+        {
+            threads.emplace_back([&shared,&sizes,i]()
+            {
+                for (int k = 0; k < 100; ++k)
+                {
+                    json_type copy(shared);
+                    copy.at("servers").push_back(json_type());
+                    sizes[i] = copy.at("servers").size();
+                }
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        for (auto n : sizes)
+        {
+            CHECK(n == 3);
+        }
+        CHECK(doc.at("servers").size() == 2);
+    }
+}
+
+TEMPLATE_TEST_CASE("cow_json destroying a copy does not copy shared storage", "", cow_sorted_policy, cow_preserve_order_policy)
+{
+    using json_type = basic_json<char,TestType,counting_allocator<char>>;
+
+    json_type doc(json_array_arg);
+    for (int i = 0; i < 1000; ++i)
+    {
+        json_type item(json_array_arg);
+        item.push_back(i);
+        item.push_back(i+1);
+        item.push_back(i+2);
+        json_type member(json_object_arg);
+        member.try_emplace("item", std::move(item));
+        doc.push_back(std::move(member));
+    }
+
+    {
+        // The copy gets its own top level array, the elements stay shared with doc
+        json_type copy(doc);
+        copy.push_back(json_type());
+        CHECK(copy.size() == 1001);
+
+        allocation_count = 0;
+    }
+    CHECK(allocation_count == 0);
+    CHECK(doc.size() == 1000);
+    CHECK(as_const(doc)[999].at("item")[2].template as<int>() == 1001);
+}
@@ -0,0 +1,71 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+#include <catch/catch.hpp>
+#include <string>
+
+using namespace jsoncons;
+
+TEST_CASE("detail::find_string_special tests")
+{
+    SECTION("stops at each special character at every offset")
+    {
+        const std::string specials = std::string("\"\\\x01\x1f") + '\0';
+        for (char c : specials)
+        {
+            for (std::size_t i = 0; i < 70; ++i)
+            {
+                std::string s(70, 'a');
+                s[i] = c;
+                const char* p = jsoncons::detail::find_string_special(s.data(), s.data() + s.size());
+                CHECK(p == s.data() + i);
+            }
+        }
+    }
+    SECTION("non-ASCII bytes are not special")
+    {
+        std::string s(40, '\xC3');
+        s.push_back('\"');
+        const char* p = jsoncons::detail::find_string_special(s.data(), s.data() + s.size());
+        CHECK(p == s.data() + 40);
+    }
+    SECTION("no special character")
+    {
+        std::string s(45, ' ');
+        const char* p = jsoncons::detail::find_string_special(s.data(), s.data() + s.size());
+        CHECK(p == s.data() + s.size());
+    }
+    SECTION("wide characters")
+    {
+        std::wstring s(20, L'a');
+        s[17] = L'\\';
+        const wchar_t* p = jsoncons::detail::find_string_special(s.data(), s.data() + s.size());
+        CHECK(p == s.data() + 17);
+    }
+}
+
+TEST_CASE("detail::skip_blanks and skip_digits tests")
+{
+    SECTION("skip_blanks")
+    {
+        for (std::size_t i = 0; i < 40; ++i)
+        {
+            std::string s(i, ' ');
+            s.append("\t \t}");
+            const char* p = jsoncons::detail::skip_blanks(s.data(), s.data() + s.size());
+            CHECK(p == s.data() + s.size() - 1);
+        }
+    }
+    SECTION("skip_digits")
+    {
+        for (std::size_t i = 0; i < 40; ++i)
+        {
+            std::string s(i, '7');
+            s.push_back('.');
+            const char* p = jsoncons::detail::skip_digits(s.data(), s.data() + s.size());
+            CHECK(p == s.data() + i);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/small_vector.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("detail::small_vector tests")
+{
+    using vector_type = jsoncons::detail::small_vector<std::string,std::allocator<std::string>,4*sizeof(std::string)>;
+
+    SECTION("grow onto the heap")
+    {
+        vector_type v;
+        for (int i = 0; i < 4; ++i)
+        {
+            v.push_back(std::to_string(i));
+        }
+        CHECK(v.capacity() == 4);
+        v.push_back("4");
+        CHECK(v.size() == 5);
+        CHECK(v.capacity() >= 5);
+        for (std::size_t i = 0; i < v.size(); ++i)
+        {
+            CHECK(v[i] == std::to_string(i));
+        }
+
+        v.erase(v.begin() + 1, v.begin() + 3);
+        REQUIRE(v.size() == 3);
+        CHECK(v[1] == "3");
+        v.shrink_to_fit();
+        CHECK(v.capacity() == 4);
+        CHECK(v.back() == "4");
+    }
+
+    SECTION("emplace_back with an element of the vector")
+    {
+        vector_type v{"a string too long for short string storage", "b", "c", "d"};
+        v.emplace_back(v[0]);
+        CHECK(v[4] == "a string too long for short string storage");
+        v.emplace(v.begin(), v[4]);
+        CHECK(v[0] == v[5]);
+        CHECK(v.size() == 6);
+    }
+
+    SECTION("insert")
+    {
+        vector_type v{"a", "d"};
+        std::vector<std::string> u{"b", "c"};
+        v.insert(v.begin() + 1, u.begin(), u.end());
+        v.insert(v.end(), "e");
+        CHECK(v == vector_type({"a", "b", "c", "d", "e"}));
+    }
+
+    SECTION("move and swap")
+    {
+        vector_type small{"a", "b"};
+        vector_type large{"1", "2", "3", "4", "5", "6"};
+
+        vector_type v(std::move(large));
+        CHECK(v.size() == 6);
+        CHECK(large.empty());
+
+        v.swap(small);
+        CHECK(v == vector_type({"a", "b"}));
+        CHECK(small.size() == 6);
+        CHECK(small[5] == "6");
+
+        v = small;
+        CHECK(v == small);
+        small = std::move(v);
+        CHECK(small.size() == 6);
+    }
+
+    SECTION("resize")
+    {
+        vector_type v(2, "x");
+        v.resize(6, "y");
+        CHECK(v[1] == "x");
+        CHECK(v[5] == "y");
+        v.resize(1);
+        CHECK(v == vector_type(1, "x"));
+        REQUIRE_THROWS_AS(v.at(1), std::out_of_range);
+    }
+}
+
+TEST_CASE("compact_json tests")
+{
+    std::string input = R"(
+{
+    "books" : [
+        {"title" : "A Wild Sheep Chase", "author" : "Haruki Murakami", "price" : 22.72, "tags" : ["fiction", "japan"]},
+        {"title" : "The Night Watch", "author" : "Sergei Lukyanenko", "price" : 23.58, "tags" : []},
+        {"title" : "The Comedians", "author" : "Graham Greene", "price" : 21.99, "a" : 1, "b" : 2, "c" : 3, "d" : 4, "e" : 5}
+    ]
+}
+    )";
+
+    SECTION("parse")
+    {
+        std::string s1;
+        compact_json::parse(input).dump(s1);
+        std::string s2;
+        json::parse(input).dump(s2);
+        CHECK(s1 == s2);
+
+        std::string s3;
+        compact_ojson::parse(input).dump(s3);
+        std::string s4;
+        ojson::parse(input).dump(s4);
+        CHECK(s3 == s4);
+    }
+
+    SECTION("modify")
+    {
+        compact_ojson j = compact_ojson::parse(input);
+        compact_ojson& book = j["books"][2];
+        book.erase("b");
+        book.insert_or_assign("f", 6);
+        book.try_emplace("g", 7);
+        CHECK(book.size() == 9);
+        CHECK(book["f"].as<int>() == 6);
+        CHECK(book.contains("c"));
+        CHECK_FALSE(book.contains("b"));
+
+        compact_ojson& tags = j["books"][0]["tags"];
+        for (int i = 0; i < 20; ++i)
+        {
+            tags.push_back(i);
+        }
+        tags.erase(tags.array_range().begin(), tags.array_range().begin() + 2);
+        CHECK(tags.size() == 20);
+        CHECK(tags[0].as<int>() == 0);
+
+        compact_ojson copy(j);
+        CHECK(copy == j);
+    }
+}
@@ -98,3 +98,88 @@ TEST_CASE("detail::to_integer_decimal tests")
     }
 }
 
+
+TEST_CASE("detail::to_integer eight digits at a time")
+{
+    SECTION("max uint64_t")
+    {
+        std::string s = "18446744073709551615";
+        auto result = jsoncons::detail::to_integer_decimal<uint64_t>(s.data(), s.length());
+        REQUIRE(result);
+        CHECK(result.value() == (std::numeric_limits<uint64_t>::max)());
+
+        auto result2 = jsoncons::detail::to_integer_unchecked<uint64_t>(s.data(), s.length());
+        REQUIRE(result2);
+        CHECK(result2.value() == (std::numeric_limits<uint64_t>::max)());
+    }
+    SECTION("max uint64_t + 1")
+    {
+        std::string s = "18446744073709551616";
+        auto result = jsoncons::detail::to_integer_decimal<uint64_t>(s.data(), s.length());
+        REQUIRE_FALSE(result);
+        CHECK(result.error() == jsoncons::detail::to_integer_errc::overflow);
+
+        auto result2 = jsoncons::detail::to_integer_unchecked<uint64_t>(s.data(), s.length());
+        REQUIRE_FALSE(result2);
+        CHECK(result2.error() == jsoncons::detail::to_integer_errc::overflow);
+    }
+    SECTION("min int64_t unchecked")
+    {
+        std::string s = "-9223372036854775808";
+        auto result = jsoncons::detail::to_integer_unchecked<int64_t>(s.data(), s.length());
+        REQUIRE(result);
+        CHECK(result.value() == (std::numeric_limits<int64_t>::min)());
+
+        s = "-9223372036854775809";
+        result = jsoncons::detail::to_integer_unchecked<int64_t>(s.data(), s.length());
+        REQUIRE_FALSE(result);
+        CHECK(result.error() == jsoncons::detail::to_integer_errc::overflow);
+    }
+    SECTION("invalid digit within a block")
+    {
+        std::string s = "1234567a90123456";
+        auto result = jsoncons::detail::to_integer_decimal<uint64_t>(s.data(), s.length());
+        REQUIRE_FALSE(result);
+        CHECK(result.error() == jsoncons::detail::to_integer_errc::invalid_digit);
+
+        s = "12345678:0123456";
+        result = jsoncons::detail::to_integer<uint64_t>(s.data(), s.length());
+        REQUIRE_FALSE(result);
+        CHECK(result.error() == jsoncons::detail::to_integer_errc::invalid_digit);
+    }
+    SECTION("uint32_t overflow")
+    {
+        std::string s = "4294967295";
+        auto result = jsoncons::detail::to_integer_decimal<uint32_t>(s.data(), s.length());
+        REQUIRE(result);
+        CHECK(result.value() == (std::numeric_limits<uint32_t>::max)());
+
+        s = "4294967296";
+        result = jsoncons::detail::to_integer_decimal<uint32_t>(s.data(), s.length());
+        REQUIRE_FALSE(result);
+        CHECK(result.error() == jsoncons::detail::to_integer_errc::overflow);
+    }
+    SECTION("round trip with from_integer")
+    {
+        uint64_t u = 1;
+        for (int i = 0; i < 64; ++i)
+        {
+            int64_t values[] = {static_cast<int64_t>(u), static_cast<int64_t>(0 - u), static_cast<int64_t>(u - 1), static_cast<int64_t>(u*7/3)};
+            for (int64_t val : values)
+            {
+                std::string s;
+                jsoncons::detail::from_integer(val, s);
+                CHECK(s == std::to_string(val));
+
+                auto result = jsoncons::detail::to_integer_decimal<int64_t>(s.data(), s.length());
+                REQUIRE(result);
+                CHECK(result.value() == val);
+
+                auto result2 = jsoncons::detail::to_integer_unchecked<int64_t>(s.data(), s.length());
+                REQUIRE(result2);
+                CHECK(result2.value() == val);
+            }
+            u <<= 1;
+        }
+    }
+}
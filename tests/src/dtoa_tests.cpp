@@ -6,6 +6,12 @@
 #include <catch/catch.hpp>
 #include <iostream>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
 
 using namespace jsoncons;
 
@@ -98,3 +104,83 @@ TEST_CASE("test grisu3")
     check_dtoa(0.000071, {"7.1e-05"}); 
 }
 
+
+static void check_scientific(double x, const std::string& expected)
+{
+    std::string s;
+    REQUIRE(jsoncons::detail::dtoa_scientific(x, '.', s));
+    CHECK(s == expected);
+
+    std::string t;
+    REQUIRE(jsoncons::detail::dtoa_scientific(x, '.', t, std::false_type()));
+    CHECK(std::strtod(t.c_str(), nullptr) == x);
+}
+
+static void check_fixed(double x, const std::string& expected)
+{
+    std::string s;
+    REQUIRE(jsoncons::detail::dtoa_fixed(x, '.', s));
+    CHECK(s == expected);
+}
+
+TEST_CASE("test ryu")
+{
+    SECTION("scientific")
+    {
+        check_scientific(1.0e100, "1e+100");
+        check_scientific(-1.0e-100, "-1e-100");
+        check_scientific(1234563, "1.234563e+06");
+        check_scientific(0.000071, "7.1e-05");
+        check_scientific(0.1, "1e-01");
+        check_scientific(42.229999999999997, "4.223e+01");
+        check_scientific(5e-324, "5e-324");
+        check_scientific(1.7976931348623157e308, "1.7976931348623157e+308");
+    }
+    SECTION("fixed")
+    {
+        check_fixed(1234563, "1234563.0");
+        check_fixed(0.000071, "0.000071");
+        check_fixed(-36.973846435546875, "-36.973846435546875");
+        check_fixed(1.0e21, "1000000000000000000000.0");
+    }
+    SECTION("shortest round trip")
+    {
+        std::vector<std::pair<double,std::string>> cases = {
+            {5e-324, "5e-324"},
+            {2.2250738585072014e-308, "2.2250738585072014e-308"},
+            {1.7976931348623157e308, "1.7976931348623157e+308"},
+            {9007199254740993.0, "9007199254740992.0"},
+            {5.0e-7, "5e-07"},
+            {123456789012345680.0, "1.2345678901234568e+17"}
+        };
+        for (const auto& item : cases)
+        {
+            std::string s;
+            REQUIRE(jsoncons::detail::dtoa_general(item.first, '.', s));
+            CHECK(s == item.second);
+        }
+    }
+    SECTION("random")
+    {
+        std::mt19937_64 gen(20201017);
+        std::uniform_int_distribution<uint64_t> bits;
+        for (std::size_t i = 0; i < 100000; ++i)
+        {
+            uint64_t u = bits(gen);
+            double x;
+            std::memcpy(&x, &u, sizeof(x));
+            if (!std::isfinite(x))
+            {
+                continue;
+            }
+            std::string s;
+            REQUIRE(jsoncons::detail::dtoa_general(x, '.', s));
+            double y = std::strtod(s.c_str(), nullptr);
+            if (y != x)
+            {
+                std::cout << "dtoa_general does not round trip " << s << "\n";
+            }
+            CHECK(y == x);
+        }
+    }
+}
@@ -0,0 +1,173 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/gather_sink.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <cstdio>
+#include <vector>
+#include <string>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+using namespace jsoncons;
+
+namespace {
+
+    struct segment_collector
+    {
+        std::vector<uint8_t>* bytes;
+        std::vector<gather_segment>* referenced;
+        const uint8_t* payload;
+
+        void operator()(const gather_segment* segments, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (segments[i].data == payload)
+                {
+                    referenced->push_back(segments[i]);
+                }
+                bytes->insert(bytes->end(), segments[i].data, segments[i].data + segments[i].size);
+            }
+        }
+    };
+
+    json blob_message(std::size_t blob_size)
+    {
+        json j;
+        j["id"] = 42;
+        j["name"] = "image.png";
+        j["blob"] = json(byte_string_arg, std::vector<uint8_t>(blob_size, 0xab));
+        j["tags"] = json(json_array_arg, {"a","b","c"});
+        return j;
+    }
+}
+
+TEST_CASE("gather_sink cbor")
+{
+    json j = blob_message(100000);
+    const uint8_t* payload = j["blob"].as_byte_string_view().data();
+
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(j, expected);
+
+    SECTION("large payload is referenced, not copied")
+    {
+        std::vector<uint8_t> bytes;
+        std::vector<gather_segment> referenced;
+        {
+            cbor::basic_cbor_encoder<gather_sink> encoder(gather_sink(segment_collector{&bytes, &referenced, payload}));
+            j.dump(encoder);
+        }
+        CHECK(bytes == expected);
+        REQUIRE(referenced.size() == 1);
+        CHECK(referenced[0].size == 100000);
+    }
+
+    SECTION("small payloads are copied")
+    {
+        json small = blob_message(100);
+        const uint8_t* small_payload = small["blob"].as_byte_string_view().data();
+        std::vector<uint8_t> small_expected;
+        cbor::encode_cbor(small, small_expected);
+
+        std::vector<uint8_t> bytes;
+        std::vector<gather_segment> referenced;
+        {
+            cbor::basic_cbor_encoder<gather_sink> encoder(gather_sink(segment_collector{&bytes, &referenced, small_payload}));
+            small.dump(encoder);
+        }
+        CHECK(bytes == small_expected);
+        CHECK(referenced.empty());
+    }
+
+    SECTION("buffer smaller than the output")
+    {
+        std::vector<uint8_t> bytes;
+        std::vector<gather_segment> referenced;
+        {
+            cbor::basic_cbor_encoder<gather_sink> encoder(gather_sink(segment_collector{&bytes, &referenced, payload}, 16, 8));
+            j.dump(encoder);
+        }
+        CHECK(bytes == expected);
+        CHECK(referenced.size() == 1);
+    }
+}
+
+TEST_CASE("gather_sink cbor typed arrays")
+{
+    // The encoder packs the elements into a temporary buffer, which must be
+    // copied rather than referenced
+    std::vector<uint16_t> v(4000);
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = static_cast<uint16_t>(i);
+    }
+    auto options = cbor::cbor_options{}.use_typed_arrays(true);
+
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(v, expected, options);
+
+    std::vector<uint8_t> bytes;
+    std::vector<gather_segment> referenced;
+    {
+        cbor::basic_cbor_encoder<gather_sink> encoder(gather_sink(segment_collector{&bytes, &referenced, nullptr}), options);
+        std::error_code ec;
+        encode_traits<std::vector<uint16_t>,char>::encode(v, encoder, json(), ec);
+        REQUIRE_FALSE(ec);
+    }
+    CHECK(bytes == expected);
+    CHECK(cbor::decode_cbor<std::vector<uint16_t>>(bytes) == v);
+}
+
+TEST_CASE("gather_sink msgpack")
+{
+    json j = blob_message(70000);
+    const uint8_t* payload = j["blob"].as_byte_string_view().data();
+
+    std::vector<uint8_t> expected;
+    msgpack::encode_msgpack(j, expected);
+
+    std::vector<uint8_t> bytes;
+    std::vector<gather_segment> referenced;
+    {
+        msgpack::basic_msgpack_encoder<gather_sink> encoder(gather_sink(segment_collector{&bytes, &referenced, payload}));
+        j.dump(encoder);
+    }
+    CHECK(bytes == expected);
+    CHECK(referenced.size() == 1);
+}
+
+#if !defined(_WIN32)
+TEST_CASE("gather_sink writev to file descriptor")
+{
+    json j = blob_message(200000);
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(j, expected);
+
+    std::FILE* f = std::tmpfile();
+    REQUIRE(f != nullptr);
+    int fd = fileno(f);
+    {
+        cbor::basic_cbor_encoder<gather_sink> encoder(gather_sink(fd, 64, 32));
+        j.dump(encoder);
+    }
+
+    std::vector<uint8_t> bytes(expected.size() + 1);
+    REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+    std::size_t total = 0;
+    ssize_t n;
+    while ((n = ::read(fd, bytes.data() + total, bytes.size() - total)) > 0)
+    {
+        total += static_cast<std::size_t>(n);
+    }
+    bytes.resize(total);
+    std::fclose(f);
+
+    CHECK(bytes == expected);
+    CHECK(cbor::decode_cbor<json>(bytes) == j);
+}
+#endif
@@ -0,0 +1,217 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/interned_key.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("basic_interned_key tests")
+{
+    key_table table;
+
+    SECTION("intern")
+    {
+        auto k1 = table.intern("a key too long for short string storage");
+        auto k2 = table.intern(std::string("a key too long for short string storage"));
+        auto k3 = table.intern("other");
+        CHECK(k1.shares_with(k2));
+        CHECK_FALSE(k1.shares_with(k3));
+        CHECK(k1 == k2);
+        CHECK(k1 != k3);
+        CHECK(k1 < k3);
+        CHECK(k1 == string_view("a key too long for short string storage"));
+        CHECK(table.size() == 2);
+
+        table.clear();
+        CHECK(table.size() == 0);
+        CHECK(std::string(k1.data(), k1.length()) == "a key too long for short string storage");
+    }
+
+    SECTION("keys that are not interned")
+    {
+        interned_key_sorted_policy::key_storage<char,std::char_traits<char>,std::allocator<char>> k1("name"), k2("name");
+        CHECK_FALSE(k1.shares_with(k2));
+        CHECK(k1 == k2);
+        auto k3 = k1;
+        CHECK(k3.shares_with(k1));
+
+        basic_interned_key<char> empty;
+        CHECK(empty.empty());
+        CHECK(empty.c_str()[0] == 0);
+        CHECK(empty < k1);
+    }
+
+    SECTION("rehash")
+    {
+        std::vector<basic_interned_key<char>> keys;
+        for (int i = 0; i < 1000; ++i)
+        {
+            keys.push_back(table.intern(std::to_string(i)));
+        }
+        CHECK(table.size() == 1000);
+        for (int i = 0; i < 1000; ++i)
+        {
+            CHECK(table.intern(std::to_string(i)).shares_with(keys[i]));
+        }
+    }
+
+    SECTION("purge")
+    {
+        std::vector<basic_interned_key<char>> keys;
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto key = table.intern("key" + std::to_string(i));
+            if (i % 10 == 0)
+            {
+                keys.push_back(key);
+            }
+        }
+        CHECK(table.size() == 1000);
+
+        table.purge();
+        CHECK(table.size() == 100);
+        for (int i = 0; i < 1000; i += 10)
+        {
+            CHECK(table.intern("key" + std::to_string(i)).shares_with(keys[i/10]));
+        }
+        CHECK(table.size() == 100);
+
+        keys.clear();
+        table.purge();
+        CHECK(table.size() == 0);
+        CHECK(table.intern("key0") == string_view("key0"));
+    }
+}
+
+TEST_CASE("interned_json decoder reused across documents")
+{
+    // Every document has new keys, the table stays bounded by the keys
+    // that decoded values still hold
+    json_decoder<interned_json> decoder;
+    interned_json kept;
+    std::size_t max_size = 0;
+    for (int n = 0; n < 1000; ++n)
+    {
+        decoder.reset();
+        std::string s = "{";
+        for (int i = 0; i < 20; ++i)
+        {
+            s.append(i == 0 ? "" : ",").append("\"doc").append(std::to_string(n)).append("_").append(std::to_string(i)).append("\":1");
+        }
+        s.append(",\"common\":2}");
+        json_reader reader(s, decoder);
+        reader.read();
+        interned_json j = decoder.get_result();
+        if (n == 0)
+        {
+            kept = j;
+        }
+        else
+        {
+            CHECK(j.find("common")->key().shares_with(kept.find("common")->key()));
+        }
+        max_size = (std::max)(max_size, decoder.key_table()->size());
+    }
+    CHECK(max_size < 2100);
+    CHECK(kept.size() == 21);
+    CHECK(kept.contains("doc0_19"));
+}
+
+TEST_CASE("interned_json tests")
+{
+    std::string input = R"(
+[
+    {"title" : "A Wild Sheep Chase", "author" : "Haruki Murakami", "price" : 22.72},
+    {"title" : "The Night Watch", "author" : "Sergei Lukyanenko", "price" : 23.58},
+    {"title" : "The Comedians", "author" : "Graham Greene", "price" : 21.99}
+]
+    )";
+
+    SECTION("parse shares keys")
+    {
+        interned_json j = interned_json::parse(input);
+        REQUIRE(j.size() == 3);
+        auto it1 = j[0].find("author");
+        auto it2 = j[2].find("author");
+        REQUIRE((it1 != j[0].object_range().end()));
+        REQUIRE((it2 != j[2].object_range().end()));
+        CHECK(it1->key().shares_with(it2->key()));
+        CHECK(j[1]["title"].as<std::string>() == "The Night Watch");
+
+        std::string s1;
+        j.dump(s1);
+        std::string s2;
+        json::parse(input).dump(s2);
+        CHECK(s1 == s2);
+
+        std::string s3;
+        interned_ojson::parse(input).dump(s3);
+        std::string s4;
+        ojson::parse(input).dump(s4);
+        CHECK(s3 == s4);
+    }
+
+    SECTION("modify")
+    {
+        interned_json j = interned_json::parse(input);
+        j[0].insert_or_assign("year", 1982);
+        j[0].erase("price");
+        j[1].merge(j[0]);
+        CHECK(j[0].size() == 3);
+        CHECK(j[1]["year"].as<int>() == 1982);
+        CHECK(j[1]["title"].as<std::string>() == "The Night Watch");
+
+        interned_json copy(j);
+        CHECK(copy == j);
+        CHECK(copy[0].object_range().begin()->key().shares_with(j[0].object_range().begin()->key()));
+    }
+
+    SECTION("conversions")
+    {
+        std::map<std::string,double> m = {{"a",1.5},{"b",2.5}};
+        interned_json j(m);
+        CHECK(j["b"].as<double>() == 2.5);
+        auto m2 = j.as<std::map<std::string,double>>();
+        CHECK(m == m2);
+    }
+
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(json::parse(input), data);
+        interned_json j = cbor::decode_cbor<interned_json>(data);
+        CHECK(j[0].find("price")->key().shares_with(j[1].find("price")->key()));
+        CHECK(j[2]["price"].as<double>() == 21.99);
+    }
+
+    SECTION("share a table across decoders")
+    {
+        auto shared_table = std::make_shared<key_table>();
+
+        json_decoder<interned_json> decoder1;
+        decoder1.key_table(shared_table);
+        json_reader reader1(input, decoder1);
+        reader1.read();
+        interned_json j1 = decoder1.get_result();
+
+        json_decoder<interned_json> decoder2;
+        decoder2.key_table(shared_table);
+        json_reader reader2(input, decoder2);
+        reader2.read();
+        interned_json j2 = decoder2.get_result();
+
+        CHECK(j1[0].find("title")->key().shares_with(j2[2].find("title")->key()));
+        CHECK(shared_table->size() == 3);
+    }
+}
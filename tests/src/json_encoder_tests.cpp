@@ -29,3 +29,115 @@ TEST_CASE("test_byte_string_serialization")
     CHECK(os.str() == expected);
 }
 
+
+namespace {
+
+    // One character at a time, as the encoder did before it copied unescaped runs in bulk
+    std::string reference_escape(const std::string& s, bool escape_solidus)
+    {
+        std::string result;
+        for (char c : s)
+        {
+            switch (c)
+            {
+                case '\\': result.append("\\\\"); break;
+                case '"': result.append("\\\""); break;
+                case '\b': result.append("\\b"); break;
+                case '\f': result.append("\\f"); break;
+                case '\n': result.append("\\n"); break;
+                case '\r': result.append("\\r"); break;
+                case '\t': result.append("\\t"); break;
+                default:
+                    if (escape_solidus && c == '/')
+                    {
+                        result.append("\\/");
+                    }
+                    else if (static_cast<unsigned char>(c) <= 0x1f || c == 0x7f)
+                    {
+                        const char* hex = "0123456789ABCDEF";
+                        result.append("\\u00");
+                        result.push_back(hex[(c >> 4) & 0x0f]);
+                        result.push_back(hex[c & 0x0f]);
+                    }
+                    else
+                    {
+                        result.push_back(c);
+                    }
+                    break;
+            }
+        }
+        return result;
+    }
+}
+
+TEST_CASE("json_encoder escape runs")
+{
+    const std::string specials = std::string("\"\\/\b\f\n\r\t\x01\x1f\x7f", 11);
+
+    SECTION("special character at every position of long strings")
+    {
+        for (std::size_t length : {1, 7, 15, 16, 17, 31, 32, 33, 64, 100})
+        {
+            for (std::size_t pos = 0; pos < length; ++pos)
+            {
+                for (char special : specials)
+                {
+                    std::string s(length, 'a');
+                    s[pos] = special;
+                    for (bool escape_solidus : {false, true})
+                    {
+                        std::string buffer;
+                        jsoncons::string_sink<std::string> sink(buffer);
+                        std::size_t count = jsoncons::detail::escape_string(s.data(), s.size(), false, escape_solidus, sink);
+                        sink.flush();
+                        std::string expected = reference_escape(s, escape_solidus);
+                        CHECK(buffer == expected);
+                        CHECK(count == expected.size());
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("non-ASCII text in long strings")
+    {
+        std::string s = "abcdefghijklmnopqrstuvwxyz0123456789 \xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E \xF0\x9F\x98\x80 tail";
+
+        std::string plain;
+        jsoncons::string_sink<std::string> sink1(plain);
+        jsoncons::detail::escape_string(s.data(), s.size(), false, false, sink1);
+        sink1.flush();
+        CHECK(plain == s);
+
+        std::string escaped;
+        jsoncons::string_sink<std::string> sink2(escaped);
+        jsoncons::detail::escape_string(s.data(), s.size(), true, false, sink2);
+        sink2.flush();
+        CHECK(escaped == "abcdefghijklmnopqrstuvwxyz0123456789 \\u65E5\\u672C\\u8A9E \\uD83D\\uDE00 tail");
+    }
+
+    SECTION("wide strings")
+    {
+        std::wstring s = L"0123456789abcdefghijklmnopqrstuvwxyz\t\"quoted\"/end";
+        std::wstring buffer;
+        jsoncons::string_sink<std::wstring> sink(buffer);
+        jsoncons::detail::escape_string(s.data(), s.size(), false, true, sink);
+        sink.flush();
+        CHECK(buffer == L"0123456789abcdefghijklmnopqrstuvwxyz\\t\\\"quoted\\\"\\/end");
+    }
+
+    SECTION("encoders")
+    {
+        std::string s = "The quick brown fox jumps over the lazy dog.\nThe quick brown fox said \"hi\" to the lazy dog.";
+        json j(s);
+
+        std::string compact;
+        j.dump(compact);
+        CHECK(compact == "\"" + reference_escape(s, false) + "\"");
+
+        std::string pretty;
+        j.dump_pretty(pretty);
+        CHECK(pretty == "\"" + reference_escape(s, false) + "\"");
+        CHECK(json::parse(compact).as<std::string>() == s);
+    }
+}
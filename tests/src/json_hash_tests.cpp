@@ -0,0 +1,79 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("basic_json hash_code tests")
+{
+    SECTION("numbers that compare equal")
+    {
+        json a(10);
+        json b(10u);
+        json c(10.0);
+        json d(half_arg, 0x4900); // 10.0
+        CHECK(a == c);
+        CHECK(a.hash_code() == b.hash_code());
+        CHECK(a.hash_code() == c.hash_code());
+        CHECK(a.hash_code() == d.hash_code());
+        CHECK(json(0.0).hash_code() == json(-0.0).hash_code());
+        CHECK(json(10).hash_code() != json(11).hash_code());
+        CHECK(json(1).hash_code() != json("1").hash_code());
+    }
+
+    SECTION("tags are ignored")
+    {
+        json a("18446744073709551616", semantic_tag::bigint);
+        json b("18446744073709551616");
+        CHECK(a == b);
+        CHECK(a.hash_code() == b.hash_code());
+    }
+
+    SECTION("json and ojson")
+    {
+        std::string s1 = R"({"b":[1,2,{"c":null}],"a":true,"d":"string"})";
+        std::string s2 = R"({"a":true,"d":"string","b":[1,2,{"c":null}]})";
+        CHECK(json::parse(s1).hash_code() == ojson::parse(s1).hash_code());
+        CHECK(ojson::parse(s1).hash_code() == ojson::parse(s2).hash_code());
+        CHECK(json::parse("[1,2]").hash_code() != json::parse("[2,1]").hash_code());
+        CHECK(json().hash_code() == json::parse("{}").hash_code());
+    }
+
+    SECTION("const pointer")
+    {
+        json j = json::parse(R"({"a":[1,2,3]})");
+        json p(json_const_pointer_arg, &j);
+        CHECK(p.hash_code() == j.hash_code());
+    }
+}
+
+TEST_CASE("std::hash<basic_json> tests")
+{
+    std::vector<std::string> docs = {
+        R"({"id":1,"tags":["x","y"]})",
+        R"({"tags":["x","y"],"id":1.0})",
+        R"({"id":2,"tags":["x","y"]})",
+        R"([1,2,3])",
+        R"([1,2,3])"
+    };
+
+    std::unordered_set<json> set;
+    for (const auto& s : docs)
+    {
+        set.insert(json::parse(s));
+    }
+    CHECK(set.size() == 3);
+
+    std::unordered_map<ojson,int> map;
+    map[ojson::parse(R"({"a":1})")] = 1;
+    map[ojson::parse(R"({"a":1.0})")] = 2;
+    CHECK(map.size() == 1);
+    CHECK(map[ojson::parse(R"({"a":1})")] == 2);
+}
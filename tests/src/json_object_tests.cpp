@@ -134,6 +134,51 @@ TEST_CASE("parse_duplicate_names")
     CHECK(2 == j2["second"].as<int>());
 }
 
+TEST_CASE("parse sorted and unsorted members")
+{
+    SECTION("small objects")
+    {
+        json j1 = json::parse(R"({"a":1,"b":2,"c":3})");
+        json j2 = json::parse(R"({"c":3,"a":1,"b":2})");
+        CHECK(j1 == j2);
+        CHECK(j2.object_range().begin()->key() == "a");
+
+        json j3 = json::parse(R"({"b":1,"a":2,"b":3,"a":4})");
+        CHECK(j3.size() == 2);
+        CHECK(j3["a"].as<int>() == 2);
+        CHECK(j3["b"].as<int>() == 1);
+    }
+
+    SECTION("large objects")
+    {
+        std::string s1 = "{";
+        std::string s2 = "{";
+        for (int i = 0; i < 40; ++i)
+        {
+            if (i > 0)
+            {
+                s1.push_back(',');
+                s2.push_back(',');
+            }
+            s1 += "\"" + std::to_string(100+i) + "\":" + std::to_string(i);
+            s2 += "\"" + std::to_string(139-i) + "\":" + std::to_string(39-i);
+        }
+        s2 += ",\"100\":-1}";
+        s1 += "}";
+        json j1 = json::parse(s1);
+        json j2 = json::parse(s2);
+        CHECK(j1.size() == 40);
+        CHECK(j1 == j2);
+
+        std::string prev;
+        for (const auto& member : j2.object_range())
+        {
+            CHECK(prev < member.key());
+            prev = member.key();
+        }
+    }
+}
+
 TEST_CASE("test_erase_member")
 {
     json o;
@@ -1072,6 +1117,14 @@ TEST_CASE("ojson parse_duplicate_names")
     CHECK(2 == oj2.size());
     CHECK(1 == oj2["first"].as<int>());
     CHECK(2 == oj2["second"].as<int>());
+
+    // keys already in order
+    ojson oj3 = ojson::parse(R"({"a":1,"b":2,"c":3})");
+    CHECK(oj3.find("b")->value().as<int>() == 2);
+    CHECK((oj3.find("d") == oj3.object_range().end()));
+    oj3.insert_or_assign("aa", 4);
+    CHECK(oj3.find("aa")->value().as<int>() == 4);
+    CHECK(oj3.find("c")->value().as<int>() == 3);
 }
 TEST_CASE("test_ojson_merge")
 {
@@ -277,3 +277,35 @@ TEST_CASE("test_incremental_parsing")
 
 
 
+TEST_CASE("test_parse_long_runs_across_buffers")
+{
+    std::string name(100, 'k');
+    std::string value(1000, 'v');
+    value[500] = '\\';
+    value[501] = 'n';
+    std::string input = "{\"" + name + "\":" + std::string(37, ' ') + "[12345678901234567890123, 0.12345678901234567, \"" + value + "\"]}";
+
+    for (std::size_t chunk : {1, 7, 16, 33, 4096})
+    {
+        jsoncons::json_decoder<json> decoder;
+        json_parser parser;
+        for (std::size_t i = 0; i < input.size(); i += chunk)
+        {
+            std::size_t n = (std::min)(chunk, input.size() - i);
+            parser.update(input.data() + i, n);
+            parser.parse_some(decoder);
+        }
+        parser.finish_parse(decoder);
+        REQUIRE(parser.done());
+
+        json j = decoder.get_result();
+        const json& a = j.at(name);
+        REQUIRE(a.size() == 3);
+        CHECK(a[0].as<std::string>() == "12345678901234567890123");
+        CHECK(a[1].as<double>() == Approx(0.12345678901234567));
+        std::string expected = value;
+        expected.replace(500, 2, "\n");
+        CHECK(a[2].as<std::string>() == expected);
+    }
+}
+
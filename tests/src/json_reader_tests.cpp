@@ -267,3 +267,46 @@ TEST_CASE("json_reader read from string test")
 
 
 
+
+TEST_CASE("json_reader adaptive buffer length")
+{
+    std::string input = "[";
+    for (std::size_t i = 0; i < 200000; ++i)
+    {
+        if (i > 0)
+        {
+            input.push_back(',');
+        }
+        input.append(std::to_string(i));
+    }
+    input.push_back(']');
+
+    SECTION("grows while the buffer is filled")
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder);
+        CHECK(reader.buffer_length() == 16384);
+
+        reader.read();
+        CHECK(reader.characters_read() == input.size());
+        CHECK(reader.buffer_length() == 1048576);
+
+        json j = decoder.get_result();
+        REQUIRE(j.size() == 200000);
+        CHECK(j[199999].as<int>() == 199999);
+    }
+
+    SECTION("length set by user is kept")
+    {
+        std::istringstream is(input);
+        json_decoder<json> decoder;
+        json_reader reader(is, decoder);
+        reader.buffer_length(4096);
+
+        reader.read();
+        CHECK(reader.characters_read() == input.size());
+        CHECK(reader.buffer_length() == 4096);
+        CHECK(decoder.get_result().size() == 200000);
+    }
+}
@@ -0,0 +1,185 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/lazy_json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("lazy_json navigation")
+{
+    std::string input = R"(
+{
+    "name" : "Tom \"Cat\"",
+    "route" : "aéb",
+    "ids" : [1, -2, 3.5, 1e3],
+    "flags" : {"active" : true, "deleted" : false, "parent" : null},
+    "escaped" : 10,
+    "big" : 18446744073709551616,
+    "empty" : {}
+}
+    )";
+
+    auto doc = lazy_json_document::parse(input);
+    lazy_json root = doc.root();
+
+    SECTION("types")
+    {
+        CHECK(root.is_object());
+        CHECK(root.size() == 7);
+        CHECK(root["ids"].is_array());
+        CHECK(root["ids"].size() == 4);
+        CHECK(root["name"].is_string());
+        CHECK(root["flags"]["active"].is_bool());
+        CHECK(root["flags"]["parent"].is_null());
+        CHECK(root["ids"][0].type() == json_type::uint64_value);
+        CHECK(root["ids"][1].type() == json_type::int64_value);
+        CHECK(root["ids"][2].type() == json_type::double_value);
+        CHECK(root["empty"].empty());
+    }
+
+    SECTION("contains and find")
+    {
+        CHECK(root.contains("route"));
+        CHECK_FALSE(root.contains("missing"));
+        CHECK(root.contains("escaped"));
+        auto it = root.find("flags");
+        REQUIRE((it != root.object_range().end()));
+        CHECK(it->key() == "flags");
+        CHECK(((root.find("missing")) == root.object_range().end()));
+        CHECK_THROWS(root.at("missing"));
+        CHECK_THROWS(root["ids"].at(4));
+    }
+
+    SECTION("as")
+    {
+        CHECK(root["name"].as<std::string>() == "Tom \"Cat\"");
+        CHECK(root["route"].as<std::string>() == "a\xC3\xA9" "b");
+        CHECK(root["ids"][1].as<int>() == -2);
+        CHECK(root["ids"][2].as<double>() == 3.5);
+        CHECK(root["ids"][3].as<double>() == 1000.0);
+        CHECK(root["flags"]["active"].as<bool>());
+        CHECK_FALSE(root["flags"]["deleted"].as<bool>());
+        CHECK(root["escaped"].as<int>() == 10);
+        CHECK(root["big"].as<std::string>() == "18446744073709551616");
+        CHECK(root["ids"].as<std::vector<double>>() == std::vector<double>{1, -2, 3.5, 1000});
+
+        json j = root["flags"].as<json>();
+        CHECK(j == json::parse(R"({"active" : true, "deleted" : false, "parent" : null})"));
+        CHECK(root.as<json>() == json::parse(input));
+    }
+
+    SECTION("raw")
+    {
+        CHECK(root["name"].raw() == R"("Tom \"Cat\"")");
+        CHECK(root["ids"][3].raw() == "1e3");
+        CHECK(root["empty"].raw() == "{}");
+    }
+
+    SECTION("iteration")
+    {
+        std::vector<std::string> keys;
+        for (const auto& member : root.object_range())
+        {
+            keys.push_back(member.key());
+        }
+        CHECK(keys == std::vector<std::string>{"name","route","ids","flags","escaped","big","empty"});
+
+        std::vector<std::string> values;
+        for (auto item : root["ids"].array_range())
+        {
+            values.push_back(std::string(item.raw()));
+        }
+        CHECK(values == std::vector<std::string>{"1","-2","3.5","1e3"});
+    }
+}
+
+TEST_CASE("lazy_json parse errors")
+{
+    std::vector<std::string> invalid = {
+        R"({"a":1,})",
+        R"([1,2,])",
+        R"({"a" 1})",
+        R"([01])",
+        R"([1.])",
+        R"(["abc)",
+        "[\"a\tb\"]",
+        R"([1] 2)",
+        R"({1:2})",
+        R"([tru])",
+        R"({"a":[1,2})",
+        ""
+    };
+
+    for (const auto& s : invalid)
+    {
+        CHECK_THROWS_AS(lazy_json_document::parse(s), ser_error);
+    }
+
+    SECTION("position")
+    {
+        try
+        {
+            lazy_json_document::parse(R"({"a":1,})");
+            CHECK(false);
+        }
+        catch (const ser_error& e)
+        {
+            CHECK(e.code() == json_errc::extra_comma);
+            CHECK(e.line() == 1);
+            CHECK(e.column() == 8);
+        }
+    }
+
+    SECTION("invalid UTF-8 is reported when the string is decoded")
+    {
+        auto doc = lazy_json_document::parse("[\"\xFF\"]");
+        CHECK_THROWS(doc.root()[0].as<std::string>());
+    }
+}
+
+TEST_CASE("lazy_json document ownership")
+{
+    std::string s = R"({"items":[{"id":1},{"id":2}]})";
+    auto doc = lazy_json_document::parse(std::move(s));
+
+    std::vector<int> ids;
+    for (auto item : doc.root()["items"].array_range())
+    {
+        ids.push_back(item["id"].as<int>());
+    }
+    CHECK(ids == std::vector<int>{1, 2});
+
+    auto moved = std::move(doc);
+    CHECK(moved.root()["items"][1]["id"].as<int>() == 2);
+}
+
+TEST_CASE("lazy_json string views")
+{
+    auto doc = lazy_json_document::parse(R"({"title":"a view into the document text","escaped":"Tom \"Cat\"","n":1})");
+    lazy_json root = doc.root();
+
+    jsoncons::string_view sv = root["title"].as<jsoncons::string_view>();
+    CHECK(sv == "a view into the document text");
+    CHECK(std::string(sv) == root["title"].as<std::string>());
+
+    CHECK_THROWS(root["escaped"].as<jsoncons::string_view>());
+    CHECK(root["escaped"].as<std::string>() == "Tom \"Cat\"");
+    CHECK_THROWS(root["n"].as<jsoncons::string_view>());
+}
+
+TEST_CASE("wlazy_json")
+{
+    auto doc = wlazy_json_document::parse(LR"({"k":"v","n":[true,2]})");
+    wlazy_json root = doc.root();
+    CHECK(root.at(L"k").as<std::wstring>() == L"v");
+    CHECK(root[L"n"][0].as<bool>());
+    CHECK(root[L"n"][1].as<int>() == 2);
+    CHECK(root.as<wjson>() == wjson::parse(LR"({"k":"v","n":[true,2]})"));
+}
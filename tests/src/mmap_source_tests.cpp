@@ -0,0 +1,159 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/csv/csv.hpp>
+#include <catch/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    void write_file(const std::string& path, const std::string& content)
+    {
+        std::ofstream os(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        os.write(content.data(), content.size());
+    }
+
+    // Removes a generated file when the test ends
+    struct scoped_file
+    {
+        std::string path;
+
+        explicit scoped_file(const std::string& p)
+            : path(p)
+        {
+        }
+        ~scoped_file()
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+} // namespace
+
+TEST_CASE("mmap_source tests")
+{
+    scoped_file file("./output/mmap_source_test.json");
+    const std::string& path = file.path;
+    std::string content = "\xEF\xBB\xBF{\"title\":\"A Wild Sheep Chase\",\"ids\":[1,2,3],\"price\":22.72}";
+    write_file(path, content);
+
+    SECTION("json_reader")
+    {
+        mmap_source<char> source(path);
+        REQUIRE_FALSE(source.is_error());
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(std::move(source), decoder);
+        reader.read();
+
+        json j = decoder.get_result();
+        CHECK(j["title"].as<std::string>() == "A Wild Sheep Chase");
+        CHECK(j["ids"].size() == 3);
+        CHECK(j["price"].as<double>() == 22.72);
+    }
+
+    SECTION("json_cursor")
+    {
+        mmap_source<char> source(path);
+        basic_json_cursor<char,mmap_source<char>> cursor(std::move(source));
+
+        std::vector<staj_event_type> events;
+        for (; !cursor.done(); cursor.next())
+        {
+            events.push_back(cursor.current().event_type());
+        }
+        REQUIRE(events.size() == 12);
+        CHECK(events.front() == staj_event_type::begin_object);
+        CHECK(events.back() == staj_event_type::end_object);
+    }
+
+    SECTION("window")
+    {
+        std::size_t offset = content.find('[');
+        std::size_t length = content.find(']') - offset + 1;
+        mmap_source<char> source(path, offset, length);
+        REQUIRE_FALSE(source.is_error());
+        REQUIRE(source.size() == length);
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(std::move(source), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == json::parse("[1,2,3]"));
+    }
+
+    SECTION("offset past end of file")
+    {
+        mmap_source<char> source(path, content.size() + 1, 10);
+        CHECK(source.is_error());
+    }
+
+    SECTION("missing file")
+    {
+        mmap_source<char> source("./output/no-such-file.json");
+        CHECK(source.is_error());
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(std::move(source), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+
+    SECTION("empty file")
+    {
+        scoped_file empty_file("./output/mmap_source_empty.json");
+        const std::string& empty_path = empty_file.path;
+        write_file(empty_path, "");
+        mmap_source<char> source(empty_path);
+        CHECK_FALSE(source.is_error());
+        CHECK(source.eof());
+    }
+}
+
+TEST_CASE("mmap_source csv and cbor tests")
+{
+    SECTION("csv_reader")
+    {
+        scoped_file file("./output/mmap_source_test.csv");
+        const std::string& path = file.path;
+        write_file(path, "bond,yield\nUS10Y,1.25\nUS30Y,2.5\n");
+
+        json_decoder<json> decoder;
+        auto options = csv::csv_options{}.assume_header(true);
+        csv::basic_csv_reader<char,mmap_source<char>> reader(mmap_source<char>(path), decoder, options);
+        reader.read();
+
+        json j = decoder.get_result();
+        REQUIRE(j.size() == 2);
+        CHECK(j[1]["bond"].as<std::string>() == "US30Y");
+        CHECK(j[1]["yield"].as<double>() == 2.5);
+    }
+
+    SECTION("cbor_reader")
+    {
+        json expected = json::parse(R"({"name":"Chuck","scores":[1,2.5,"three"],"big":18446744073709551615})");
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+
+        scoped_file file("./output/mmap_source_test.cbor");
+        const std::string& path = file.path;
+        write_file(path, std::string(data.begin(), data.end()));
+
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<binary_mmap_source> reader(binary_mmap_source(path), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+}
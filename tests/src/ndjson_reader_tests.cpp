@@ -0,0 +1,190 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/ndjson_reader.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using string_ndjson_reader = basic_ndjson_reader<char,string_source<char>>;
+
+    std::string make_lines(std::size_t count)
+    {
+        std::ostringstream os;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            os << "{\"id\":" << i << ",\"msg\":\"line " << i << "\",\"tags\":[\"a\",\"b\"]}\n";
+        }
+        return os.str();
+    }
+
+} // namespace
+
+TEST_CASE("ndjson_reader tests")
+{
+    std::string input = make_lines(1000);
+
+    SECTION("ordered, several threads")
+    {
+        auto options = ndjson_options{}.max_threads(4).batch_length(512);
+        std::istringstream is(input);
+        ndjson_reader reader(is, options);
+
+        std::vector<std::pair<json,std::size_t>> records;
+        reader.read<json>([&](json&& j, std::size_t line){records.emplace_back(std::move(j), line);});
+
+        REQUIRE(records.size() == 1000);
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            CHECK(records[i].first["id"].as<std::size_t>() == i);
+            CHECK(records[i].second == i + 1);
+        }
+    }
+
+    SECTION("unordered")
+    {
+        auto options = ndjson_options{}.max_threads(3).batch_length(300).ordered(false);
+        string_ndjson_reader reader(string_view(input), options);
+
+        std::map<std::size_t,std::size_t> lines;
+        reader.read<ojson>([&](ojson&& j, std::size_t line){lines[j["id"].as<std::size_t>()] = line;});
+
+        REQUIRE(lines.size() == 1000);
+        for (const auto& item : lines)
+        {
+            CHECK(item.second == item.first + 1);
+        }
+    }
+
+    SECTION("single thread")
+    {
+        auto options = ndjson_options{}.max_threads(1).batch_length(64);
+        string_ndjson_reader reader(string_view(input), options);
+
+        std::size_t count = 0;
+        reader.read<json>([&](json&& j, std::size_t){CHECK(j["id"].as<std::size_t>() == count++);});
+        CHECK(count == 1000);
+    }
+
+    SECTION("blank lines, CRLF and no final newline")
+    {
+        std::string s = "\xEF\xBB\xBF[1]\r\n\r\n  \n{\"a\":\"b\"}\r\n\"c\"";
+        for (std::size_t threads : {std::size_t(1), std::size_t(2)})
+        {
+            string_ndjson_reader reader(string_view(s), ndjson_options{}.max_threads(threads).batch_length(4));
+            std::vector<std::pair<json,std::size_t>> records;
+            reader.read<json>([&](json&& j, std::size_t line){records.emplace_back(std::move(j), line);});
+
+            REQUIRE(records.size() == 3);
+            CHECK(records[0].first == json::parse("[1]"));
+            CHECK(records[0].second == 1);
+            CHECK(records[1].first == json::parse("{\"a\":\"b\"}"));
+            CHECK(records[1].second == 4);
+            CHECK(records[2].first.as<std::string>() == "c");
+            CHECK(records[2].second == 5);
+        }
+    }
+
+    SECTION("decode_traits")
+    {
+        std::string s = "[1,2,3]\n[4]\n[]\n";
+        string_ndjson_reader reader(string_view(s), ndjson_options{}.max_threads(2));
+        std::vector<std::vector<int>> records;
+        reader.read<std::vector<int>>([&](std::vector<int>&& v, std::size_t){records.push_back(std::move(v));});
+
+        REQUIRE(records.size() == 3);
+        CHECK(records[0] == std::vector<int>{1,2,3});
+        CHECK(records[1] == std::vector<int>{4});
+        CHECK(records[2].empty());
+    }
+}
+
+TEST_CASE("ndjson_reader error tests")
+{
+    std::string input = make_lines(1000);
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < 700; ++i)
+    {
+        pos = input.find('\n', pos) + 1;
+    }
+    input.replace(input.find("tags", pos), 4, "ta\tgs"); // line 701
+
+    std::size_t expected_column = 0;
+    JSONCONS_TRY
+    {
+        json::parse(input.substr(pos, input.find('\n', pos) - pos));
+    }
+    JSONCONS_CATCH (const ser_error& e)
+    {
+        expected_column = e.column();
+    }
+    REQUIRE(expected_column != 0);
+
+    SECTION("error_code")
+    {
+        for (std::size_t threads : {std::size_t(1), std::size_t(4)})
+        {
+            string_ndjson_reader reader(string_view(input), ndjson_options{}.max_threads(threads).batch_length(256));
+            std::size_t count = 0;
+            std::error_code ec;
+            reader.read<json>([&](json&&, std::size_t){++count;}, ec);
+            CHECK(ec == json_errc::illegal_character_in_string);
+            CHECK(count == 700);
+            CHECK(reader.line() == 701);
+            CHECK(reader.column() == expected_column);
+        }
+    }
+
+    SECTION("exception")
+    {
+        string_ndjson_reader reader(string_view(input), ndjson_options{}.max_threads(2).batch_length(256));
+        std::size_t line = 0;
+        JSONCONS_TRY
+        {
+            reader.read<json>([](json&&, std::size_t){});
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            line = e.line();
+        }
+        CHECK(line == 701);
+    }
+
+    SECTION("extra characters")
+    {
+        std::string s = "1\n2 3\n";
+        for (std::size_t threads : {std::size_t(1), std::size_t(2)})
+        {
+            string_ndjson_reader reader(string_view(s), ndjson_options{}.max_threads(threads));
+            std::error_code ec;
+            reader.read<json>([](json&&, std::size_t){}, ec);
+            CHECK(ec == json_errc::extra_character);
+            CHECK(reader.line() == 2);
+
+            string_ndjson_reader reader2(string_view(s), ndjson_options{}.max_threads(threads));
+            std::error_code ec2;
+            reader2.read<int>([](int, std::size_t){}, ec2);
+            CHECK(ec2 == json_errc::extra_character);
+            CHECK(reader2.line() == 2);
+        }
+    }
+
+    SECTION("consumer exception")
+    {
+        std::string s = make_lines(100);
+        string_ndjson_reader reader(string_view(s), ndjson_options{}.max_threads(3).batch_length(64));
+        REQUIRE_THROWS_AS(reader.read<json>([](json&& j, std::size_t){if (j["id"].as<int>() == 50) JSONCONS_THROW(std::runtime_error("stop"));}),
+                          std::runtime_error);
+    }
+}
@@ -410,3 +410,144 @@ TEST_CASE("order preserving erase")
     }
 }
   
+
+TEST_CASE("order preserving large object")
+{
+    // Objects with many members are indexed by hash, check them against a model
+    std::vector<std::pair<std::string,int>> model;
+    ojson j;
+
+    auto check = [&]()
+    {
+        REQUIRE(j.size() == model.size());
+        std::size_t i = 0;
+        for (const auto& member : j.object_range())
+        {
+            CHECK(member.key() == model[i].first);
+            CHECK(member.value().as<int>() == model[i].second);
+            ++i;
+        }
+        for (const auto& item : model)
+        {
+            auto it = j.find(item.first);
+            REQUIRE((it != j.object_range().end()));
+            CHECK(it->value().as<int>() == item.second);
+        }
+        CHECK_FALSE(j.contains("missing"));
+    };
+
+    SECTION("insert_or_assign, try_emplace and erase")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            std::string key = "key" + std::to_string(i*7919 % 1000);
+            j.insert_or_assign(key, i);
+            model.emplace_back(key, i);
+        }
+        check();
+
+        // assign, not insert
+        j.insert_or_assign("key500", -1);
+        std::find_if(model.begin(), model.end(), [](const std::pair<std::string,int>& p){return p.first == "key500";})->second = -1;
+        CHECK_FALSE(j.try_emplace("key501", 0).second);
+        check();
+
+        // insert with hints
+        j.try_emplace(j.object_range().begin() + 10, "hinted1", 1);
+        model.emplace(model.begin() + 10, "hinted1", 1);
+        j.insert_or_assign(j.object_range().begin(), "hinted2", 2);
+        model.emplace(model.begin(), "hinted2", 2);
+        check();
+
+        // erase by name and by range
+        for (int i = 0; i < 1000; i += 3)
+        {
+            std::string key = "key" + std::to_string(i);
+            j.erase(key);
+            model.erase(std::find_if(model.begin(), model.end(), [&](const std::pair<std::string,int>& p){return p.first == key;}));
+        }
+        j.erase(j.object_range().begin() + 5, j.object_range().begin() + 105);
+        model.erase(model.begin() + 5, model.begin() + 105);
+        check();
+
+        // shrink back to the sorted index
+        j.erase(j.object_range().begin() + 4, j.object_range().end());
+        model.erase(model.begin() + 4, model.end());
+        check();
+    }
+
+    SECTION("positional inserts and erases")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            std::string key = "key" + std::to_string(i);
+            j.insert_or_assign(key, i);
+            model.emplace_back(key, i);
+        }
+        // Interleave inserts in the middle, which also grow the table, with range erases
+        for (int i = 0; i < 500; ++i)
+        {
+            std::size_t pos = (i * 37) % (model.size() + 1);
+            std::string key = "mid" + std::to_string(i);
+            j.try_emplace(j.object_range().begin() + pos, key, i);
+            model.emplace(model.begin() + pos, key, i);
+            if (i % 7 == 6)
+            {
+                std::size_t first = (i * 13) % (model.size() - 3);
+                j.erase(j.object_range().begin() + first, j.object_range().begin() + first + 3);
+                model.erase(model.begin() + first, model.begin() + first + 3);
+            }
+        }
+        check();
+    }
+
+    SECTION("parse, copy and swap")
+    {
+        std::string s = "{";
+        for (int i = 0; i < 100; ++i)
+        {
+            std::string key = "k" + std::to_string(99 - i);
+            model.emplace_back(key, i);
+            s.append(i == 0 ? "" : ",").append("\"").append(key).append("\":").append(std::to_string(i));
+        }
+        s.append(",\"k5\":1000}");
+        j = ojson::parse(s);
+        check();
+
+        ojson copy(j);
+        ojson other = ojson::parse(R"({"a":1})");
+        j.swap(other);
+        CHECK(j.contains("a"));
+        j = std::move(other);
+        check();
+        CHECK(copy == j);
+    }
+}
+
+TEST_CASE("order preserving insert after shrinking")
+{
+    // An object that grew past the hashed index threshold and shrank below it
+    // keeps its hashed index until a bulk insert rebuilds the sorted one
+    json_object<std::string, ojson> o;
+    for (int i = 0; i < 40; ++i)
+    {
+        o.insert_or_assign("key" + std::to_string(i), ojson(i));
+    }
+    o.erase(o.begin() + 20, o.end());
+    REQUIRE(o.size() == 20);
+
+    using item_type = std::pair<ojson::key_type,ojson>;
+    std::vector<item_type> items;
+    items.emplace_back("new1", 1);
+    items.emplace_back("new2", 2);
+    o.insert(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()), 
+             [](item_type&& item){return ojson::key_value_type(std::forward<ojson::key_type>(item.first),std::forward<ojson>(item.second));});
+
+    REQUIRE(o.size() == 22);
+    CHECK((o.find("new1") != o.end()));
+    CHECK((o.find("new2") != o.end()));
+    CHECK((o.find("key0") != o.end()));
+    CHECK((o.find("key19") != o.end()));
+    CHECK((o.find("key20") == o.end()));
+    CHECK(o.find("new2")->value().as<int>() == 2);
+}
@@ -0,0 +1,160 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/parallel_parse.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_records(std::size_t count)
+    {
+        std::ostringstream os;
+        os << "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                os << ",\n ";
+            }
+            os << "{\"id\":" << i << ",\"name\":\"item \\\"" << i << "\\\" [x], {y}\",\"values\":[" << i << ",1.5,null,true],\"nested\":{\"a\":[[]]}}";
+        }
+        os << "]";
+        return os.str();
+    }
+
+} // namespace
+
+TEST_CASE("parse_parallel tests")
+{
+    auto popts = parallel_parse_options{}.max_threads(4).min_chunk_length(256);
+
+    SECTION("root array")
+    {
+        std::string s = make_records(500);
+        json expected = json::parse(s);
+        json j = parse_parallel<json>(s, popts);
+        CHECK(j.size() == 500);
+        CHECK(j == expected);
+    }
+
+    SECTION("ojson root array with surrounding whitespace")
+    {
+        std::string s = "\xEF\xBB\xBF \n" + make_records(300) + " \r\n";
+        ojson expected = ojson::parse(s);
+        ojson j = parse_parallel<ojson>(s, popts);
+        CHECK(j == expected);
+    }
+
+    SECTION("array at location")
+    {
+        std::string s = "{\"meta\":{\"count\":400},\"a/b\":{\"da\\u0074a\":" + make_records(400) + "},\"tail\":[1,2]}";
+        json expected = json::parse(s);
+        json j = parse_parallel<json>(s, parallel_parse_options(popts).array_location("/a~1b/data"));
+        CHECK(j["a/b"]["data"].size() == 400);
+        CHECK(j == expected);
+    }
+
+    SECTION("array at index")
+    {
+        std::string s = "[0," + make_records(400) + "]";
+        json expected = json::parse(s);
+        json j = parse_parallel<json>(s, parallel_parse_options(popts).array_location("/1"));
+        CHECK(j == expected);
+    }
+
+    SECTION("location not found falls back")
+    {
+        std::string s = "{\"a\":" + make_records(400) + "}";
+        json expected = json::parse(s);
+        CHECK(parse_parallel<json>(s, parallel_parse_options(popts).array_location("/b")) == expected);
+    }
+
+    SECTION("empty and small arrays")
+    {
+        CHECK(parse_parallel<json>("[]", popts) == json(json_array_arg));
+        std::string s(600, ' ');
+        s.replace(0, 2, "[]");
+        CHECK(parse_parallel<json>(s, popts) == json(json_array_arg));
+        CHECK(parse_parallel<json>("[1,2,3]", popts) == json::parse("[1,2,3]"));
+    }
+
+    SECTION("not an array")
+    {
+        std::string s = "{\"a\":" + make_records(300) + "}";
+        CHECK(parse_parallel<json>(s, popts) == json::parse(s));
+    }
+
+    SECTION("invalid element reports the serial error")
+    {
+        std::string s = make_records(400);
+        s.replace(s.rfind("null"), 4, "nul!");
+        std::size_t line = 0;
+        std::size_t column = 0;
+        JSONCONS_TRY
+        {
+            json::parse(s);
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            line = e.line();
+            column = e.column();
+        }
+        REQUIRE(line != 0);
+        CHECK(line == 400);
+        JSONCONS_TRY
+        {
+            parse_parallel<json>(s, popts);
+            CHECK(false);
+        }
+        JSONCONS_CATCH (const ser_error& e)
+        {
+            CHECK(e.line() == line);
+            CHECK(e.column() == column);
+        }
+    }
+
+    SECTION("comments")
+    {
+        std::string s = "// records\n[ /* first */ " + make_records(400).substr(1);
+        s.replace(s.rfind(",\n "), 3, " /* a ] in a comment */, // and a [ here\n ");
+        s.replace(s.find("\"id\":1,"), 7, "\"id\":1 /*}*/,");
+        json expected = json::parse(s);
+
+        json array;
+        const char* array_last = nullptr;
+        const char* first = s.data() + s.find('[');
+        CHECK(jsoncons::detail::parse_array_parallel<json>(first, s.data() + s.size(), array_last, popts, json_options(), array));
+        CHECK(array == expected);
+        CHECK(parse_parallel<json>(s, popts) == expected);
+
+        std::string unterminated = make_records(400);
+        unterminated.replace(unterminated.rfind(",\n "), 3, " /* , ");
+        REQUIRE_THROWS_AS(parse_parallel<json>(unterminated, popts), ser_error);
+
+        // As with Json::parse, nothing but whitespace may follow the root value
+        std::string trailing = make_records(400) + " /* end */";
+        REQUIRE_THROWS_AS(json::parse(trailing), ser_error);
+        REQUIRE_THROWS_AS(parse_parallel<json>(trailing, popts), ser_error);
+    }
+
+    SECTION("trailing content")
+    {
+        std::string s = make_records(300) + " x";
+        REQUIRE_THROWS_AS(parse_parallel<json>(s, popts), ser_error);
+    }
+
+    SECTION("unterminated array")
+    {
+        std::string s = make_records(300);
+        s.pop_back();
+        REQUIRE_THROWS_AS(parse_parallel<json>(s, popts), ser_error);
+    }
+}
@@ -130,3 +130,62 @@ TEST_CASE("test_parse_big_string2")
 }
 
 
+namespace {
+
+    class string_view_recorder : public default_json_visitor
+    {
+    public:
+        std::vector<string_view> views;
+    private:
+        bool visit_key(const string_view& name, const ser_context&, std::error_code&) override
+        {
+            views.push_back(name);
+            return true;
+        }
+        bool visit_string(const string_view& s, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            views.push_back(s);
+            return true;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("test_parse_string_views_into_input")
+{
+    std::string input = "{\"first\":\"plain\",\"second\":\"esc\\u0041ped\"}";
+
+    SECTION("whole input in one buffer")
+    {
+        string_view_recorder visitor;
+        json_parser parser;
+        parser.update(input.data(), input.size());
+        parser.parse_some(visitor);
+        parser.finish_parse(visitor);
+        REQUIRE(visitor.views.size() == 4);
+
+        // Unescaped strings are views into the input buffer
+        CHECK(visitor.views[0].data() == input.data() + 2);
+        CHECK(visitor.views[1].data() == input.data() + 10);
+        CHECK(visitor.views[2].data() == input.data() + 18);
+
+        // Escaped strings are assembled
+        CHECK(visitor.views[3] == string_view("escAped"));
+        CHECK_FALSE((visitor.views[3].data() >= input.data() && visitor.views[3].data() < input.data() + input.size()));
+    }
+
+    SECTION("string across buffers")
+    {
+        string_view_recorder visitor;
+        json_parser parser;
+        parser.update(input.data(), 13);
+        parser.parse_some(visitor);
+        parser.update(input.data() + 13, input.size() - 13);
+        parser.parse_some(visitor);
+        parser.finish_parse(visitor);
+        REQUIRE(visitor.views.size() == 4);
+        CHECK(visitor.views[0].data() == input.data() + 2);
+        CHECK_FALSE(visitor.views[1].data() == input.data() + 10);
+    }
+}
+
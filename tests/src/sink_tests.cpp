@@ -0,0 +1,125 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/sink.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstring>
+
+using namespace jsoncons;
+
+TEST_CASE("sink write_ptr and commit")
+{
+    SECTION("string_sink")
+    {
+        std::string buffer = "ab";
+        string_sink<std::string> sink(buffer);
+        char* p = sink.write_ptr(8);
+        std::memcpy(p, "cdef", 4);
+        sink.commit(4);
+        sink.push_back('g');
+        sink.reserve(100);
+        CHECK(buffer.capacity() >= 107);
+        CHECK(buffer == "abcdefg");
+    }
+
+    SECTION("bytes_sink")
+    {
+        std::vector<uint8_t> buffer;
+        bytes_sink<std::vector<uint8_t>> sink(buffer);
+        uint8_t* p = sink.write_ptr(9);
+        p[0] = 0x19;
+        p[1] = 0x01;
+        p[2] = 0x00;
+        sink.commit(3);
+        const uint8_t payload[] = {1,2,3};
+        sink.append(payload, 3);
+        CHECK(buffer == std::vector<uint8_t>({0x19,0x01,0x00,1,2,3}));
+    }
+
+    SECTION("bytes_sink over std::string")
+    {
+        std::string buffer;
+        bytes_sink<std::string> sink(buffer);
+        char* p = sink.write_ptr(4);
+        p[0] = 'a';
+        p[1] = 'b';
+        sink.commit(2);
+        sink.push_back('c');
+        CHECK(buffer == "abc");
+    }
+
+    SECTION("stream_sink window larger than its buffer")
+    {
+        std::ostringstream os;
+        {
+            stream_sink<char> sink(os, 4);
+            sink.push_back('a');
+            char* p = sink.write_ptr(10);
+            std::memcpy(p, "0123456789", 10);
+            sink.commit(10);
+            sink.push_back('b');
+        }
+        CHECK(os.str() == "a0123456789b");
+    }
+
+    SECTION("binary_stream_sink")
+    {
+        std::ostringstream os;
+        {
+            binary_stream_sink sink(os, 4);
+            uint8_t* p = sink.write_ptr(3);
+            p[0] = 'x'; p[1] = 'y'; p[2] = 'z';
+            sink.commit(2);
+            p = sink.write_ptr(3);
+            p[0] = 'u'; p[1] = 'v'; p[2] = 'w';
+            sink.commit(3);
+        }
+        CHECK(os.str() == "xyuvw");
+    }
+}
+
+TEST_CASE("stream_sink append")
+{
+    std::ostringstream os;
+    {
+        stream_sink<char> sink(os, 8);
+        sink.append("abcdef", 6);
+        // Doesn't fit in what is left, but is smaller than the buffer, so it is buffered
+        sink.append("ghijk", 5);
+        CHECK(os.str() == "abcdef");
+        // At least as large as the buffer, so it is written through
+        sink.append("0123456789", 10);
+        CHECK(os.str() == "abcdefghijk0123456789");
+        sink.push_back('!');
+    }
+    CHECK(os.str() == "abcdefghijk0123456789!");
+}
+
+TEST_CASE("cbor encode through sinks with and without write_ptr")
+{
+    json j;
+    j["short"] = "abc";
+    j["long"] = std::string(300, 'x');
+    j["numbers"] = json(json_array_arg, {1, -500, 70000, 5000000000LL, 1.5, 0.1});
+    j["bytes"] = json(byte_string_arg, std::vector<uint8_t>(70, 7));
+
+    std::vector<uint8_t> expected;
+    cbor::encode_cbor(j, expected);
+
+    std::deque<uint8_t> d;
+    cbor::basic_cbor_encoder<bytes_sink<std::deque<uint8_t>>> deque_encoder(d);
+    j.dump(deque_encoder);
+    CHECK(std::vector<uint8_t>(d.begin(), d.end()) == expected);
+
+    std::ostringstream os;
+    cbor::encode_cbor(j, os);
+    std::string s = os.str();
+    CHECK(std::vector<uint8_t>(s.begin(), s.end()) == expected);
+
+    CHECK(cbor::decode_cbor<json>(expected) == j);
+}
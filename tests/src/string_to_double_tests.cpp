@@ -53,3 +53,69 @@ TEST_CASE("test_exponent")
 
 }
 
+
+TEST_CASE("detail::decimal_to_double tests")
+{
+    SECTION("agrees with strtod")
+    {
+        std::vector<std::string> inputs = {
+            "0", "-0", "0.0", "1", "-1", "0.1", "1e23", "9007199254740993",
+            "7.3177701707893310e+15", "7.2057594037927933e+16", "2.2250738585072014e-308",
+            "1.7976931348623157e308", "4.9406564584124654e-324", "1e-400", "1e400",
+            "123456789012345678", "0.000001234", "1.15507e-173", "3.141592653589793",
+            "2.718281828459045e-5", "1E+2", "1e-22", "1e22", "4503599627370497.5",
+            "100000000000000000000000", "0.30000000000000004"
+        };
+        for (const auto& s : inputs)
+        {
+            double expected = strtod(s.c_str(), nullptr);
+            double val;
+            if (jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', val))
+            {
+                CHECK(val == expected);
+                CHECK(std::signbit(val) == std::signbit(expected));
+            }
+            jsoncons::detail::to_double_t to_double;
+            CHECK(to_double(s.c_str(), s.length()) == expected);
+        }
+    }
+
+    SECTION("random round trips")
+    {
+        uint64_t x = 88172645463325252ull;
+        for (int k = 0; k < 100000; ++k)
+        {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            double d;
+            uint64_t bits = x & 0x7fefffffffffffffull;
+            std::memcpy(&d, &bits, sizeof(d));
+            char buffer[40];
+            int length = snprintf(buffer, sizeof(buffer), "%.*g", 17 - static_cast<int>(x % 8), d);
+            double expected = strtod(buffer, nullptr);
+            double val;
+            if (jsoncons::detail::decimal_to_double(buffer, static_cast<std::size_t>(length), '.', val))
+            {
+                REQUIRE(val == expected);
+            }
+        }
+    }
+
+    SECTION("not a decimal number")
+    {
+        double val;
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("", 0, '.', val));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("-", 1, '.', val));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double(".", 1, '.', val));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("1e", 2, '.', val));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("12abc", 5, '.', val));
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("12345678901234567890", 20, '.', val));
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring s = L"-12.5e-1";
+        double val;
+        REQUIRE(jsoncons::detail::decimal_to_double(s.data(), s.length(), '.', val));
+        CHECK(val == -1.25);
+    }
+}
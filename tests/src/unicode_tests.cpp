@@ -57,3 +57,51 @@ BOOST_AUTO_TEST_CASE( test1 )
 }
 #endif
 
+
+TEST_CASE("unicons::validate utf8 tests")
+{
+    SECTION("ascii runs around multibyte sequences")
+    {
+        for (std::size_t i = 0; i < 40; ++i)
+        {
+            std::string s(i, 'a');
+            s.append("\xD0\x96\xE2\x82\xAC\xF0\x9F\x98\x80");
+            s.append(i, 'b');
+            auto result = unicons::validate(s.data(), s.data() + s.size());
+            CHECK(result.ec == unicons::conv_errc());
+            CHECK(result.it == s.data() + s.size());
+
+            auto result2 = unicons::validate(s.begin(), s.end());
+            CHECK(result2.ec == unicons::conv_errc());
+        }
+    }
+    SECTION("error position after ascii run")
+    {
+        for (std::size_t i = 0; i < 40; ++i)
+        {
+            std::string s(i, 'a');
+            s.append("\xC0\x80"); // overlong encoding
+            s.append(20, 'b');
+            auto result = unicons::validate(s.data(), s.data() + s.size());
+            CHECK(result.ec == unicons::conv_errc::source_illegal);
+            CHECK(result.it == s.data() + i);
+        }
+    }
+    SECTION("missing continuation byte")
+    {
+        std::string s(17, 'a');
+        s.append("\xE2\x82");
+        s.append(20, 'b');
+        auto result = unicons::validate(s.data(), s.data() + s.size());
+        CHECK(result.ec == unicons::conv_errc::expected_continuation_byte);
+        CHECK(result.it == s.data() + 17);
+    }
+    SECTION("truncated sequence")
+    {
+        std::string s(17, 'a');
+        s.append("\xF0\x9F");
+        auto result = unicons::validate(s.data(), s.data() + s.size());
+        CHECK(result.ec == unicons::conv_errc::source_exhausted);
+        CHECK(result.it == s.data() + 17);
+    }
+}